@@ -27,21 +27,16 @@ namespace shiva::editor
     {
         //! Textures
         sol::table table = state_["shiva"]["resource_registry"];
-        table["load_all_resources"](table, "editor_textures");
-
-        //! Fonts
-        ImGui::GetIO().Fonts->Clear();
-        ImGui::GetIO().Fonts->AddFontFromFileTTF(
-            (shiva::fs::current_path() /= "assets/imgui/comic-sans-ms.ttf").string().c_str(), 40.f);
-
-        // merge in icons from Font Awesome
-        static const ImWchar icons_ranges[] = {ICON_MIN_FA, ICON_MAX_FA, 0};
-        ImFontConfig icons_config;
-        icons_config.MergeMode = true;
-        icons_config.PixelSnapH = true;
-        ImGui::GetIO().Fonts->AddFontFromFileTTF(
-            (shiva::fs::current_path() /= "assets/imgui/fa-regular-400.ttf").string().c_str(), 28.f, &icons_config,
-            icons_ranges);
+        //! looked up by the widgets as soon as the editor is drawn
+        table["load_all_resources_sync"](table, "editor_textures");
+
+        //! Fonts, rasterized once then loaded from the cache until the font files change
+        const auto imgui_path = shiva::fs::current_path() / "assets/imgui";
+        const std::vector<font_source> fonts{
+            font_source{imgui_path / "comic-sans-ms.ttf", 40.f},
+            // merge in icons from Font Awesome
+            font_source{imgui_path / "fa-regular-400.ttf", 28.f, {ICON_MIN_FA, ICON_MAX_FA, 0}, true, true}};
+        font_cache_.load_or_build(*ImGui::GetIO().Fonts, fonts);
 
         table = state_["shiva"]["render"];
         table["update_font"](table);
@@ -130,31 +125,30 @@ namespace shiva::editor
                                                    win_cfg_.size[1] * 0.8f});
         ImGui::Begin("Project", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoCollapse);
         ImGui::PushStyleVar(ImGuiStyleVar_IndentSpacing, ImGui::GetFontSize());
-        std::function<void(const shiva::fs::path &)> functor = [&](
-            const shiva::fs::path &path) {
-            for (auto &&p : shiva::fs::directory_iterator(path)) {
+        //! the tree of the vfs: the mounted directories, archives and overlays.
+        auto &file_system = *shiva::filesystem::vfs::shared();
+        std::function<void(const std::string &)> functor = [&](const std::string &directory) {
+            file_system.list(directory, [&](const std::string &name, bool is_directory) {
                 ImGuiTreeNodeFlags node_flags =
                     ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick | 0;
-                if (shiva::fs::is_directory(p.path())) {
+                if (is_directory) {
                     using namespace std::string_literals;
-                    std::string s = ICON_FA_FOLDER + " "s + p.path().filename().string().c_str();
-                    if (ImGui::TreeNodeEx(p.path().filename().string().c_str(), node_flags, "%s",
-                                          s.c_str())) {
+                    std::string s = ICON_FA_FOLDER + " "s + name;
+                    if (ImGui::TreeNodeEx(name.c_str(), node_flags, "%s", s.c_str())) {
                         if (ImGui::IsItemClicked()) {
                         }
-                        functor(p);
+                        functor(directory.empty() ? name : directory + "/" + name);
                         ImGui::TreePop();
                     }
                 } else {
                     node_flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
-                    ImGui::TreeNodeEx(p.path().filename().string().c_str(), node_flags, "%s",
-                                      p.path().filename().string().c_str());
+                    ImGui::TreeNodeEx(name.c_str(), node_flags, "%s", name.c_str());
                     if (ImGui::IsItemClicked()) {
                     }
                 }
-            }
+            });
         };
-        functor(shiva::fs::current_path());
+        functor("");
         ImGui::PopStyleVar();
         ImGui::End();
     }
@@ -6,10 +6,12 @@
 
 #include <imgui.h>
 #include <shiva/filesystem/filesystem.hpp>
+#include <shiva/filesystem/vfs.hpp>
 #include <shiva/lua/lua_helpers.hpp>
 #include <shiva/ecs/system.hpp>
 #include <shiva/world/window_config.hpp>
 #include "IconsFontAwesome5.h"
+#include "font_atlas_cache.hpp"
 
 namespace shiva::editor
 {
@@ -34,6 +36,7 @@ namespace shiva::editor
         bool resources_ready{false};
         shiva::windows_config &win_cfg_;
         sol::state &state_;
+        font_atlas_cache font_cache_;
 
 
         //! Private member functions
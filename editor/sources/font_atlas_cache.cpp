@@ -0,0 +1,343 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <shiva/filesystem/pak_archive.hpp>
+#include "font_atlas_cache.hpp"
+
+namespace shiva::editor
+{
+    namespace
+    {
+        constexpr char magic[8] = {'S', 'H', 'I', 'V', 'A', 'F', 'N', 'T'};
+        constexpr std::uint32_t version = 2u;
+
+        struct header
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t nb_fonts;
+            std::uint64_t key;
+            std::int32_t tex_width;
+            std::int32_t tex_height;
+            float white_pixel_u;
+            float white_pixel_v;
+            std::uint32_t nb_custom_rects;
+            //! index of the mouse cursor rect (CustomRectIds[0]) in the custom rects, -1 if none
+            std::int32_t mouse_cursor_rect;
+        };
+
+        //! \note only the regular rects (without font) are kept, they are added back with AddCustomRectRegular
+        struct custom_rect
+        {
+            std::uint32_t id;
+            std::uint16_t width, height;
+            std::uint16_t x, y;
+        };
+
+        struct font_header
+        {
+            float size;
+            float ascent;
+            float descent;
+            std::uint32_t fallback_char;
+            std::uint32_t nb_configs;
+            std::uint32_t nb_glyphs;
+        };
+
+        //! the fields of ImFontConfig still meaningful once the atlas is built (the font data is not kept)
+        struct font_config
+        {
+            float size_pixels;
+            std::int32_t oversample_h;
+            std::int32_t oversample_v;
+            float glyph_offset_x;
+            float glyph_offset_y;
+            bool merge_mode;
+            bool pixel_snap;
+            char name[40];
+        };
+
+        //! \note the glyphs are written field by field, ImFontGlyph changes between the versions of imgui
+        struct glyph
+        {
+            std::uint32_t codepoint;
+            float advance_x;
+            float x0, y0, x1, y1;
+            float u0, v0, u1, v1;
+        };
+
+        static_assert(std::is_trivially_copyable_v<header> && std::is_trivially_copyable_v<custom_rect> &&
+                      std::is_trivially_copyable_v<font_header> && std::is_trivially_copyable_v<font_config> &&
+                      std::is_trivially_copyable_v<glyph>);
+
+        template <typename T>
+        void append(std::string &data, const T &value) noexcept
+        {
+            data.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        bool extract(std::string_view &data, T &value) noexcept
+        {
+            if (data.size() < sizeof(T)) {
+                return false;
+            }
+            std::memcpy(&value, data.data(), sizeof(T));
+            data.remove_prefix(sizeof(T));
+            return true;
+        }
+    }
+
+    font_atlas_cache::font_atlas_cache(shiva::fs::path cache_path) noexcept : cache_path_(std::move(cache_path))
+    {
+    }
+
+    bool font_atlas_cache::load_or_build(ImFontAtlas &atlas, const std::vector<font_source> &fonts) const noexcept
+    {
+        const auto key = key_of(fonts);
+        atlas.Clear();
+        if (load(atlas, key)) {
+            return true;
+        }
+        atlas.Clear();
+        for (auto &&current : fonts) {
+            ImFontConfig config;
+            config.MergeMode = current.merge;
+            config.PixelSnapH = current.pixel_snap;
+            atlas.AddFontFromFileTTF(current.path.string().c_str(), current.size, &config,
+                                     current.ranges.empty() ? nullptr : current.ranges.data());
+        }
+        save(atlas, key);
+        return false;
+    }
+
+    std::uint64_t font_atlas_cache::key_of(const std::vector<font_source> &fonts) noexcept
+    {
+        std::string data(IMGUI_VERSION);
+        append(data, version);
+        for (auto &&current : fonts) {
+            data += current.path.generic_string();
+            std::error_code ec;
+            const auto size = shiva::fs::file_size(current.path, ec);
+            append(data, ec ? std::uint64_t{0u} : static_cast<std::uint64_t>(size));
+            const auto mtime = shiva::fs::last_write_time(current.path, ec);
+            append(data, ec ? std::int64_t{0} : static_cast<std::int64_t>(mtime.time_since_epoch().count()));
+            append(data, current.size);
+            for (auto codepoint : current.ranges) {
+                append(data, codepoint);
+            }
+            append(data, current.merge);
+            append(data, current.pixel_snap);
+        }
+        return shiva::filesystem::pak::fnv1a_64(data);
+    }
+
+    bool font_atlas_cache::load(ImFontAtlas &atlas, std::uint64_t key) const noexcept
+    {
+#if !defined(SHIVA_EDITOR_FONT_ATLAS_CACHE)
+        (void)atlas;
+        (void)key;
+        return false;
+#else
+        std::ifstream ifs(cache_path_, std::ios::binary);
+        if (!ifs.is_open()) {
+            return false;
+        }
+        const std::string content(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>{});
+        std::string_view data(content);
+        header current{};
+        if (!extract(data, current) || std::memcmp(current.magic, magic, sizeof(magic)) != 0 ||
+            current.version != version || current.key != key || current.nb_fonts == 0u ||
+            current.tex_width <= 0 || current.tex_height <= 0 || current.mouse_cursor_rect < -1 ||
+            current.mouse_cursor_rect >= static_cast<std::int64_t>(current.nb_custom_rects) ||
+            data.size() / sizeof(custom_rect) < current.nb_custom_rects) {
+            return false;
+        }
+
+        //! the fonts are only added once the whole file is known to be valid
+        std::vector<custom_rect> rects(current.nb_custom_rects);
+        for (auto &&rect : rects) {
+            extract(data, rect);
+        }
+        std::vector<font_header> fonts;
+        std::vector<font_config> configs;
+        std::vector<std::string_view> glyphs;
+        for (std::uint32_t idx = 0u; idx < current.nb_fonts; ++idx) {
+            font_header font{};
+            if (!extract(data, font) || font.nb_configs == 0u || data.size() / sizeof(font_config) < font.nb_configs) {
+                return false;
+            }
+            for (std::uint32_t config_idx = 0u; config_idx < font.nb_configs; ++config_idx) {
+                extract(data, configs.emplace_back());
+            }
+            if (data.size() / sizeof(glyph) < font.nb_glyphs) {
+                return false;
+            }
+            fonts.push_back(font);
+            glyphs.push_back(data.substr(0, font.nb_glyphs * sizeof(glyph)));
+            data.remove_prefix(font.nb_glyphs * sizeof(glyph));
+        }
+        const auto nb_pixels = static_cast<size_t>(current.tex_width) * static_cast<size_t>(current.tex_height);
+        if (data.size() != nb_pixels) {
+            return false;
+        }
+
+        for (auto &&rect : rects) {
+            const int idx = atlas.AddCustomRectRegular(rect.id, rect.width, rect.height);
+            atlas.CustomRects[idx].X = rect.x;
+            atlas.CustomRects[idx].Y = rect.y;
+        }
+        atlas.CustomRectIds[0] = current.mouse_cursor_rect;
+
+        //! the fonts point in ConfigData, it is not resized once they are added
+        atlas.ConfigData.reserve(static_cast<int>(configs.size()));
+        for (auto &&saved : configs) {
+            ImFontConfig config;
+            config.FontData = nullptr;
+            config.FontDataOwnedByAtlas = false;
+            config.SizePixels = saved.size_pixels;
+            config.OversampleH = saved.oversample_h;
+            config.OversampleV = saved.oversample_v;
+            config.GlyphOffset = ImVec2(saved.glyph_offset_x, saved.glyph_offset_y);
+            config.MergeMode = saved.merge_mode;
+            config.PixelSnapH = saved.pixel_snap;
+            std::memcpy(config.Name, saved.name, sizeof(config.Name));
+            config.Name[sizeof(config.Name) - 1] = '\0';
+            atlas.ConfigData.push_back(config);
+        }
+
+        int config_idx = 0;
+        for (size_t font_idx = 0u; font_idx < fonts.size(); ++font_idx) {
+            const auto &saved_font = fonts[font_idx];
+            ImFont *font = IM_NEW(ImFont);
+            font->FontSize = saved_font.size;
+            font->Ascent = saved_font.ascent;
+            font->Descent = saved_font.descent;
+            font->ContainerAtlas = &atlas;
+            font->ConfigData = &atlas.ConfigData[config_idx];
+            font->ConfigDataCount = static_cast<short>(saved_font.nb_configs);
+            for (std::uint32_t idx = 0u; idx < saved_font.nb_configs; ++idx) {
+                atlas.ConfigData[config_idx++].DstFont = font;
+            }
+            font->Glyphs.reserve(static_cast<int>(saved_font.nb_glyphs));
+            glyph saved{};
+            while (extract(glyphs[font_idx], saved)) {
+                ImFontGlyph loaded{};
+                loaded.Codepoint = static_cast<ImWchar>(saved.codepoint);
+                loaded.AdvanceX = saved.advance_x;
+                loaded.X0 = saved.x0;
+                loaded.Y0 = saved.y0;
+                loaded.X1 = saved.x1;
+                loaded.Y1 = saved.y1;
+                loaded.U0 = saved.u0;
+                loaded.V0 = saved.v0;
+                loaded.U1 = saved.u1;
+                loaded.V1 = saved.v1;
+                font->Glyphs.push_back(loaded);
+            }
+            //! builds the lookup tables of the glyphs
+            font->SetFallbackChar(static_cast<ImWchar>(saved_font.fallback_char));
+            atlas.Fonts.push_back(font);
+        }
+
+        //! freed by imgui (ClearTexData), the RGBA pixels are converted from them when the texture is uploaded
+        atlas.TexPixelsAlpha8 = static_cast<unsigned char *>(ImGui::MemAlloc(nb_pixels));
+        std::memcpy(atlas.TexPixelsAlpha8, data.data(), nb_pixels);
+        atlas.TexWidth = current.tex_width;
+        atlas.TexHeight = current.tex_height;
+        atlas.TexUvScale = ImVec2(1.0f / current.tex_width, 1.0f / current.tex_height);
+        atlas.TexUvWhitePixel = ImVec2(current.white_pixel_u, current.white_pixel_v);
+        return true;
+#endif
+    }
+
+    bool font_atlas_cache::save(ImFontAtlas &atlas, std::uint64_t key) const noexcept
+    {
+#if !defined(SHIVA_EDITOR_FONT_ATLAS_CACHE)
+        (void)atlas;
+        (void)key;
+        return false;
+#else
+        unsigned char *pixels = nullptr;
+        int width = 0;
+        int height = 0;
+        atlas.GetTexDataAsAlpha8(&pixels, &width, &height);
+        if (pixels == nullptr || atlas.Fonts.empty()) {
+            return false;
+        }
+
+        header current{};
+        std::memcpy(current.magic, magic, sizeof(magic));
+        current.version = version;
+        current.nb_fonts = static_cast<std::uint32_t>(atlas.Fonts.Size);
+        current.key = key;
+        current.tex_width = width;
+        current.tex_height = height;
+        current.white_pixel_u = atlas.TexUvWhitePixel.x;
+        current.white_pixel_v = atlas.TexUvWhitePixel.y;
+        current.mouse_cursor_rect = -1;
+        std::vector<custom_rect> rects;
+        for (int idx = 0; idx < atlas.CustomRects.Size; ++idx) {
+            const auto &rect = atlas.CustomRects[idx];
+            if (rect.Font != nullptr) {
+                continue;
+            }
+            if (idx == atlas.CustomRectIds[0]) {
+                current.mouse_cursor_rect = static_cast<std::int32_t>(rects.size());
+            }
+            rects.push_back(custom_rect{rect.ID, rect.Width, rect.Height, rect.X, rect.Y});
+        }
+        current.nb_custom_rects = static_cast<std::uint32_t>(rects.size());
+        std::string data;
+        append(data, current);
+        for (auto &&rect : rects) {
+            append(data, rect);
+        }
+        for (const ImFont *font : atlas.Fonts) {
+            if (font->ConfigData == nullptr || font->ConfigDataCount <= 0) {
+                return false;
+            }
+            append(data, font_header{font->FontSize, font->Ascent, font->Descent,
+                                     static_cast<std::uint32_t>(font->FallbackChar),
+                                     static_cast<std::uint32_t>(font->ConfigDataCount),
+                                     static_cast<std::uint32_t>(font->Glyphs.Size)});
+            for (int idx = 0; idx < font->ConfigDataCount; ++idx) {
+                const auto &config = font->ConfigData[idx];
+                font_config saved{config.SizePixels, config.OversampleH, config.OversampleV,
+                                  config.GlyphOffset.x, config.GlyphOffset.y, config.MergeMode,
+                                  config.PixelSnapH, {}};
+                std::memcpy(saved.name, config.Name, sizeof(saved.name));
+                append(data, saved);
+            }
+            for (const auto &loaded : font->Glyphs) {
+                append(data, glyph{static_cast<std::uint32_t>(loaded.Codepoint), loaded.AdvanceX,
+                                   loaded.X0, loaded.Y0, loaded.X1, loaded.Y1,
+                                   loaded.U0, loaded.V0, loaded.U1, loaded.V1});
+            }
+        }
+        data.append(reinterpret_cast<const char *>(pixels), static_cast<size_t>(width) * static_cast<size_t>(height));
+
+        //! written aside then renamed, an interrupted save leaves the previous cache
+        std::error_code ec;
+        shiva::fs::create_directories(cache_path_.parent_path(), ec);
+        auto tmp_path = cache_path_;
+        tmp_path += ".tmp";
+        {
+            std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+            if (!ofs.is_open() || !ofs.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+                return false;
+            }
+        }
+        shiva::fs::rename(tmp_path, cache_path_, ec);
+        return !ec;
+#endif
+    }
+}
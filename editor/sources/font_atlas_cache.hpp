@@ -0,0 +1,72 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <imgui.h>
+#include <shiva/filesystem/filesystem.hpp>
+
+#if !defined(IMGUI_VERSION_NUM) || IMGUI_VERSION_NUM < 17400
+#define SHIVA_EDITOR_FONT_ATLAS_CACHE
+#endif
+
+namespace shiva::editor
+{
+    //! A TTF file rasterized in the font atlas, merged in the previous font when merge is set
+    struct font_source
+    {
+        shiva::fs::path path;
+        float size;
+        //! pairs of codepoints terminated by 0, the default ranges of imgui if empty
+        std::vector<ImWchar> ranges{};
+        bool merge{false};
+        bool pixel_snap{false};
+    };
+
+    /**
+     * \note This class keeps the built imgui font atlas on disk: the alpha pixels of the texture and the glyph tables
+     * of the fonts. The atlas is loaded from the cache as long as the font files (size and modification time),
+     * their sizes and ranges and the version of imgui are the same, it is rasterized and saved again otherwise.
+     * \note layout: [header] [custom rects] ([font] [configs] [glyphs]) * nb_fonts [alpha pixels]
+     * \note the cache is only used with imgui < 1.74, the later versions keep more state in the built atlas
+     * (TexUvLines, PackIdMouseCursor...), the atlas is always rasterized with them.
+     * \class font_atlas_cache
+     */
+    class font_atlas_cache
+    {
+    public:
+#if defined(SHIVA_EDITOR_FONT_ATLAS_CACHE)
+        static constexpr bool supported = true;
+#else
+        static constexpr bool supported = false;
+#endif
+
+        //! Constructor
+        explicit font_atlas_cache(shiva::fs::path cache_path =
+        shiva::fs::current_path() / "cache" / "imgui" / "fonts.shivafonts") noexcept;
+
+        //! Public member functions
+
+        /**
+         * \note clear the atlas, then load it from the cache or build it from the fonts and save it.
+         * \return true if the atlas has been loaded from the cache
+         */
+        bool load_or_build(ImFontAtlas &atlas, const std::vector<font_source> &fonts) const noexcept;
+
+        //! \return the key of the fonts, the cache is valid only for the same key
+        static std::uint64_t key_of(const std::vector<font_source> &fonts) noexcept;
+
+        //! \return false if the cache is missing, invalid, made for other fonts or the imgui version is not supported
+        bool load(ImFontAtlas &atlas, std::uint64_t key) const noexcept;
+
+        //! \note the atlas is built if it is not, nothing is saved if the imgui version is not supported
+        bool save(ImFontAtlas &atlas, std::uint64_t key) const noexcept;
+
+    private:
+        //! Private data members
+        shiva::fs::path cache_path_;
+    };
+}
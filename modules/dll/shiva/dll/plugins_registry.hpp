@@ -9,6 +9,8 @@
 #include <functional>
 #include <boost/dll.hpp>
 #include <shiva/filesystem/filesystem.hpp>
+#include <shiva/filesystem/asset_manifest.hpp>
+#include <shiva/filesystem/vfs.hpp>
 #include <shiva/spdlog/spdlog.hpp>
 
 namespace shiva::helpers
@@ -91,6 +93,7 @@ namespace shiva::helpers
         symbols_container symbols{};
         shiva::fs::path plugins_directory_{};
         const std::string plugins_library_pattern_matching_{};
+        std::shared_ptr<shiva::filesystem::vfs> vfs_{shiva::filesystem::vfs::shared()};
         shiva::logging::logger log_{shiva::log::stdout_color_mt("plugins_registry")};
     };
 }
@@ -133,31 +136,40 @@ namespace shiva::helpers
     bool plugins_registry<CreatorSignature>::load_all_symbols() noexcept
     {
         bool res{true};
-        if (!fs::exists(plugins_directory_))
+        //! the libraries are listed by the vfs from the manifest of their mount (never hashed),
+        //! only the modified directories are listed again. The manifest can't be opened on a missing directory.
+        auto mount = vfs_->mount_directory(plugins_directory_);
+        if (!mount->has_manifest() &&
+            !mount->open_manifest(shiva::filesystem::asset_manifest::default_path(mount->get_root()), false)) {
             return false;
-        fs::recursive_directory_iterator endit;
-        for (fs::recursive_directory_iterator it(plugins_directory_); it != endit; ++it) {
-            if (!fs::is_regular_file(*it) ||
-                !is_shared_library((*it).path()) ||
-                (*it).path().filename().stem().string().find(plugins_library_pattern_matching_) == std::string::npos) {
-                continue;
+        }
+        vfs_->for_each_file(vfs_->mount_path(plugins_directory_), [this, &res](const std::string &virtual_path) {
+            //! a library is loaded from the disk, the ones of an archive or an overlay are skipped.
+            const auto disk_path = vfs_->disk_path(virtual_path);
+            if (!disk_path) {
+                return;
+            }
+            const auto &path = *disk_path;
+            if (!is_shared_library(path) ||
+                path.filename().stem().string().find(plugins_library_pattern_matching_) == std::string::npos) {
+                return;
             }
             try {
-                log_->debug("path -> {}", it->path().string());
-                symbols.emplace(it->path().string(),
+                log_->debug("path -> {}", path.string());
+                symbols.emplace(path.string(),
                                 library_contents{
                                     boost::dll::import_alias<CreatorSignature>(
-                                        boost::filesystem::path(it->path().string()),
+                                        boost::filesystem::path(path.string()),
                                         "create_plugin",
                                         dll::load_mode::append_decorations
-                                    ), shiva::fs::last_write_time(it->path()), "", 0});
-                log_->info("Successfully loaded: {}", it->path().filename().string());
+                                    ), shiva::fs::last_write_time(path), "", 0});
+                log_->info("Successfully loaded: {}", path.filename().string());
             }
             catch (const boost::system::system_error &error) {
-                log_->error("error loading: {0} -> {1}", it->path().filename().string(), error.what());
+                log_->error("error loading: {0} -> {1}", path.filename().string(), error.what());
                 res = false;
             }
-        }
+        });
         return res;
     }
 
@@ -3,6 +3,11 @@ set(MODULE_PATH
 
 set(MODULE_PUBLIC_HEADERS
         "${MODULE_PATH}/filesystem.hpp"
+        "${MODULE_PATH}/file_watcher.hpp"
+        "${MODULE_PATH}/pak_archive.hpp"
+        "${MODULE_PATH}/asset_manifest.hpp"
+        "${MODULE_PATH}/uring_reader.hpp"
+        "${MODULE_PATH}/vfs.hpp"
         )
 
 set(MODULE_PRIVATE_HEADERS
@@ -0,0 +1,496 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <map>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <functional>
+#include <string_view>
+#include <system_error>
+#include <shiva/filesystem/filesystem.hpp>
+#include <shiva/filesystem/pak_archive.hpp>
+
+namespace shiva::filesystem
+{
+    /**
+     * \note This class keeps the listing of a directory tree (paths, sizes, modification times, content hashes)
+     * in a manifest file, the listing is read in one shot instead of walking the tree at startup.
+     * \note The paths are relative to the root with '/' separators ("textures/game_scene/kirito.png"),
+     * the category of a file is the first directory of its path ("textures").
+     * \note refresh only stats the directories: a directory whose modification time changed is listed again,
+     * a new directory is walked. Modifying a file in place doesn't change the time of its directory,
+     * rebuild (or the hot reload) takes care of these modifications.
+     * \class asset_manifest
+     */
+    class asset_manifest
+    {
+    public:
+        //! Public typedefs
+        struct file_entry
+        {
+            std::uint64_t id{0u}; //!< pak::hash_path of the path
+            std::uint64_t size{0u};
+            std::int64_t mtime{0};
+            std::uint64_t content_hash{0u}; //!< 0 if the contents are not hashed
+        };
+
+        using files_map = std::map<std::string, file_entry, std::less<>>;
+
+        //! Constructors
+        /**
+         * \param hash_contents if false, the files are never read (large binaries, scripts...)
+         */
+        explicit asset_manifest(fs::path root, bool hash_contents = true) noexcept :
+            root_(std::move(root)),
+            hash_contents_(hash_contents)
+        {
+        }
+
+        //! Public static functions
+
+        /**
+         * \return the manifest of the root in the cache directory, never next to the scripts or the plugins:
+         * cache/manifests/<hash of the absolute root>.shivamanifest
+         */
+        static fs::path default_path(const fs::path &root) noexcept
+        {
+            std::error_code ec;
+            auto path = (root.is_absolute() ? root : fs::current_path(ec) / root).generic_string();
+            //! "systems/lua/" is "systems/lua/." for the experimental filesystem
+            while (path.size() > 1u && (path.back() == '/' || (path.back() == '.' && path[path.size() - 2u] == '/'))) {
+                path.pop_back();
+            }
+            char name[40] = {};
+            std::snprintf(name, sizeof(name), "%016llx.shivamanifest",
+                          static_cast<unsigned long long>(pak::fnv1a_64(path)));
+            return fs::current_path(ec) / "cache" / "manifests" / name;
+        }
+
+        //! Public member functions
+
+        /**
+         * \note load the manifest, refresh it (or build it if the file is missing or invalid)
+         * and save it again if something changed.
+         * \return false if the root doesn't exist, the listing is usable even if the manifest can't be saved
+         */
+        bool open(const fs::path &manifest_path) noexcept
+        {
+            std::error_code ec;
+            if (!fs::is_directory(root_, ec)) {
+                return false;
+            }
+            if (load(manifest_path)) {
+                refresh();
+            } else {
+                rebuild();
+            }
+            if (dirty_) {
+                save(manifest_path);
+            }
+            return true;
+        }
+
+        //! \return false if the manifest is missing, invalid or written by another version
+        bool load(const fs::path &manifest_path) noexcept
+        {
+            std::ifstream ifs(manifest_path, std::ios::binary);
+            if (!ifs.is_open()) {
+                return false;
+            }
+            const std::vector<char> data(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>{});
+            reader in{data.data(), data.data() + data.size()};
+            char file_magic[sizeof(magic)] = {};
+            std::uint32_t file_version = 0u;
+            std::uint32_t nb_directories = 0u;
+            std::uint32_t nb_files = 0u;
+            if (!in.read(file_magic, sizeof(file_magic)) || std::memcmp(file_magic, magic, sizeof(magic)) != 0 ||
+                !in.read(file_version) || file_version != version ||
+                !in.read(nb_directories) || !in.read(nb_files)) {
+                return false;
+            }
+            directories_map directories;
+            files_map files;
+            for (std::uint32_t idx = 0u; idx < nb_directories; ++idx) {
+                std::string path;
+                std::int64_t mtime = 0;
+                if (!in.read(path) || !in.read(mtime)) {
+                    return false;
+                }
+                directories.emplace(std::move(path), mtime);
+            }
+            for (std::uint32_t idx = 0u; idx < nb_files; ++idx) {
+                std::string path;
+                file_entry entry;
+                if (!in.read(path) || !in.read(entry.size) || !in.read(entry.mtime) || !in.read(entry.content_hash)) {
+                    return false;
+                }
+                entry.id = pak::hash_path(path);
+                files.emplace(std::move(path), entry);
+            }
+            directories_ = std::move(directories);
+            files_ = std::move(files);
+            dirty_ = false;
+            return true;
+        }
+
+        bool save(const fs::path &manifest_path) noexcept
+        {
+            std::string data(magic, sizeof(magic));
+            write_(data, version);
+            write_(data, static_cast<std::uint32_t>(directories_.size()));
+            write_(data, static_cast<std::uint32_t>(files_.size()));
+            for (auto &&[path, mtime] : directories_) {
+                write_(data, path);
+                write_(data, mtime);
+            }
+            for (auto &&[path, entry] : files_) {
+                write_(data, path);
+                write_(data, entry.size);
+                write_(data, entry.mtime);
+                write_(data, entry.content_hash);
+            }
+            std::error_code ec;
+            if (manifest_path.has_parent_path()) {
+                fs::create_directories(manifest_path.parent_path(), ec);
+            }
+            std::ofstream ofs(manifest_path, std::ios::binary | std::ios::trunc);
+            if (!ofs.is_open() || !ofs.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+                return false;
+            }
+            dirty_ = false;
+            return true;
+        }
+
+        //! \note walk the whole tree again
+        void rebuild() noexcept
+        {
+            files_map previous = std::move(files_);
+            files_.clear();
+            directories_.clear();
+            scan_tree_("", previous);
+            dirty_ = true;
+        }
+
+        /**
+         * \note list again the directories whose modification time changed, forget the removed ones.
+         * \return number of directories listed again
+         */
+        size_t refresh() noexcept
+        {
+            size_t nb_changed = 0u;
+            const directories_map known = directories_;
+            for (auto &&[directory, mtime] : known) {
+                if (!directories_.count(directory)) {
+                    continue; //! removed with its parent
+                }
+                std::error_code ec;
+                const auto current_mtime = mtime_(to_disk_path_(directory), ec);
+                if (ec) {
+                    erase_tree_(directory);
+                    ++nb_changed;
+                } else if (current_mtime != mtime) {
+                    rescan_directory_(directory, current_mtime);
+                    ++nb_changed;
+                }
+            }
+            dirty_ |= nb_changed > 0u;
+            return nb_changed;
+        }
+
+        /**
+         * \note stat every file and hash again the modified ones, for the tools which can't miss
+         * a file modified in place (one stat per file, unlike refresh).
+         * \return number of modified or removed files
+         */
+        size_t refresh_files() noexcept
+        {
+            size_t nb_changed = 0u;
+            for (auto it = files_.begin(); it != files_.end();) {
+                std::error_code ec;
+                const auto disk_path = to_disk_path_(it->first);
+                const auto size = static_cast<std::uint64_t>(fs::file_size(disk_path, ec));
+                const auto mtime = ec ? 0 : mtime_(disk_path, ec);
+                if (ec) {
+                    it = files_.erase(it);
+                    ++nb_changed;
+                    continue;
+                }
+                if (size != it->second.size || mtime != it->second.mtime) {
+                    it->second = make_entry_(it->first, disk_path, files_map{});
+                    ++nb_changed;
+                }
+                ++it;
+            }
+            dirty_ |= nb_changed > 0u;
+            return nb_changed;
+        }
+
+        //! \return the entry of the file, nullptr if the file is not in the manifest
+        const file_entry *find(std::string_view path) const noexcept
+        {
+            const auto it = files_.find(path);
+            return it != files_.end() ? &it->second : nullptr;
+        }
+
+        //! \param directory relative path of the directory, "" for the root
+        bool contains_directory(std::string_view directory) const noexcept
+        {
+            return directories_.find(directory) != directories_.end();
+        }
+
+        /**
+         * \note iterate over the files of the directory and its subdirectories, ordered by path.
+         * \param directory relative path of the directory, "" for the root
+         * \tparam Functor void(const std::string &path, const file_entry &entry)
+         * \return number of files
+         */
+        template <typename Functor>
+        size_t for_each_file(std::string_view directory, Functor &&functor) const
+        {
+            const auto prefix = directory.empty() ? std::string{} : std::string(directory) + "/";
+            size_t nb_files = 0u;
+            for (auto it = files_.lower_bound(prefix); it != files_.end() &&
+                                                       it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+                functor(it->first, it->second);
+                ++nb_files;
+            }
+            return nb_files;
+        }
+
+        size_t count(std::string_view directory) const noexcept
+        {
+            return for_each_file(directory, [](auto &&, auto &&) {});
+        }
+
+        //! \return the first directory of the path, "" for a file at the root
+        static std::string_view category(std::string_view path) noexcept
+        {
+            const auto pos = path.find('/');
+            return pos == std::string_view::npos ? std::string_view{} : path.substr(0, pos);
+        }
+
+        //! \return the relative path of a path inside the root, "" if the path is the root, std::nullopt if outside
+        std::optional<std::string> relative_path(const fs::path &path) const noexcept
+        {
+            const auto root = root_.generic_string();
+            const auto current = path.generic_string();
+            if (current.compare(0, root.size(), root) != 0 ||
+                (current.size() > root.size() && current[root.size()] != '/')) {
+                return std::nullopt;
+            }
+            auto relative = current.substr(root.size());
+            while (!relative.empty() && relative.front() == '/') {
+                relative.erase(0, 1);
+            }
+            while (!relative.empty() && relative.back() == '/') {
+                relative.pop_back();
+            }
+            return relative;
+        }
+
+        fs::path to_disk_path(std::string_view path) const noexcept
+        {
+            return to_disk_path_(path);
+        }
+
+        const files_map &get_files() const noexcept
+        {
+            return files_;
+        }
+
+        size_t size() const noexcept
+        {
+            return files_.size();
+        }
+
+        const fs::path &get_root() const noexcept
+        {
+            return root_;
+        }
+
+        bool is_dirty() const noexcept
+        {
+            return dirty_;
+        }
+
+        //! Public static members
+        static constexpr char magic[8] = {'S', 'H', 'I', 'V', 'A', 'M', 'A', 'N'};
+        static constexpr std::uint32_t version = 1u;
+
+    private:
+        //! Private typedefs
+        using directories_map = std::map<std::string, std::int64_t, std::less<>>;
+
+        struct reader
+        {
+            const char *cur;
+            const char *end;
+
+            bool read(void *out, size_t size) noexcept
+            {
+                if (static_cast<size_t>(end - cur) < size) {
+                    return false;
+                }
+                std::memcpy(out, cur, size);
+                cur += size;
+                return true;
+            }
+
+            template <typename T>
+            bool read(T &out) noexcept
+            {
+                return read(&out, sizeof(T));
+            }
+
+            bool read(std::string &out) noexcept
+            {
+                std::uint32_t size = 0u;
+                if (!read(size) || static_cast<size_t>(end - cur) < size) {
+                    return false;
+                }
+                out.assign(cur, size);
+                cur += size;
+                return true;
+            }
+        };
+
+        //! Private member functions
+        template <typename T>
+        static void write_(std::string &data, const T &value) noexcept
+        {
+            data.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        static void write_(std::string &data, const std::string &value) noexcept
+        {
+            write_(data, static_cast<std::uint32_t>(value.size()));
+            data.append(value);
+        }
+
+        static std::int64_t mtime_(const fs::path &path, std::error_code &ec) noexcept
+        {
+            return static_cast<std::int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+        }
+
+        fs::path to_disk_path_(std::string_view path) const noexcept
+        {
+            return path.empty() ? root_ : root_ / fs::path(std::string(path));
+        }
+
+        static std::string join_(std::string_view directory, const std::string &name) noexcept
+        {
+            return directory.empty() ? name : std::string(directory) + "/" + name;
+        }
+
+        //! \note the hash is reused when the size and the modification time didn't change
+        file_entry make_entry_(const std::string &path, const fs::path &disk_path, const files_map &previous) const
+        {
+            std::error_code ec;
+            file_entry entry;
+            entry.id = pak::hash_path(path);
+            entry.size = static_cast<std::uint64_t>(fs::file_size(disk_path, ec));
+            entry.mtime = mtime_(disk_path, ec);
+            if (auto it = previous.find(path); it != previous.end() && it->second.size == entry.size &&
+                                               it->second.mtime == entry.mtime) {
+                entry.content_hash = it->second.content_hash;
+            } else if (hash_contents_) {
+                std::ifstream ifs(disk_path, std::ios::binary);
+                const std::string data(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>{});
+                entry.content_hash = pak::fnv1a_64(data);
+            }
+            return entry;
+        }
+
+        //! \note list the directory (not recursive), the new subdirectories are walked
+        void scan_directory_(const std::string &directory, std::int64_t mtime, const files_map &previous)
+        {
+            directories_.insert_or_assign(directory, mtime);
+            std::error_code ec;
+            for (fs::directory_iterator it(to_disk_path_(directory), ec), end; !ec && it != end; it.increment(ec)) {
+                auto path = join_(directory, it->path().filename().string());
+                std::error_code status_ec;
+                if (fs::is_directory(it->path(), status_ec)) {
+                    if (!directories_.count(path)) {
+                        scan_tree_(path, previous);
+                    }
+                } else if (fs::is_regular_file(it->path(), status_ec)) {
+                    auto entry = make_entry_(path, it->path(), previous);
+                    files_.insert_or_assign(std::move(path), entry);
+                }
+            }
+        }
+
+        void scan_tree_(const std::string &directory, const files_map &previous)
+        {
+            std::error_code ec;
+            const auto mtime = mtime_(to_disk_path_(directory), ec);
+            if (!ec) {
+                scan_directory_(directory, mtime, previous);
+            }
+        }
+
+        void rescan_directory_(const std::string &directory, std::int64_t mtime)
+        {
+            files_map previous;
+            const auto prefix = directory.empty() ? std::string{} : directory + "/";
+            for (auto it = files_.lower_bound(prefix); it != files_.end() &&
+                                                       it->first.compare(0, prefix.size(), prefix) == 0;) {
+                //! only the direct children, the subdirectories are refreshed on their own
+                if (it->first.find('/', prefix.size()) == std::string::npos) {
+                    previous.insert(files_.extract(it++));
+                } else {
+                    ++it;
+                }
+            }
+            //! the removed subdirectories
+            for (auto it = directories_.lower_bound(prefix); it != directories_.end() &&
+                                                             it->first.compare(0, prefix.size(), prefix) == 0;) {
+                const auto &subdirectory = it->first;
+                ++it;
+                std::error_code ec;
+                if (subdirectory != directory && subdirectory.find('/', prefix.size()) == std::string::npos &&
+                    !fs::is_directory(to_disk_path_(subdirectory), ec)) {
+                    const std::string removed = subdirectory;
+                    erase_tree_(removed);
+                    it = directories_.lower_bound(removed);
+                }
+            }
+            scan_directory_(directory, mtime, previous);
+        }
+
+        void erase_tree_(const std::string &directory) noexcept
+        {
+            if (directory.empty()) {
+                directories_.clear();
+                files_.clear();
+                return;
+            }
+            const auto prefix = directory + "/";
+            directories_.erase(directory);
+            for (auto it = directories_.lower_bound(prefix); it != directories_.end() &&
+                                                             it->first.compare(0, prefix.size(), prefix) == 0;) {
+                it = directories_.erase(it);
+            }
+            for (auto it = files_.lower_bound(prefix); it != files_.end() &&
+                                                       it->first.compare(0, prefix.size(), prefix) == 0;) {
+                it = files_.erase(it);
+            }
+        }
+
+        //! Private data members
+        fs::path root_;
+        bool hash_contents_;
+        bool dirty_{false};
+        directories_map directories_;
+        files_map files_;
+    };
+}
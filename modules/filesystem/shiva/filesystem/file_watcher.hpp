@@ -0,0 +1,189 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <shiva/filesystem/filesystem.hpp>
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#define SHIVA_USE_INOTIFY
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+
+namespace shiva::filesystem
+{
+    /**
+     * \note This class watches a directory (recursively) and reports the regular files that have been modified.
+     * \note On linux the kernel notifications (inotify) are used, on other platforms the last write time
+     * of the files is compared at each poll.
+     * \note The class never blocks, poll must be called regularly (every frame for example).
+     * \class file_watcher
+     */
+    class file_watcher
+    {
+    public:
+        //! Constructors
+        /**
+         * \param root the directory to watch, sub-directories (even the one created later) are watched too.
+         */
+        inline explicit file_watcher(fs::path root) noexcept;
+
+        file_watcher(const file_watcher &) = delete;
+
+        file_watcher &operator=(const file_watcher &) = delete;
+
+        //! Destructor
+        inline ~file_watcher() noexcept;
+
+        //! Public member functions
+
+        /**
+         * \note apply the functor on each file modified since the last call, each file is reported only once.
+         * \tparam Functor signature must be void(const shiva::fs::path &)
+         * \return number of modified files
+         */
+        template <typename Functor>
+        size_t poll(Functor &&functor) noexcept;
+
+        /**
+         * \return true if the watched directory exists and the watcher is operational, false otherwise
+         */
+        inline bool is_valid() const noexcept;
+
+        inline const fs::path &get_root() const noexcept;
+
+    private:
+        //! Private member functions
+        inline void watch_directory_(const fs::path &directory) noexcept;
+
+        //! Private data members
+        fs::path root_;
+#if defined(SHIVA_USE_INOTIFY)
+        int fd_{-1};
+        std::unordered_map<int, fs::path> watches_;
+#else
+        std::unordered_map<std::string, fs::file_time_type> last_write_times_;
+#endif
+    };
+}
+
+namespace shiva::filesystem
+{
+    //! Constructor
+    file_watcher::file_watcher(fs::path root) noexcept : root_(std::move(root))
+    {
+        std::error_code ec;
+        if (!fs::exists(root_, ec)) {
+            return;
+        }
+#if defined(SHIVA_USE_INOTIFY)
+        fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd_ < 0) {
+            return;
+        }
+#endif
+        watch_directory_(root_);
+        for (fs::recursive_directory_iterator it(root_, ec), end; !ec && it != end; it.increment(ec)) {
+            if (fs::is_directory(it->path(), ec)) {
+                watch_directory_(it->path());
+            }
+#if !defined(SHIVA_USE_INOTIFY)
+            else if (fs::is_regular_file(it->path(), ec)) {
+                last_write_times_[it->path().string()] = fs::last_write_time(it->path(), ec);
+            }
+#endif
+        }
+    }
+
+    //! Destructor
+    file_watcher::~file_watcher() noexcept
+    {
+#if defined(SHIVA_USE_INOTIFY)
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+#endif
+    }
+
+    //! Public member functions
+    template <typename Functor>
+    size_t file_watcher::poll(Functor &&functor) noexcept
+    {
+        if (!is_valid()) {
+            return 0u;
+        }
+
+        //! std::set, editors often write a file several times in a row.
+        std::set<fs::path> modified_files;
+        std::error_code ec;
+#if defined(SHIVA_USE_INOTIFY)
+        alignas(inotify_event) char buffer[4096];
+        ssize_t len;
+        while ((len = ::read(fd_, buffer, sizeof(buffer))) > 0) {
+            for (char *ptr = buffer; ptr < buffer + len;) {
+                const auto *event = reinterpret_cast<const inotify_event *>(ptr);
+                ptr += sizeof(inotify_event) + event->len;
+                auto it = watches_.find(event->wd);
+                if (it == watches_.end() || event->len == 0u) {
+                    continue;
+                }
+                fs::path current = it->second / event->name;
+                if (event->mask & IN_ISDIR) {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                        watch_directory_(current);
+                    }
+                } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                    modified_files.insert(std::move(current));
+                }
+            }
+        }
+#else
+        for (fs::recursive_directory_iterator it(root_, ec), end; !ec && it != end; it.increment(ec)) {
+            if (!fs::is_regular_file(it->path(), ec)) {
+                continue;
+            }
+            auto current_time = fs::last_write_time(it->path(), ec);
+            auto[time_it, inserted] = last_write_times_.try_emplace(it->path().string(), current_time);
+            if (inserted || time_it->second != current_time) {
+                time_it->second = current_time;
+                modified_files.insert(it->path());
+            }
+        }
+#endif
+        for (auto &&current : modified_files) {
+            functor(current);
+        }
+        return modified_files.size();
+    }
+
+    bool file_watcher::is_valid() const noexcept
+    {
+#if defined(SHIVA_USE_INOTIFY)
+        return fd_ >= 0;
+#else
+        std::error_code ec;
+        return fs::exists(root_, ec);
+#endif
+    }
+
+    const fs::path &file_watcher::get_root() const noexcept
+    {
+        return root_;
+    }
+
+    //! Private member functions
+    void file_watcher::watch_directory_([[maybe_unused]] const fs::path &directory) noexcept
+    {
+#if defined(SHIVA_USE_INOTIFY)
+        int wd = inotify_add_watch(fd_, directory.string().c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (wd >= 0) {
+            watches_.insert_or_assign(wd, directory);
+        }
+#endif
+    }
+}
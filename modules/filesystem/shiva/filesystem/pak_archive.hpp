@@ -0,0 +1,565 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <system_error>
+#include <shiva/filesystem/filesystem.hpp>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#if defined(SHIVA_USE_LZ4)
+#include <lz4.h>
+#endif
+
+namespace shiva::filesystem::pak
+{
+    /**
+     * \note layout of a .shivapak archive:
+     * [header] [entries data, each aligned on header.alignment] [entry table] [index slots] [paths]
+     * \note the index is an open addressing hash table (linear probing, power of two size) of the hashed paths,
+     * each slot contains the position of the entry in the entry table + 1 (0 is an empty slot).
+     * \note the paths are stored relative to the root of the archive with '/' separators, null terminated.
+     */
+    inline constexpr char magic[8] = {'S', 'H', 'I', 'V', 'A', 'P', 'A', 'K'};
+    inline constexpr std::uint32_t version = 1u;
+
+    enum entry_flags : std::uint32_t
+    {
+        none = 0u,
+        lz4_compressed = 1u << 0u
+    };
+
+    struct header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t alignment;
+        std::uint32_t nb_entries;
+        std::uint32_t nb_slots;
+        std::uint64_t entries_offset;
+        std::uint64_t slots_offset;
+        std::uint64_t paths_offset;
+        std::uint64_t paths_size;
+    };
+
+    struct entry
+    {
+        std::uint64_t path_hash;
+        std::uint64_t content_hash;
+        std::uint64_t offset;
+        std::uint64_t stored_size;
+        std::uint64_t size;
+        std::uint32_t path_offset;
+        std::uint32_t flags;
+    };
+
+    static_assert(std::is_trivially_copyable_v<header> && std::is_trivially_copyable_v<entry>);
+
+    /**
+     * \return the 64 bits FNV-1a hash of data
+     */
+    constexpr std::uint64_t fnv1a_64(std::string_view data) noexcept
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (auto c : data) {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    //! the hash of a path is never 0, 0 is reserved
+    constexpr std::uint64_t hash_path(std::string_view path) noexcept
+    {
+        const auto hash = fnv1a_64(path);
+        return hash == 0u ? 1u : hash;
+    }
+}
+
+namespace shiva::filesystem
+{
+    /**
+     * \note This class gives a read only access to a .shivapak archive, the archive is memory mapped.
+     * \note The lookup of an entry by path is O(1), the uncompressed entries are accessible without any copy.
+     * \note The views returned by this class are valid as long as the archive is open.
+     * \class pak_archive
+     */
+    class pak_archive
+    {
+    public:
+        //! Constructors
+        pak_archive() noexcept = default;
+
+        explicit pak_archive(const fs::path &path) noexcept
+        {
+            open(path);
+        }
+
+        pak_archive(const pak_archive &) = delete;
+
+        pak_archive &operator=(const pak_archive &) = delete;
+
+        //! Destructor
+        ~pak_archive() noexcept
+        {
+            close();
+        }
+
+        //! Public member functions
+
+        /**
+         * \note map the archive in memory and check his header.
+         * \return true if the archive is valid, false otherwise
+         */
+        bool open(const fs::path &path) noexcept
+        {
+            close();
+            if (!map_(path)) {
+                return false;
+            }
+            if (!check_()) {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        void close() noexcept
+        {
+#if defined(_WIN32)
+            if (data_ != nullptr) {
+                UnmapViewOfFile(data_);
+            }
+            if (mapping_ != nullptr) {
+                CloseHandle(mapping_);
+            }
+            if (file_ != INVALID_HANDLE_VALUE) {
+                CloseHandle(file_);
+            }
+            mapping_ = nullptr;
+            file_ = INVALID_HANDLE_VALUE;
+#else
+            if (data_ != nullptr) {
+                ::munmap(const_cast<char *>(data_), size_);
+            }
+#endif
+            data_ = nullptr;
+            size_ = 0u;
+            header_ = nullptr;
+            entries_ = nullptr;
+            slots_ = nullptr;
+        }
+
+        bool is_open() const noexcept
+        {
+            return header_ != nullptr;
+        }
+
+        size_t size() const noexcept
+        {
+            return is_open() ? header_->nb_entries : 0u;
+        }
+
+        /**
+         * \param path path relative to the root of the archive, with '/' separators
+         * \return the entry of the given path, nullptr if the archive doesn't contains it
+         */
+        const pak::entry *find(std::string_view path) const noexcept
+        {
+            if (!is_open() || header_->nb_slots == 0u) {
+                return nullptr;
+            }
+            const auto hash = pak::hash_path(path);
+            const auto mask = header_->nb_slots - 1u;
+            for (auto slot = static_cast<std::uint32_t>(hash) & mask;; slot = (slot + 1u) & mask) {
+                const auto idx = slots_[slot];
+                if (idx == 0u) {
+                    return nullptr;
+                }
+                const auto &current = entries_[idx - 1u];
+                if (current.path_hash == hash && get_path(current) == path) {
+                    return &current;
+                }
+            }
+        }
+
+        std::string_view get_path(const pak::entry &entry) const noexcept
+        {
+            return std::string_view(data_ + header_->paths_offset + entry.path_offset);
+        }
+
+        bool is_compressed(const pak::entry &entry) const noexcept
+        {
+            return (entry.flags & pak::lz4_compressed) != 0u;
+        }
+
+        /**
+         * \return the bytes of the entry as stored in the archive (compressed or not), without copy.
+         */
+        std::string_view view(const pak::entry &entry) const noexcept
+        {
+            return std::string_view(data_ + entry.offset, static_cast<size_t>(entry.stored_size));
+        }
+
+        /**
+         * \note copy (and uncompress if needed) the content of the entry into out.
+         * \return false if the entry can't be uncompressed, true otherwise
+         */
+        bool extract(const pak::entry &entry, std::vector<char> &out) const noexcept
+        {
+            const auto stored = view(entry);
+            out.resize(static_cast<size_t>(entry.size));
+            if (!is_compressed(entry)) {
+                std::memcpy(out.data(), stored.data(), std::min(stored.size(), out.size()));
+                return stored.size() == out.size();
+            }
+#if defined(SHIVA_USE_LZ4)
+            const auto res = LZ4_decompress_safe(stored.data(), out.data(), static_cast<int>(stored.size()),
+                                                 static_cast<int>(out.size()));
+            return res == static_cast<int>(out.size());
+#else
+            out.clear();
+            return false;
+#endif
+        }
+
+        /**
+         * \return true if the content of the entry matches his content hash, false otherwise
+         */
+        bool verify(const pak::entry &entry) const noexcept
+        {
+            if (!is_compressed(entry)) {
+                return pak::fnv1a_64(view(entry)) == entry.content_hash;
+            }
+            std::vector<char> content;
+            return extract(entry, content) &&
+                   pak::fnv1a_64(std::string_view(content.data(), content.size())) == entry.content_hash;
+        }
+
+        /**
+         * \note apply the functor on each entry whose path starts with prefix.
+         * \tparam Functor signature must be void(std::string_view path, const pak::entry &)
+         */
+        template <typename Functor>
+        void for_each_entry(std::string_view prefix, Functor &&functor) const
+        {
+            for (std::uint32_t idx = 0u; idx < size(); ++idx) {
+                const auto path = get_path(entries_[idx]);
+                if (path.compare(0, prefix.size(), prefix) == 0) {
+                    functor(path, entries_[idx]);
+                }
+            }
+        }
+
+        /**
+         * \return true if at least one entry path starts with prefix
+         */
+        bool contains_prefix(std::string_view prefix) const noexcept
+        {
+            for (std::uint32_t idx = 0u; idx < size(); ++idx) {
+                if (get_path(entries_[idx]).compare(0, prefix.size(), prefix) == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        //! Private member functions
+        bool map_(const fs::path &path) noexcept
+        {
+            std::error_code ec;
+            const auto file_size = fs::file_size(path, ec);
+            if (ec || file_size < sizeof(pak::header)) {
+                return false;
+            }
+#if defined(_WIN32)
+            file_ = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file_ == INVALID_HANDLE_VALUE) {
+                return false;
+            }
+            mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping_ == nullptr) {
+                return false;
+            }
+            data_ = static_cast<const char *>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+            if (data_ == nullptr) {
+                return false;
+            }
+#else
+            const int fd = ::open(path.string().c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                return false;
+            }
+            void *address = ::mmap(nullptr, static_cast<size_t>(file_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (address == MAP_FAILED) {
+                return false;
+            }
+            data_ = static_cast<const char *>(address);
+#endif
+            size_ = static_cast<size_t>(file_size);
+            return true;
+        }
+
+        //! \return true if the range [offset, offset + length) is inside the mapping
+        bool fits_(std::uint64_t offset, std::uint64_t length) const noexcept
+        {
+            return offset <= size_ && length <= size_ - offset;
+        }
+
+        bool check_() noexcept
+        {
+            const auto *header = reinterpret_cast<const pak::header *>(data_);
+            if (std::memcmp(header->magic, pak::magic, sizeof(pak::magic)) != 0 || header->version != pak::version) {
+                return false;
+            }
+            const bool is_power_of_two = header->nb_slots != 0u && (header->nb_slots & (header->nb_slots - 1u)) == 0u;
+            //! at least one empty slot, find stops on it for a missing path
+            //! the bounds are written as subtractions, an additive form can wrap with a tampered header
+            if (!is_power_of_two || header->nb_slots <= header->nb_entries ||
+                !fits_(header->entries_offset, std::uint64_t{header->nb_entries} * sizeof(pak::entry)) ||
+                !fits_(header->slots_offset, std::uint64_t{header->nb_slots} * sizeof(std::uint32_t)) ||
+                !fits_(header->paths_offset, header->paths_size) ||
+                header->entries_offset % alignof(pak::entry) != 0u ||
+                header->slots_offset % alignof(std::uint32_t) != 0u ||
+                (header->paths_size > 0u && data_[header->paths_offset + header->paths_size - 1u] != '\0')) {
+                return false;
+            }
+            const auto *entries = reinterpret_cast<const pak::entry *>(data_ + header->entries_offset);
+            for (std::uint32_t idx = 0u; idx < header->nb_entries; ++idx) {
+                const auto &current = entries[idx];
+                if (!fits_(current.offset, current.stored_size) || current.path_offset >= header->paths_size ||
+                    ((current.flags & pak::lz4_compressed) == 0u && current.stored_size != current.size)) {
+                    return false;
+                }
+            }
+            const auto *slots = reinterpret_cast<const std::uint32_t *>(data_ + header->slots_offset);
+            std::uint32_t nb_used_slots = 0u;
+            for (std::uint32_t slot = 0u; slot < header->nb_slots; ++slot) {
+                if (slots[slot] > header->nb_entries) {
+                    return false;
+                }
+                nb_used_slots += slots[slot] != 0u ? 1u : 0u;
+            }
+            if (nb_used_slots > header->nb_entries) {
+                return false;
+            }
+            header_ = header;
+            entries_ = entries;
+            slots_ = slots;
+            return true;
+        }
+
+        //! Private data members
+        const char *data_{nullptr};
+        size_t size_{0u};
+        const pak::header *header_{nullptr};
+        const pak::entry *entries_{nullptr};
+        const std::uint32_t *slots_{nullptr};
+#if defined(_WIN32)
+        HANDLE file_{INVALID_HANDLE_VALUE};
+        HANDLE mapping_{nullptr};
+#endif
+    };
+
+    /**
+     * \note This class builds a .shivapak archive, see pak_archive.
+     * \note The compression is only applied if shiva is built with SHIVA_USE_LZ4 and if it makes the entry smaller.
+     * \class pak_writer
+     */
+    class pak_writer
+    {
+    public:
+        //! Constructors
+        explicit pak_writer(std::uint32_t alignment = 16u) noexcept : alignment_(alignment == 0u ? 1u : alignment)
+        {
+        }
+
+        //! Public member functions
+
+        /**
+         * \param archive_path path of the entry inside the archive, with '/' separators
+         * \param compress if true, the entry is stored LZ4 compressed (never compress the fonts and the musics,
+         * they are streamed from the mapping)
+         */
+        void add_data(std::string archive_path, std::string_view data, bool compress = false)
+        {
+            pending_.push_back(pending_entry{std::move(archive_path), std::vector<char>(data.begin(), data.end()),
+                                             compress});
+        }
+
+        bool add_file(const fs::path &file, std::string archive_path, bool compress = false)
+        {
+            std::ifstream ifs(file, std::ios::binary);
+            if (!ifs.is_open()) {
+                return false;
+            }
+            pending_.push_back(pending_entry{std::move(archive_path),
+                                             std::vector<char>(std::istreambuf_iterator<char>(ifs),
+                                                               std::istreambuf_iterator<char>{}), compress});
+            return true;
+        }
+
+        /**
+         * \note add every regular file of root (recursively), the paths of the entries are relative to root.
+         * \param compress_predicate bool(const fs::path &) telling if a file should be compressed
+         * \return number of files added
+         */
+        template <typename Predicate>
+        size_t add_directory(const fs::path &root, Predicate &&compress_predicate)
+        {
+            size_t nb_files = 0u;
+            const auto root_str = root.generic_string();
+            std::error_code ec;
+            for (fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+                if (!fs::is_regular_file(it->path(), ec)) {
+                    continue;
+                }
+                auto archive_path = it->path().generic_string().substr(root_str.size());
+                while (!archive_path.empty() && archive_path.front() == '/') {
+                    archive_path.erase(0, 1);
+                }
+                nb_files += add_file(it->path(), std::move(archive_path), compress_predicate(it->path()));
+            }
+            return nb_files;
+        }
+
+        size_t size() const noexcept
+        {
+            return pending_.size();
+        }
+
+        /**
+         * \return true if the archive has been written, false otherwise (I/O error or duplicated path)
+         */
+        bool write(const fs::path &output) const
+        {
+            pak::header header{};
+            std::memcpy(header.magic, pak::magic, sizeof(pak::magic));
+            header.version = pak::version;
+            header.alignment = alignment_;
+            header.nb_entries = static_cast<std::uint32_t>(pending_.size());
+            header.nb_slots = 1u;
+            while (header.nb_slots < pending_.size() * 2u) {
+                header.nb_slots <<= 1u;
+            }
+
+            std::vector<char> blob(sizeof(pak::header), '\0');
+            std::vector<pak::entry> entries;
+            std::string paths;
+            for (auto &&current : pending_) {
+                pak::entry entry{};
+                entry.path_hash = pak::hash_path(current.path);
+                entry.content_hash = pak::fnv1a_64(std::string_view(current.data.data(), current.data.size()));
+                entry.size = current.data.size();
+                entry.path_offset = static_cast<std::uint32_t>(paths.size());
+                paths.append(current.path).push_back('\0');
+
+                std::vector<char> stored = compress_(current);
+                entry.flags = stored.empty() ? pak::none : pak::lz4_compressed;
+                const auto &data = stored.empty() ? current.data : stored;
+                blob.resize(align_(blob.size()), '\0');
+                entry.offset = blob.size();
+                entry.stored_size = data.size();
+                blob.insert(blob.end(), data.begin(), data.end());
+                entries.push_back(entry);
+            }
+
+            std::vector<std::uint32_t> slots(header.nb_slots, 0u);
+            const auto mask = header.nb_slots - 1u;
+            for (std::uint32_t idx = 0u; idx < entries.size(); ++idx) {
+                auto slot = static_cast<std::uint32_t>(entries[idx].path_hash) & mask;
+                while (slots[slot] != 0u) {
+                    if (pending_[slots[slot] - 1u].path == pending_[idx].path) {
+                        return false;
+                    }
+                    slot = (slot + 1u) & mask;
+                }
+                slots[slot] = idx + 1u;
+            }
+
+            blob.resize(align_(blob.size()), '\0');
+            header.entries_offset = blob.size();
+            append_(blob, entries.data(), entries.size() * sizeof(pak::entry));
+            header.slots_offset = blob.size();
+            append_(blob, slots.data(), slots.size() * sizeof(std::uint32_t));
+            header.paths_offset = blob.size();
+            header.paths_size = paths.size();
+            append_(blob, paths.data(), paths.size());
+            std::memcpy(blob.data(), &header, sizeof(header));
+
+            std::ofstream ofs(output, std::ios::binary | std::ios::trunc);
+            ofs.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+            return ofs.good();
+        }
+
+    private:
+        //! Private typedefs
+        struct pending_entry
+        {
+            std::string path;
+            std::vector<char> data;
+            bool compress;
+        };
+
+        //! Private member functions
+        size_t align_(size_t offset) const noexcept
+        {
+            return (offset + alignment_ - 1u) / alignment_ * alignment_;
+        }
+
+        static void append_(std::vector<char> &blob, const void *data, size_t size)
+        {
+            const auto *bytes = static_cast<const char *>(data);
+            blob.insert(blob.end(), bytes, bytes + size);
+        }
+
+        //! \return the compressed data, empty if the entry is stored uncompressed
+        static std::vector<char> compress_([[maybe_unused]] const pending_entry &current)
+        {
+            std::vector<char> compressed;
+#if defined(SHIVA_USE_LZ4)
+            if (!current.compress || current.data.empty()) {
+                return compressed;
+            }
+            compressed.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(current.data.size()))));
+            const auto res = LZ4_compress_default(current.data.data(), compressed.data(),
+                                                  static_cast<int>(current.data.size()),
+                                                  static_cast<int>(compressed.size()));
+            if (res <= 0 || static_cast<size_t>(res) >= current.data.size()) {
+                compressed.clear();
+            } else {
+                compressed.resize(static_cast<size_t>(res));
+            }
+#endif
+            return compressed;
+        }
+
+        //! Private data members
+        std::uint32_t alignment_;
+        std::vector<pending_entry> pending_;
+    };
+}
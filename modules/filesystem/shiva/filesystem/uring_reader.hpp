@@ -0,0 +1,230 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <shiva/filesystem/filesystem.hpp>
+
+#if defined(SHIVA_USE_IO_URING)
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <liburing.h>
+#endif
+
+namespace shiva::filesystem
+{
+    /**
+     * \note This class reads a batch of loose files at once: with io_uring (Linux, built with SHIVA_USE_IO_URING)
+     * the reads of the whole batch are submitted together (up to the depth of the ring) and completed as they arrive,
+     * instead of one blocking open/read/close chain per file.
+     * \note If io_uring is not available (other platforms, old kernels, ring refused by a sandbox)
+     * the files are read one after the other with blocking reads.
+     * \class uring_reader
+     */
+    class uring_reader
+    {
+    public:
+        //! Public typedefs
+        struct request
+        {
+            fs::path path;
+            std::vector<char> *out; //!< resized to the size of the file
+        };
+
+        //! Constructors
+        explicit uring_reader([[maybe_unused]] unsigned int depth = 64u) noexcept
+        {
+#if defined(SHIVA_USE_IO_URING)
+            depth_ = depth == 0u ? 1u : depth;
+            is_valid_ = io_uring_queue_init(depth_, &ring_, 0u) == 0;
+#endif
+        }
+
+        uring_reader(const uring_reader &) = delete;
+
+        uring_reader &operator=(const uring_reader &) = delete;
+
+        //! Destructor
+        ~uring_reader() noexcept
+        {
+#if defined(SHIVA_USE_IO_URING)
+            if (is_valid_) {
+                io_uring_queue_exit(&ring_);
+            }
+#endif
+        }
+
+        //! Public static functions
+
+        //! \return true if shiva is built with the io_uring backend
+        static constexpr bool is_supported() noexcept
+        {
+#if defined(SHIVA_USE_IO_URING)
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        //! Public member functions
+
+        //! \return true if the ring has been created, false if the reads are blocking
+        bool is_valid() const noexcept
+        {
+            return is_valid_;
+        }
+
+        /**
+         * \note read every file of the batch, the functor is called as soon as a file is read.
+         * \tparam Functor void(size_t idx, bool success), idx is the position of the request in the batch
+         */
+        template <typename Functor>
+        void read(std::vector<request> &requests, Functor &&on_complete)
+        {
+#if defined(SHIVA_USE_IO_URING)
+            if (is_valid_) {
+                read_ring_(requests, on_complete);
+                return;
+            }
+#endif
+            for (size_t idx = 0u; idx < requests.size(); ++idx) {
+                on_complete(idx, read_blocking_(requests[idx]));
+            }
+        }
+
+    private:
+        //! Private member functions
+        static bool read_blocking_(request &current)
+        {
+            std::ifstream ifs(current.path, std::ios::binary | std::ios::ate);
+            if (!ifs.is_open()) {
+                return false;
+            }
+            current.out->resize(static_cast<size_t>(ifs.tellg()));
+            ifs.seekg(0);
+            ifs.read(current.out->data(), static_cast<std::streamsize>(current.out->size()));
+            return ifs.good() || current.out->empty();
+        }
+
+#if defined(SHIVA_USE_IO_URING)
+        struct pending_read
+        {
+            int fd{-1};
+            size_t offset{0u};
+        };
+
+        //! \note the files are opened while the previous reads are in flight, the short reads are submitted again
+        template <typename Functor>
+        void read_ring_(std::vector<request> &requests, Functor &on_complete)
+        {
+            std::vector<pending_read> pending(requests.size());
+            size_t next = 0u;
+            size_t in_flight = 0u;
+            const auto finish = [&](size_t idx, bool success) {
+                ::close(pending[idx].fd);
+                pending[idx].fd = -1;
+                if (!success) {
+                    requests[idx].out->clear();
+                }
+                on_complete(idx, success);
+            };
+            const auto submit = [&](size_t idx) {
+                auto &current = pending[idx];
+                auto *out = requests[idx].out;
+                io_uring_sqe *sqe = io_uring_get_sqe(&ring_);
+                io_uring_prep_read(sqe, current.fd, out->data() + current.offset,
+                                   static_cast<unsigned int>(out->size() - current.offset), current.offset);
+                io_uring_sqe_set_data(sqe, reinterpret_cast<void *>(static_cast<std::uintptr_t>(idx)));
+            };
+
+            while (next < requests.size() || in_flight > 0u) {
+                while (next < requests.size() && in_flight < depth_) {
+                    const auto idx = next++;
+                    struct stat infos{};
+                    const int fd = ::open(requests[idx].path.string().c_str(), O_RDONLY | O_CLOEXEC);
+                    if (fd < 0 || ::fstat(fd, &infos) != 0) {
+                        if (fd >= 0) {
+                            ::close(fd);
+                        }
+                        on_complete(idx, false);
+                        continue;
+                    }
+                    pending[idx].fd = fd;
+                    requests[idx].out->resize(static_cast<size_t>(infos.st_size));
+                    if (requests[idx].out->empty()) {
+                        finish(idx, true);
+                        continue;
+                    }
+                    submit(idx);
+                    ++in_flight;
+                }
+                if (in_flight == 0u) {
+                    continue;
+                }
+                //! interrupted by a signal, the entries already submitted stay in flight
+                int submitted = 0;
+                do {
+                    submitted = io_uring_submit_and_wait(&ring_, 1u);
+                } while (submitted == -EINTR);
+                if (submitted < 0) {
+                    //! the ring is unusable, the reads in flight are lost: everything left is read with blocking reads
+                    io_uring_queue_exit(&ring_);
+                    is_valid_ = false;
+                    for (size_t idx = 0u; idx < next; ++idx) {
+                        if (pending[idx].fd >= 0) {
+                            ::close(pending[idx].fd);
+                            pending[idx].fd = -1;
+                            on_complete(idx, read_blocking_(requests[idx]));
+                        }
+                    }
+                    for (; next < requests.size(); ++next) {
+                        on_complete(next, read_blocking_(requests[next]));
+                    }
+                    return;
+                }
+                io_uring_cqe *cqe = nullptr;
+                while (io_uring_peek_cqe(&ring_, &cqe) == 0) {
+                    const auto idx = static_cast<size_t>(reinterpret_cast<std::uintptr_t>(io_uring_cqe_get_data(cqe)));
+                    const int res = cqe->res;
+                    io_uring_cqe_seen(&ring_, cqe);
+                    auto &current = pending[idx];
+                    if (res == -EINTR || res == -EAGAIN) {
+                        submit(idx);
+                        continue;
+                    }
+                    if (res < 0) {
+                        --in_flight;
+                        finish(idx, false);
+                        continue;
+                    }
+                    current.offset += static_cast<size_t>(res);
+                    if (res == 0) {
+                        //! the file has been truncated since it was opened
+                        requests[idx].out->resize(current.offset);
+                    }
+                    if (current.offset < requests[idx].out->size()) {
+                        submit(idx);
+                        continue;
+                    }
+                    --in_flight;
+                    finish(idx, true);
+                }
+            }
+        }
+#endif
+
+        //! Private data members
+        bool is_valid_{false};
+#if defined(SHIVA_USE_IO_URING)
+        unsigned int depth_{64u};
+        io_uring ring_{};
+#endif
+    };
+}
@@ -0,0 +1,256 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#include <shiva/filesystem/vfs.hpp>
+
+namespace shiva::filesystem
+{
+    //! directory_mount, public member functions
+    bool directory_mount::open_manifest(const fs::path &manifest_path, bool hash_contents) noexcept
+    {
+        asset_manifest manifest(root_, hash_contents);
+        if (!manifest.open(manifest_path)) {
+            return false;
+        }
+        std::unique_lock lock(mutex_);
+        manifest_ = std::move(manifest);
+        return true;
+    }
+
+    size_t directory_mount::refresh()
+    {
+        std::unique_lock lock(mutex_);
+        return manifest_ ? manifest_->refresh() : 0u;
+    }
+
+    std::optional<vfs_stat> directory_mount::stat(std::string_view path) const
+    {
+        {
+            std::shared_lock lock(mutex_);
+            if (manifest_) {
+                if (const auto *entry = manifest_->find(path); entry != nullptr) {
+                    return vfs_stat{entry->size, entry->mtime, false};
+                }
+                if (manifest_->contains_directory(path)) {
+                    return vfs_stat{0u, 0, true};
+                }
+            }
+        }
+        std::error_code ec;
+        const auto disk = to_disk_path_(path);
+        const auto status = fs::status(disk, ec);
+        if (ec || !fs::exists(status)) {
+            return std::nullopt;
+        }
+        vfs_stat res{};
+        res.is_directory = fs::is_directory(status);
+        if (!res.is_directory) {
+            res.size = static_cast<std::uint64_t>(fs::file_size(disk, ec));
+            res.mtime = static_cast<std::int64_t>(fs::last_write_time(disk, ec).time_since_epoch().count());
+        }
+        return res;
+    }
+
+    bool directory_mount::read(std::string_view path, std::vector<char> &out) const
+    {
+        std::ifstream ifs(to_disk_path_(path), std::ios::binary | std::ios::ate);
+        if (!ifs.is_open()) {
+            return false;
+        }
+        out.resize(static_cast<size_t>(ifs.tellg()));
+        ifs.seekg(0);
+        ifs.read(out.data(), static_cast<std::streamsize>(out.size()));
+        return ifs.good() || out.empty();
+    }
+
+    void directory_mount::for_each_file(std::string_view directory,
+                                        const std::function<void(const std::string &path)> &functor) const
+    {
+        {
+            std::shared_lock lock(mutex_);
+            if (manifest_) {
+                manifest_->for_each_file(directory, [&functor](const std::string &path, auto &&) {
+                    functor(path);
+                });
+                return;
+            }
+        }
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(to_disk_path_(directory), ec), end;
+             !ec && it != end; it.increment(ec)) {
+            if (fs::is_regular_file(it->path(), ec)) {
+                functor(relative_(it->path()));
+            }
+        }
+    }
+
+    void directory_mount::list(std::string_view directory,
+                               const std::function<void(const std::string &name, bool is_directory)> &functor) const
+    {
+        if (has_manifest()) {
+            vfs_mount::list(directory, functor);
+            return;
+        }
+        std::error_code ec;
+        for (fs::directory_iterator it(to_disk_path_(directory), ec), end; !ec && it != end; it.increment(ec)) {
+            functor(it->path().filename().string(), fs::is_directory(it->path(), ec));
+        }
+    }
+
+    //! archive_mount, public member functions
+    std::optional<vfs_stat> archive_mount::stat(std::string_view path) const
+    {
+        if (const auto *entry = archive_.find(path); entry != nullptr) {
+            return vfs_stat{entry->size, 0, false};
+        }
+        if (path.empty() ? archive_.size() > 0u : archive_.contains_prefix(std::string(path) + "/")) {
+            return vfs_stat{0u, 0, true};
+        }
+        return std::nullopt;
+    }
+
+    bool archive_mount::read(std::string_view path, std::vector<char> &out) const
+    {
+        const auto *entry = archive_.find(path);
+        return entry != nullptr && archive_.extract(*entry, out);
+    }
+
+    std::optional<std::string_view> archive_mount::view(std::string_view path) const
+    {
+        if (const auto *entry = archive_.find(path); entry != nullptr && !archive_.is_compressed(*entry)) {
+            return archive_.view(*entry);
+        }
+        return std::nullopt;
+    }
+
+    void archive_mount::for_each_file(std::string_view directory,
+                                      const std::function<void(const std::string &path)> &functor) const
+    {
+        const auto prefix = directory.empty() ? std::string{} : std::string(directory) + "/";
+        archive_.for_each_entry(prefix, [&functor](std::string_view path, const pak::entry &) {
+            functor(std::string(path));
+        });
+    }
+
+    //! memory_mount, public member functions
+    void memory_mount::add_file(std::string path, std::string data)
+    {
+        std::unique_lock lock(mutex_);
+        files_.insert_or_assign(std::move(path), std::move(data));
+    }
+
+    bool memory_mount::remove_file(std::string_view path) noexcept
+    {
+        std::unique_lock lock(mutex_);
+        if (auto it = files_.find(path); it != files_.end()) {
+            files_.erase(it);
+            return true;
+        }
+        return false;
+    }
+
+    std::optional<vfs_stat> memory_mount::stat(std::string_view path) const
+    {
+        std::shared_lock lock(mutex_);
+        if (auto it = files_.find(path); it != files_.end()) {
+            return vfs_stat{it->second.size(), 0, false};
+        }
+        const auto prefix = path.empty() ? std::string{} : std::string(path) + "/";
+        if (auto it = files_.lower_bound(prefix);
+            it != files_.end() && it->first.compare(0, prefix.size(), prefix) == 0) {
+            return vfs_stat{0u, 0, true};
+        }
+        return std::nullopt;
+    }
+
+    bool memory_mount::read(std::string_view path, std::vector<char> &out) const
+    {
+        std::shared_lock lock(mutex_);
+        auto it = files_.find(path);
+        if (it == files_.end()) {
+            return false;
+        }
+        out.assign(it->second.begin(), it->second.end());
+        return true;
+    }
+
+    std::optional<std::string_view> memory_mount::view(std::string_view path) const
+    {
+        std::shared_lock lock(mutex_);
+        if (auto it = files_.find(path); it != files_.end()) {
+            return std::string_view(it->second);
+        }
+        return std::nullopt;
+    }
+
+    void memory_mount::for_each_file(std::string_view directory,
+                                     const std::function<void(const std::string &path)> &functor) const
+    {
+        const auto prefix = directory.empty() ? std::string{} : std::string(directory) + "/";
+        std::vector<std::string> paths;
+        {
+            std::shared_lock lock(mutex_);
+            for (auto it = files_.lower_bound(prefix);
+                 it != files_.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+                paths.push_back(it->first);
+            }
+        }
+        for (auto &&path : paths) {
+            functor(path);
+        }
+    }
+
+    //! vfs, public member functions
+    vfs::mount_id vfs::mount(std::string mount_point, std::shared_ptr<vfs_mount> source, int priority)
+    {
+        while (!mount_point.empty() && mount_point.back() == '/') {
+            mount_point.pop_back();
+        }
+        std::unique_lock lock(mounts_mutex_);
+        const auto id = ++last_mount_id_;
+        auto directory = std::dynamic_pointer_cast<directory_mount>(source);
+        mounts_.push_back(mount_entry{id, std::move(mount_point), priority, std::move(source), std::move(directory)});
+        std::stable_sort(mounts_.begin(), mounts_.end(), [](auto &&lhs, auto &&rhs) {
+            return lhs.priority > rhs.priority || (lhs.priority == rhs.priority && lhs.id > rhs.id);
+        });
+        invalidate();
+        return id;
+    }
+
+    bool vfs::unmount(mount_id id) noexcept
+    {
+        std::unique_lock lock(mounts_mutex_);
+        auto it = std::find_if(mounts_.begin(), mounts_.end(), [id](auto &&current) {
+            return current.id == id;
+        });
+        if (it == mounts_.end()) {
+            return false;
+        }
+        mounts_.erase(it);
+        invalidate();
+        return true;
+    }
+
+    std::shared_ptr<directory_mount> vfs::mount_directory(const fs::path &root, int priority)
+    {
+        if (auto res = find_directory_(root); res) {
+            return res;
+        }
+        auto res = std::make_shared<directory_mount>(root);
+        mount(mount_point_of_(res->get_root_string()), res, priority);
+        return res;
+    }
+
+    //! vfs, public static functions
+    const std::shared_ptr<vfs> &vfs::shared() noexcept
+    {
+        static const std::shared_ptr<vfs> instance = []() {
+            auto res = std::make_shared<vfs>();
+            std::error_code ec;
+            res->mount_directory(fs::current_path(ec) / "assets");
+            return res;
+        }();
+        return instance;
+    }
+}
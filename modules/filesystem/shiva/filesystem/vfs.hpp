@@ -0,0 +1,943 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <future>
+#include <memory>
+#include <fstream>
+#include <optional>
+#include <algorithm>
+#include <functional>
+#include <string_view>
+#include <shared_mutex>
+#include <system_error>
+#include <unordered_map>
+#include <condition_variable>
+#include <boost/config.hpp>
+#include <shiva/filesystem/filesystem.hpp>
+#include <shiva/filesystem/pak_archive.hpp>
+#include <shiva/filesystem/asset_manifest.hpp>
+#include <shiva/filesystem/uring_reader.hpp>
+
+#if defined(SHIVA_FILESYSTEM_SHARED_EXPORTS)
+#define SHIVA_FILESYSTEM_SHARED_API BOOST_SYMBOL_EXPORT
+#else
+#define SHIVA_FILESYSTEM_SHARED_API BOOST_SYMBOL_IMPORT
+#endif
+
+namespace shiva::filesystem
+{
+    struct vfs_stat
+    {
+        std::uint64_t size{0u};
+        std::int64_t mtime{0}; //!< 0 for the files of an archive or of an overlay
+        bool is_directory{false};
+    };
+
+    class buffer_pool;
+
+    /**
+     * \note This class is a buffer returned by the reads of the vfs, the memory goes back to its pool
+     * when the buffer is destroyed (the pool may be destroyed first, the buffer is then simply freed).
+     * \class pooled_buffer
+     */
+    class pooled_buffer
+    {
+    public:
+        //! Constructors
+        pooled_buffer() noexcept = default;
+
+        pooled_buffer(std::vector<char> data, std::weak_ptr<buffer_pool> pool) noexcept :
+            data_(std::move(data)),
+            pool_(std::move(pool))
+        {
+        }
+
+        pooled_buffer(const pooled_buffer &) = delete;
+
+        pooled_buffer &operator=(const pooled_buffer &) = delete;
+
+        pooled_buffer(pooled_buffer &&other) noexcept = default;
+
+        pooled_buffer &operator=(pooled_buffer &&other) noexcept
+        {
+            if (this != &other) {
+                release_();
+                data_ = std::move(other.data_);
+                pool_ = std::move(other.pool_);
+            }
+            return *this;
+        }
+
+        //! Destructor
+        ~pooled_buffer() noexcept
+        {
+            release_();
+        }
+
+        //! Public member functions
+        const char *data() const noexcept
+        {
+            return data_.data();
+        }
+
+        char *data() noexcept
+        {
+            return data_.data();
+        }
+
+        size_t size() const noexcept
+        {
+            return data_.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return data_.empty();
+        }
+
+        std::string_view view() const noexcept
+        {
+            return std::string_view(data_.data(), data_.size());
+        }
+
+        std::vector<char> &get() noexcept
+        {
+            return data_;
+        }
+
+    private:
+        //! Private member functions
+        inline void release_() noexcept;
+
+        //! Private data members
+        std::vector<char> data_;
+        std::weak_ptr<buffer_pool> pool_;
+    };
+
+    /**
+     * \note This class keeps the memory of the released buffers to reuse it for the next reads,
+     * it must be created with std::make_shared.
+     * \class buffer_pool
+     */
+    class buffer_pool : public std::enable_shared_from_this<buffer_pool>
+    {
+    public:
+        //! Constructors
+        /**
+         * \param max_buffers number of released buffers kept
+         * \param max_capacity the released buffers larger than this are freed
+         */
+        explicit buffer_pool(size_t max_buffers = 32u, size_t max_capacity = 16u * 1024u * 1024u) noexcept :
+            max_buffers_(max_buffers),
+            max_capacity_(max_capacity)
+        {
+        }
+
+        //! Public member functions
+
+        //! \return a buffer of size bytes, the smallest released buffer large enough is reused
+        pooled_buffer acquire(size_t size)
+        {
+            std::vector<char> data;
+            {
+                std::scoped_lock lock(mutex_);
+                auto best = free_.end();
+                for (auto it = free_.begin(); it != free_.end(); ++it) {
+                    if (it->capacity() >= size && (best == free_.end() || it->capacity() < best->capacity())) {
+                        best = it;
+                    }
+                }
+                if (best == free_.end() && !free_.empty()) {
+                    best = std::max_element(free_.begin(), free_.end(), [](auto &&lhs, auto &&rhs) {
+                        return lhs.capacity() < rhs.capacity();
+                    });
+                }
+                if (best != free_.end()) {
+                    data = std::move(*best);
+                    free_.erase(best);
+                }
+            }
+            data.resize(size);
+            return pooled_buffer(std::move(data), weak_from_this());
+        }
+
+        void release(std::vector<char> &&data) noexcept
+        {
+            if (data.capacity() == 0u || data.capacity() > max_capacity_) {
+                return;
+            }
+            data.clear();
+            std::scoped_lock lock(mutex_);
+            if (free_.size() < max_buffers_) {
+                free_.push_back(std::move(data));
+            }
+        }
+
+        //! \return number of released buffers waiting to be reused
+        size_t size() const noexcept
+        {
+            std::scoped_lock lock(mutex_);
+            return free_.size();
+        }
+
+    private:
+        //! Private data members
+        size_t max_buffers_;
+        size_t max_capacity_;
+        mutable std::mutex mutex_;
+        std::vector<std::vector<char>> free_;
+    };
+
+    void pooled_buffer::release_() noexcept
+    {
+        if (auto pool = pool_.lock(); pool) {
+            pool->release(std::move(data_));
+        }
+        data_ = std::vector<char>{};
+        pool_.reset();
+    }
+
+    /**
+     * \note This class is the interface of the sources mounted in the vfs,
+     * the paths are relative to the mount point, with '/' separators ("" is the root of the mount).
+     * \note The member functions are called concurrently by the I/O threads of the vfs.
+     * \class vfs_mount
+     */
+    class vfs_mount
+    {
+    public:
+        //! Destructor
+        virtual ~vfs_mount() noexcept = default;
+
+        //! Public member functions
+
+        //! \return std::nullopt if the mount doesn't contains the path
+        virtual std::optional<vfs_stat> stat(std::string_view path) const = 0;
+
+        //! \return false if the file can't be read
+        virtual bool read(std::string_view path, std::vector<char> &out) const = 0;
+
+        /**
+         * \return the bytes of the file without copy (valid as long as the mount is alive),
+         * std::nullopt if the mount can't give them (loose file, compressed entry)
+         */
+        virtual std::optional<std::string_view> view([[maybe_unused]] std::string_view path) const
+        {
+            return std::nullopt;
+        }
+
+        //! \return the file on the disk, std::nullopt if the file is not a loose file
+        virtual std::optional<fs::path> disk_path([[maybe_unused]] std::string_view path) const
+        {
+            return std::nullopt;
+        }
+
+        //! \note apply the functor on the files of the directory and of its subdirectories
+        virtual void for_each_file(std::string_view directory,
+                                   const std::function<void(const std::string &path)> &functor) const = 0;
+
+        //! \note apply the functor on the direct children of the directory, the names may be repeated
+        virtual void list(std::string_view directory,
+                          const std::function<void(const std::string &name, bool is_directory)> &functor) const
+        {
+            const size_t offset = directory.empty() ? 0u : directory.size() + 1u;
+            for_each_file(directory, [offset, &functor](const std::string &path) {
+                const auto separator = path.find('/', offset);
+                functor(path.substr(offset, separator == std::string::npos ? separator : separator - offset),
+                        separator != std::string::npos);
+            });
+        }
+
+        //! \return number of changes found since the mount was created or refreshed
+        virtual size_t refresh()
+        {
+            return 0u;
+        }
+    };
+
+    /**
+     * \note loose files of a directory of the disk, listed from an asset_manifest once one is opened
+     * (the walks are replaced by the manifest, the files missing from it are still found on the disk).
+     * \class directory_mount
+     */
+    class SHIVA_FILESYSTEM_SHARED_API directory_mount final : public vfs_mount
+    {
+    public:
+        //! Constructors
+        explicit directory_mount(fs::path root) noexcept : root_(std::move(root))
+        {
+            root_str_ = root_.generic_string();
+            while (root_str_.size() > 1u && root_str_.back() == '/') {
+                root_str_.pop_back();
+            }
+        }
+
+        //! Public member functions
+
+        /**
+         * \note open (or build) the manifest of the directory, see asset_manifest::open.
+         * \return false if the directory doesn't exist
+         */
+        bool open_manifest(const fs::path &manifest_path, bool hash_contents = true) noexcept;
+
+        bool has_manifest() const noexcept
+        {
+            std::shared_lock lock(mutex_);
+            return manifest_.has_value();
+        }
+
+        //! \note list again the modified directories of the manifest, see asset_manifest::refresh
+        size_t refresh() override;
+
+        const fs::path &get_root() const noexcept
+        {
+            return root_;
+        }
+
+        //! \return the root with '/' separators and without trailing separator
+        const std::string &get_root_string() const noexcept
+        {
+            return root_str_;
+        }
+
+        std::optional<vfs_stat> stat(std::string_view path) const override;
+
+        bool read(std::string_view path, std::vector<char> &out) const override;
+
+        std::optional<fs::path> disk_path(std::string_view path) const override
+        {
+            return to_disk_path_(path);
+        }
+
+        void for_each_file(std::string_view directory,
+                           const std::function<void(const std::string &path)> &functor) const override;
+
+        void list(std::string_view directory,
+                  const std::function<void(const std::string &name, bool is_directory)> &functor) const override;
+
+    private:
+        //! Private member functions
+        fs::path to_disk_path_(std::string_view path) const noexcept
+        {
+            return path.empty() ? root_ : root_ / fs::path(std::string(path));
+        }
+
+        std::string relative_(const fs::path &disk_path) const noexcept
+        {
+            auto res = disk_path.generic_string().substr(root_str_.size());
+            while (!res.empty() && res.front() == '/') {
+                res.erase(0, 1);
+            }
+            return res;
+        }
+
+        //! Private data members
+        fs::path root_;
+        std::string root_str_;
+        mutable std::shared_mutex mutex_;
+        std::optional<asset_manifest> manifest_;
+    };
+
+    /**
+     * \note entries of a .shivapak archive, the uncompressed entries are viewed in the mapping without copy.
+     * \class archive_mount
+     */
+    class SHIVA_FILESYSTEM_SHARED_API archive_mount final : public vfs_mount
+    {
+    public:
+        //! Constructors
+        explicit archive_mount(const fs::path &archive_path) noexcept : archive_(archive_path)
+        {
+        }
+
+        //! Public member functions
+        bool is_open() const noexcept
+        {
+            return archive_.is_open();
+        }
+
+        const pak_archive &get_archive() const noexcept
+        {
+            return archive_;
+        }
+
+        std::optional<vfs_stat> stat(std::string_view path) const override;
+
+        bool read(std::string_view path, std::vector<char> &out) const override;
+
+        std::optional<std::string_view> view(std::string_view path) const override;
+
+        void for_each_file(std::string_view directory,
+                           const std::function<void(const std::string &path)> &functor) const override;
+
+    private:
+        //! Private data members
+        pak_archive archive_;
+    };
+
+    /**
+     * \note files kept in memory (generated data, editor overlays, tests), mounted above the disk and the archives.
+     * \note a view of a file is valid until the file is replaced or removed.
+     * \class memory_mount
+     */
+    class SHIVA_FILESYSTEM_SHARED_API memory_mount final : public vfs_mount
+    {
+    public:
+        //! Public member functions
+        void add_file(std::string path, std::string data);
+
+        bool remove_file(std::string_view path) noexcept;
+
+        size_t size() const noexcept
+        {
+            std::shared_lock lock(mutex_);
+            return files_.size();
+        }
+
+        std::optional<vfs_stat> stat(std::string_view path) const override;
+
+        bool read(std::string_view path, std::vector<char> &out) const override;
+
+        std::optional<std::string_view> view(std::string_view path) const override;
+
+        void for_each_file(std::string_view directory,
+                           const std::function<void(const std::string &path)> &functor) const override;
+
+    private:
+        //! Private data members
+        mutable std::shared_mutex mutex_;
+        std::map<std::string, std::string, std::less<>> files_;
+    };
+
+    /**
+     * \note This class is the virtual filesystem of the engine: every source of files (directories of the disk,
+     * archives, in memory overlays) is mounted on a virtual path, the mounts of higher priority hide the files
+     * of the mounts below them (the last mounted wins between equal priorities).
+     * \note The virtual paths use '/' separators, a directory of the current directory is mounted on its relative
+     * path ("assets"), any other directory on its absolute path.
+     * \note The resolutions of the paths found (mount, size, modification time) are cached until invalidate or refresh,
+     * a missing path is resolved again at each lookup: a new file is visible as soon as it is written.
+     * The reads return pooled buffers and can be queued on the I/O threads (read_async, read_batch).
+     * \note The resources, the scripts, the plugins and the editor share the instance returned by shared(),
+     * defined in the shiva::filesystem-shared library: one instance per process, whichever plugin asks for it.
+     * \class vfs
+     */
+    class vfs
+    {
+    public:
+        //! Public typedefs
+        using mount_id = std::uint32_t;
+        using read_result = std::optional<pooled_buffer>;
+
+        //! Public static members
+        static constexpr int archive_priority = 10;
+        static constexpr int overlay_priority = 20;
+
+        //! Constructors
+        explicit vfs(unsigned int nb_io_threads = 2u) noexcept : nb_io_threads_(nb_io_threads)
+        {
+        }
+
+        vfs(const vfs &) = delete;
+
+        vfs &operator=(const vfs &) = delete;
+
+        //! Destructor
+        ~vfs() noexcept
+        {
+            {
+                std::scoped_lock lock(queue_mutex_);
+                stopping_ = true;
+            }
+            queue_cv_.notify_all();
+            for (auto &&thread : io_threads_) {
+                thread.join();
+            }
+        }
+
+        //! Public static functions
+
+        //! \return the instance shared by the modules, with the assets directory of the current directory mounted
+        SHIVA_FILESYSTEM_SHARED_API static const std::shared_ptr<vfs> &shared() noexcept;
+
+        //! Public member functions
+
+        /**
+         * \param mount_point virtual path of the root of the source, "" for the root of the vfs
+         * \return the id of the mount, used to unmount it
+         */
+        SHIVA_FILESYSTEM_SHARED_API mount_id mount(std::string mount_point, std::shared_ptr<vfs_mount> source, int priority = 0);
+
+        SHIVA_FILESYSTEM_SHARED_API bool unmount(mount_id id) noexcept;
+
+        /**
+         * \note mount a directory of the disk on its virtual path, nothing is mounted if the directory
+         * is already mounted or is inside a mounted directory.
+         * \note the directory is not checked: a missing one has no files, directory_mount::open_manifest fails on it.
+         * \return the mount containing the directory
+         */
+        SHIVA_FILESYSTEM_SHARED_API std::shared_ptr<directory_mount> mount_directory(const fs::path &root, int priority = 0);
+
+        //! \return the virtual path of a path of the disk, std::nullopt if no mounted directory contains it
+        std::optional<std::string> to_virtual(const fs::path &path) const noexcept
+        {
+            const auto path_str = generic_(path);
+            std::shared_lock lock(mounts_mutex_);
+            const mount_entry *best = nullptr;
+            std::string_view best_relative;
+            for (auto &&current : mounts_) {
+                if (!current.directory) {
+                    continue;
+                }
+                const auto &root = current.directory->get_root_string();
+                if (auto relative = relative_(root, path_str);
+                    relative && (best == nullptr || root.size() > best->directory->get_root_string().size())) {
+                    best = &current;
+                    best_relative = *relative;
+                }
+            }
+            if (best == nullptr) {
+                return std::nullopt;
+            }
+            return join_(best->mount_point, best_relative);
+        }
+
+        //! \return the virtual path of a directory of the disk, the directory is mounted if needed
+        std::string mount_path(const fs::path &directory)
+        {
+            if (auto res = to_virtual(directory); res) {
+                return *res;
+            }
+            mount_directory(directory);
+            return to_virtual(directory).value_or(std::string{});
+        }
+
+        //! \return the virtual path of a file of the disk, its directory is mounted if needed
+        std::string virtual_path(const fs::path &file)
+        {
+            if (auto res = to_virtual(file); res) {
+                return *res;
+            }
+            return join_(mount_path(file.parent_path()), file.filename().string());
+        }
+
+        //! \return the size and the modification time of the file (cached), std::nullopt if no mount contains it
+        std::optional<vfs_stat> stat(std::string_view path) const
+        {
+            const auto resolved = resolve_(path);
+            if (!resolved.found) {
+                return std::nullopt;
+            }
+            return resolved.stat;
+        }
+
+        bool exists(std::string_view path) const
+        {
+            return resolve_(path).found;
+        }
+
+        bool is_directory(std::string_view path) const
+        {
+            const auto resolved = resolve_(path);
+            return resolved.found && resolved.stat.is_directory;
+        }
+
+        //! \return the file on the disk if the file is a loose file, std::nullopt otherwise (archive, overlay)
+        std::optional<fs::path> disk_path(std::string_view path) const
+        {
+            auto[source, relative] = source_of_(path);
+            return source ? source->disk_path(relative) : std::nullopt;
+        }
+
+        //! \return the bytes of the file without copy (uncompressed archive entry, overlay), std::nullopt otherwise
+        std::optional<std::string_view> view(std::string_view path) const
+        {
+            auto[source, relative] = source_of_(path);
+            return source ? source->view(relative) : std::nullopt;
+        }
+
+        //! \return the content of the file in a pooled buffer, std::nullopt if the file can't be read
+        read_result read(std::string_view path) const
+        {
+            auto[source, relative] = source_of_(path);
+            if (!source) {
+                return std::nullopt;
+            }
+            auto buffer = pool_->acquire(0u);
+            if (!source->read(relative, buffer.get())) {
+                invalidate(path);
+                return std::nullopt;
+            }
+            return read_result{std::move(buffer)};
+        }
+
+        //! \note queue the read on the I/O threads
+        std::future<read_result> read_async(std::string path) const
+        {
+            auto task = std::make_shared<std::packaged_task<read_result()>>([this, path = std::move(path)]() {
+                return this->read(path);
+            });
+            auto res = task->get_future();
+            push_io_job_([task]() {
+                (*task)();
+            });
+            return res;
+        }
+
+        /**
+         * \note queue the reads of every file at once, the futures are in the order of the paths.
+         * \note the loose files are read together by one I/O job through an uring_reader
+         * (a single submission with io_uring), the other files are queued one by one.
+         */
+        std::vector<std::future<read_result>> read_batch(const std::vector<std::string> &paths) const
+        {
+            struct loose_batch
+            {
+                std::vector<std::string> paths;
+                std::vector<uring_reader::request> requests;
+                std::vector<pooled_buffer> buffers;
+                std::vector<std::promise<read_result>> promises;
+            };
+
+            std::vector<std::future<read_result>> res(paths.size());
+            auto batch = std::make_shared<loose_batch>();
+            for (size_t idx = 0u; idx < paths.size(); ++idx) {
+                auto disk = disk_path(paths[idx]);
+                if (!disk) {
+                    res[idx] = read_async(paths[idx]);
+                    continue;
+                }
+                batch->paths.push_back(paths[idx]);
+                batch->requests.push_back(uring_reader::request{std::move(disk.value()), nullptr});
+                batch->buffers.push_back(pool_->acquire(0u));
+                res[idx] = batch->promises.emplace_back().get_future();
+            }
+            if (batch->requests.empty()) {
+                return res;
+            }
+            for (size_t idx = 0u; idx < batch->requests.size(); ++idx) {
+                batch->requests[idx].out = &batch->buffers[idx].get();
+            }
+            push_io_job_([this, batch]() {
+                uring_reader reader(static_cast<unsigned int>(std::min<size_t>(batch->requests.size(), 64u)));
+                reader.read(batch->requests, [this, &batch](size_t idx, bool success) {
+                    if (!success) {
+                        this->invalidate(batch->paths[idx]);
+                        batch->promises[idx].set_value(std::nullopt);
+                        return;
+                    }
+                    batch->promises[idx].set_value(read_result{std::move(batch->buffers[idx])});
+                });
+            });
+            return res;
+        }
+
+        /**
+         * \note apply the functor on the files of the directory and of its subdirectories, in every mount,
+         * ordered by path and without duplicates.
+         * \tparam Functor void(const std::string &path), path is a virtual path
+         * \return number of files
+         */
+        template <typename Functor>
+        size_t for_each_file(std::string_view directory, Functor &&functor) const
+        {
+            std::set<std::string> files;
+            {
+                std::shared_lock lock(mounts_mutex_);
+                for (auto &&current : mounts_) {
+                    std::optional<std::string_view> relative = relative_(current.mount_point, directory);
+                    if (!relative && !relative_(directory, current.mount_point)) {
+                        continue;
+                    }
+                    current.source->for_each_file(relative.value_or(std::string_view{}),
+                                                  [&files, &current](const std::string &path) {
+                                                      files.insert(join_(current.mount_point, path));
+                                                  });
+                }
+            }
+            for (auto &&path : files) {
+                functor(path);
+            }
+            return files.size();
+        }
+
+        size_t count_files(std::string_view directory) const
+        {
+            return for_each_file(directory, [](auto &&) {
+            });
+        }
+
+        /**
+         * \note apply the functor on the direct children of the directory in every mount, ordered by name.
+         * \tparam Functor void(const std::string &name, bool is_directory)
+         * \return number of children
+         */
+        template <typename Functor>
+        size_t list(std::string_view directory, Functor &&functor) const
+        {
+            std::map<std::string, bool> children;
+            {
+                std::shared_lock lock(mounts_mutex_);
+                for (auto &&current : mounts_) {
+                    if (auto relative = relative_(current.mount_point, directory); relative) {
+                        current.source->list(*relative, [&children](const std::string &name, bool is_dir) {
+                            auto &value = children[name];
+                            value = value || is_dir;
+                        });
+                    } else if (auto nested = relative_(directory, current.mount_point); nested) {
+                        children[std::string(nested->substr(0, nested->find('/')))] = true;
+                    }
+                }
+            }
+            for (auto &&[name, is_dir] : children) {
+                functor(name, is_dir);
+            }
+            return children.size();
+        }
+
+        //! \note forget the cached resolution of a path (modified or removed file)
+        void invalidate(std::string_view path) const noexcept
+        {
+            std::scoped_lock lock(cache_mutex_);
+            if (auto it = cache_.find(std::string(path)); it != cache_.end()) {
+                cache_.erase(it);
+            }
+            ++generation_;
+        }
+
+        void invalidate() const noexcept
+        {
+            std::scoped_lock lock(cache_mutex_);
+            cache_.clear();
+            ++generation_;
+        }
+
+        //! \note refresh every mount (manifests) and forget the cached resolutions, \return number of changes
+        size_t refresh() noexcept
+        {
+            size_t res = 0u;
+            {
+                std::shared_lock lock(mounts_mutex_);
+                for (auto &&current : mounts_) {
+                    res += current.source->refresh();
+                }
+            }
+            invalidate();
+            return res;
+        }
+
+        size_t nb_mounts() const noexcept
+        {
+            std::shared_lock lock(mounts_mutex_);
+            return mounts_.size();
+        }
+
+        const std::shared_ptr<buffer_pool> &get_buffer_pool() const noexcept
+        {
+            return pool_;
+        }
+
+    private:
+        //! Private typedefs
+        struct mount_entry
+        {
+            mount_id id;
+            std::string mount_point;
+            int priority;
+            std::shared_ptr<vfs_mount> source;
+            std::shared_ptr<directory_mount> directory; //!< the source if it is a directory, nullptr otherwise
+        };
+
+        struct resolution
+        {
+            bool found{false};
+            mount_id id{0u};
+            vfs_stat stat{};
+        };
+
+        //! Private static functions
+        static std::string generic_(const fs::path &path) noexcept
+        {
+            auto res = path.generic_string();
+            while (res.size() > 1u && res.back() == '/') {
+                res.pop_back();
+            }
+            return res;
+        }
+
+        //! \return the path relative to the parent, "" if equal, std::nullopt if the path is not inside the parent
+        static std::optional<std::string_view> relative_(std::string_view parent, std::string_view path) noexcept
+        {
+            if (parent.empty()) {
+                return path;
+            }
+            if (path.compare(0, parent.size(), parent) != 0) {
+                return std::nullopt;
+            }
+            if (path.size() == parent.size()) {
+                return std::string_view{};
+            }
+            if (path[parent.size()] != '/') {
+                return std::nullopt;
+            }
+            return path.substr(parent.size() + 1u);
+        }
+
+        static std::string join_(std::string_view lhs, std::string_view rhs) noexcept
+        {
+            if (lhs.empty() || rhs.empty()) {
+                return std::string(lhs.empty() ? rhs : lhs);
+            }
+            return std::string(lhs).append("/").append(rhs);
+        }
+
+        //! \return the virtual path of a directory of the disk: relative to the current directory if inside it
+        static std::string mount_point_of_(const std::string &root) noexcept
+        {
+            std::error_code ec;
+            const auto current = generic_(fs::current_path(ec));
+            if (auto relative = relative_(current, root); !ec && relative) {
+                return std::string(*relative);
+            }
+            return root;
+        }
+
+        //! Private member functions
+        std::shared_ptr<directory_mount> find_directory_(const fs::path &root) const noexcept
+        {
+            const auto root_str = generic_(root);
+            std::shared_lock lock(mounts_mutex_);
+            for (auto &&current : mounts_) {
+                if (current.directory && relative_(current.directory->get_root_string(), root_str)) {
+                    return current.directory;
+                }
+            }
+            return nullptr;
+        }
+
+        resolution resolve_(std::string_view path) const
+        {
+            std::uint64_t generation = 0u;
+            {
+                std::scoped_lock lock(cache_mutex_);
+                generation = generation_;
+                if (auto it = cache_.find(std::string(path)); it != cache_.end()) {
+                    return it->second;
+                }
+            }
+            resolution res;
+            {
+                std::shared_lock lock(mounts_mutex_);
+                for (auto &&current : mounts_) {
+                    auto relative = relative_(current.mount_point, path);
+                    if (!relative) {
+                        continue;
+                    }
+                    if (auto stat = current.source->stat(*relative); stat) {
+                        res = resolution{true, current.id, *stat};
+                        break;
+                    }
+                }
+                //! the parents of the mount points are directories
+                if (!res.found) {
+                    for (auto &&current : mounts_) {
+                        if (relative_(path, current.mount_point)) {
+                            res = resolution{true, 0u, vfs_stat{0u, 0, true}};
+                            break;
+                        }
+                    }
+                }
+            }
+            //! not cached if the mounts changed or the path was invalidated meanwhile, nor if it is missing
+            std::scoped_lock lock(cache_mutex_);
+            if (generation == generation_ && res.found) {
+                cache_.insert_or_assign(std::string(path), res);
+            }
+            return res;
+        }
+
+        //! \return the mount hiding the others for this file and the path relative to it
+        std::pair<std::shared_ptr<vfs_mount>, std::string> source_of_(std::string_view path) const
+        {
+            const auto resolved = resolve_(path);
+            if (!resolved.found || resolved.stat.is_directory) {
+                return {};
+            }
+            std::shared_lock lock(mounts_mutex_);
+            for (auto &&current : mounts_) {
+                if (current.id == resolved.id) {
+                    return {current.source, std::string(relative_(current.mount_point, path).value_or(path))};
+                }
+            }
+            return {};
+        }
+
+        void push_io_job_(std::function<void()> job) const
+        {
+            if (nb_io_threads_ == 0u) {
+                job();
+                return;
+            }
+            {
+                std::scoped_lock lock(queue_mutex_);
+                queue_.push_back(std::move(job));
+                if (io_threads_.empty()) {
+                    for (unsigned int idx = 0u; idx < nb_io_threads_; ++idx) {
+                        io_threads_.emplace_back([this]() {
+                            this->io_loop_();
+                        });
+                    }
+                }
+            }
+            queue_cv_.notify_one();
+        }
+
+        //! \note the jobs still queued when the vfs is destroyed are run before the threads stop
+        void io_loop_() const
+        {
+            for (;;) {
+                std::function<void()> job;
+                {
+                    std::unique_lock lock(queue_mutex_);
+                    queue_cv_.wait(lock, [this]() {
+                        return stopping_ || !queue_.empty();
+                    });
+                    if (queue_.empty()) {
+                        return;
+                    }
+                    job = std::move(queue_.front());
+                    queue_.pop_front();
+                }
+                job();
+            }
+        }
+
+        //! Private data members
+        mutable std::shared_mutex mounts_mutex_;
+        std::vector<mount_entry> mounts_;
+        mount_id last_mount_id_{0u};
+
+        mutable std::mutex cache_mutex_;
+        mutable std::unordered_map<std::string, resolution> cache_;
+        mutable std::uint64_t generation_{0u};
+
+        std::shared_ptr<buffer_pool> pool_{std::make_shared<buffer_pool>()};
+
+        unsigned int nb_io_threads_;
+        mutable std::mutex queue_mutex_;
+        mutable std::condition_variable queue_cv_;
+        mutable std::deque<std::function<void()>> queue_;
+        mutable std::vector<std::thread> io_threads_;
+        bool stopping_{false};
+    };
+}
@@ -6,6 +6,9 @@ set(MODULE_PUBLIC_HEADERS
         "${MODULE_PATH}/lua_system.hpp"
         "${MODULE_PATH}/details/lua_scripted_system.hpp"
         "${MODULE_PATH}/lua_helpers.hpp"
+        "${MODULE_PATH}/lua_lazy_binder.hpp"
+        "${MODULE_PATH}/lua_script_tracker.hpp"
+        "${MODULE_PATH}/lua_math.hpp"
         )
 
 set(MODULE_PRIVATE_HEADERS
@@ -4,10 +4,15 @@
 
 #pragma once
 
+#include <array>
+#include <string_view>
 #include <type_traits>
 #include <sol/state.hpp>
 #include <shiva/ecs/system.hpp>
+#include <shiva/event/all.hpp>
 #include <shiva/filesystem/filesystem.hpp>
+#include <shiva/lua/lua_lazy_binder.hpp>
+#include <shiva/lua/lua_script_tracker.hpp>
 #include <entt/core/utility.hpp>
 
 namespace shiva::ecs::details
@@ -24,6 +29,8 @@ namespace shiva::ecs::details
                                    shiva::entt::entity_registry &entity_registry,
                                    const float &fixed_delta_time,
                                    std::shared_ptr<sol::state> state,
+                                   std::shared_ptr<shiva::lua::lazy_binder> binder,
+                                   std::shared_ptr<const shiva::lua::script_tracker> tracker,
                                    std::string table_name,
                                    std::string class_name) noexcept;
 
@@ -37,6 +44,19 @@ namespace shiva::ecs::details
         //! Public member functions overriden
         inline void update() noexcept override;
 
+        //! Public member functions
+
+        /**
+         * \note This function resolves again the functions of the script table.
+         * \note Called automatically when the generation of the script tracker changes (after a hot reload).
+         */
+        inline void rebind_functions() noexcept;
+
+        /**
+         * \return the name of the lua table of the system.
+         */
+        inline const std::string &get_table_name() const noexcept;
+
         //! Reflection
         inline static const std::string &class_name() noexcept;
 
@@ -45,6 +65,10 @@ namespace shiva::ecs::details
         inline static constexpr auto reflected_members() noexcept;
 
     private:
+        //! Private typedefs
+        using events_list = shiva::event::common_events_list;
+        using events_handlers = std::array<sol::protected_function, meta::list::Length<events_list>::value>;
+
         //! Private member functions
         template <typename EventType>
         void register_common_event_() noexcept;
@@ -52,12 +76,28 @@ namespace shiva::ecs::details
         template <typename ... Types>
         void register_common_events_(meta::type_list<Types...>) noexcept;
 
+        template <typename ... Types>
+        void bind_events_handlers_(meta::type_list<Types...>) noexcept;
+
+        inline void refresh_functions_() noexcept;
+
+        inline sol::protected_function resolve_function_(const sol::table &table,
+                                                         const std::string &function) const noexcept;
+
         template <typename ... Args>
-        void safe_function_(const std::string &function, Args &&... args) noexcept;
+        void safe_function_(const sol::protected_function &function, std::string_view function_name,
+                            Args &&... args) noexcept;
 
         //! Private data members
         std::shared_ptr<sol::state> state_;
+        std::shared_ptr<shiva::lua::lazy_binder> binder_;
+        std::shared_ptr<const shiva::lua::script_tracker> tracker_;
+        unsigned int generation_{0u};
         std::string table_name_;
+        sol::protected_function update_;
+        sol::protected_function on_construct_;
+        sol::protected_function on_destruct_;
+        events_handlers events_handlers_;
         static inline std::string class_name_{""};
     };
 
@@ -73,22 +113,28 @@ namespace shiva::ecs::details
     lua_scripted_system<SystemType>::lua_scripted_system(shiva::entt::dispatcher &dispatcher,
                                                          shiva::entt::entity_registry &entity_registry,
                                                          const float &fixed_delta_time,
-                                                         std::shared_ptr<sol::state> state, std::string table_name,
+                                                         std::shared_ptr<sol::state> state,
+                                                         std::shared_ptr<shiva::lua::lazy_binder> binder,
+                                                         std::shared_ptr<const shiva::lua::script_tracker> tracker,
+                                                         std::string table_name,
                                                          std::string class_name) noexcept :
         TSystem::system(dispatcher, entity_registry, fixed_delta_time, class_name),
         state_(state),
+        binder_(std::move(binder)),
+        tracker_(std::move(tracker)),
         table_name_(std::move(table_name))
     {
-      register_common_events_(shiva::event::common_events_list{});
+      register_common_events_(events_list{});
       class_name_ = std::move(class_name);
-      safe_function_("on_construct");
+      rebind_functions();
+      safe_function_(on_construct_, "on_construct");
     }
 
     //! Destructor
     template <typename SystemType>
     lua_scripted_system<SystemType>::~lua_scripted_system() noexcept
     {
-      safe_function_("on_destruct");
+      safe_function_(on_destruct_, "on_destruct");
     }
 
     //! Callbacks
@@ -96,16 +142,46 @@ namespace shiva::ecs::details
     template <typename EventType>
     void lua_scripted_system<SystemType>::receive(const EventType &evt)
     {
-      using namespace std::string_literals;
+      static_assert(meta::list::Contains<events_list, EventType>::value,
+                    "EventType should be part of the common_events_list");
       this->log_->debug("event_type received: {}", EventType::class_name());
-      safe_function_("on_"s + EventType::class_name(), evt);
+      //! The event usertype must exist before the event is pushed to lua
+      binder_->bind(EventType::class_name());
+      refresh_functions_();
+      safe_function_(events_handlers_[meta::list::Position<events_list, EventType>::value],
+                     EventType::class_name(), evt);
     }
 
     //! Public member functions overriden
     template <typename SystemType>
     void lua_scripted_system<SystemType>::update() noexcept
     {
-      safe_function_("update");
+      refresh_functions_();
+      safe_function_(update_, "update");
+    }
+
+    //! Public member functions
+    template <typename SystemType>
+    void lua_scripted_system<SystemType>::rebind_functions() noexcept
+    {
+      generation_ = tracker_->get_generation();
+      sol::optional<sol::table> table = (*state_)[table_name_];
+      if (!table) {
+        this->log_->error("lua table {} doesn't exist, functions are not bound", table_name_);
+        update_ = on_construct_ = on_destruct_ = sol::protected_function{};
+        events_handlers_.fill(sol::protected_function{});
+        return;
+      }
+      update_ = resolve_function_(table.value(), "update");
+      on_construct_ = resolve_function_(table.value(), "on_construct");
+      on_destruct_ = resolve_function_(table.value(), "on_destruct");
+      bind_events_handlers_(events_list{});
+    }
+
+    template <typename SystemType>
+    const std::string &lua_scripted_system<SystemType>::get_table_name() const noexcept
+    {
+      return table_name_;
     }
 
     //! Reflection
@@ -144,18 +220,46 @@ namespace shiva::ecs::details
       (register_common_event_<Types>(), ...);
     }
 
+    template <typename SystemType>
+    template <typename... Types>
+    void lua_scripted_system<SystemType>::bind_events_handlers_(meta::type_list<Types...>) noexcept
+    {
+      using namespace std::string_literals;
+      sol::table table = (*state_)[table_name_];
+      ((events_handlers_[meta::list::Position<events_list, Types>::value] = resolve_function_(
+          table, "on_"s + Types::class_name())), ...);
+    }
+
+    template <typename SystemType>
+    void lua_scripted_system<SystemType>::refresh_functions_() noexcept
+    {
+      if (generation_ != tracker_->get_generation()) {
+        this->log_->info("scripts reloaded, rebind functions of {}", table_name_);
+        rebind_functions();
+      }
+    }
+
+    template <typename SystemType>
+    sol::protected_function lua_scripted_system<SystemType>::resolve_function_(const sol::table &table,
+                                                                                const std::string &function) const noexcept
+    {
+      sol::optional<sol::protected_function> f = table[function];
+      return f ? f.value() : sol::protected_function{};
+    }
+
     template <typename SystemType>
     template <typename... Args>
-    void lua_scripted_system<SystemType>::safe_function_(const std::string &function, Args &&... args) noexcept
+    void lua_scripted_system<SystemType>::safe_function_(const sol::protected_function &function,
+                                                         std::string_view function_name,
+                                                         Args &&... args) noexcept
     {
-      try {
-        sol::optional<sol::function> f = (*state_)[table_name_][function];
-        if (f && f.value() != sol::lua_nil) {
-          f.value()(std::forward<Args>(args)...);
-        }
+      if (!function.valid()) {
+        return;
       }
-      catch (const std::exception &error) {
-        this->log_->error("lua error: [function: {0}, err: {1}]", function, error.what());
+      sol::protected_function_result result = function(std::forward<Args>(args)...);
+      if (!result.valid()) {
+        sol::error error = result;
+        this->log_->error("lua error: [function: {0}, err: {1}]", function_name, error.what());
       }
     }
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <string>
 #if defined(fmt)
 #undef fmt
 #include <sol/state.hpp>
@@ -12,16 +13,22 @@
 #include <sol/state.hpp>
 #endif
 #include <shiva/spdlog/spdlog.hpp>
+#include <shiva/lua/lua_lazy_binder.hpp>
 
 namespace shiva::lua
 {
-    template <typename T>
-    void register_type(sol::state &state, shiva::logging::logger logger) noexcept
+    /**
+     * \note register the reflected type T as an usertype inside the given lua state.
+     * \param additional_args extra usertype parameters (metamethods for example), appended after the reflected ones
+     */
+    template <typename T, typename ...Args>
+    void register_type(sol::state &state, shiva::logging::logger logger, Args &&...additional_args) noexcept
     {
         const auto table = std::tuple_cat(
             std::make_tuple(T::class_name()),
             T::reflected_functions(),
-            T::reflected_members());
+            T::reflected_members(),
+            std::make_tuple(std::forward<Args>(additional_args)...));
 
         try {
             std::apply(
@@ -36,4 +43,39 @@ namespace shiva::lua
 
         logger->info("successfully registering type: {}", T::class_name());
     }
+
+    namespace details
+    {
+        inline constexpr const char lazy_binder_key[] = "shiva_lazy_binder";
+    }
+
+    //! \note share the lazy binder of the lua_system with the plugins using its state, see register_plugin_bindings
+    inline void set_lazy_binder(sol::state &state, lazy_binder *binder) noexcept
+    {
+        state.registry()[details::lazy_binder_key] = static_cast<void *>(binder);
+    }
+
+    /**
+     * \note register the bindings of a plugin (its usertype, its helpers and its instance), they are executed
+     * the first time shiva.<name> is read (by a script or by the engine). They are executed right away if the state
+     * has no lazy binder or if the plugin has already been bound (the plugin is reloaded).
+     * \param name key of the plugin in the shiva table, the binder must set shiva.<name>
+     * \return the pending bindings, the plugin keeps them until its destruction (they are removed with it)
+     */
+    [[nodiscard]] inline plugin_bindings
+    register_plugin_bindings(sol::state &state, std::string name, lazy_binder::binder_t binder) noexcept
+    {
+        sol::object object = state.registry()[details::lazy_binder_key];
+        if (object.get_type() != sol::type::lightuserdata) {
+            binder();
+            return {};
+        }
+        auto *lazy = static_cast<lazy_binder *>(object.as<void *>());
+        if (lazy->is_bound(name)) {
+            binder();
+            return {};
+        }
+        lazy->add(name, std::move(binder));
+        return plugin_bindings(lazy->weak_from_this(), std::move(name));
+    }
 }
@@ -0,0 +1,225 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace shiva::lua
+{
+    /**
+     * \note This class stores deferred lua bindings, indexed by the reflected class name of the bound type
+     * (or by the key of a plugin in the shiva table, see register_plugin_bindings).
+     * \note A binder is executed the first time a script touches the type, then it's forgotten.
+     * \class lazy_binder
+     */
+    class lazy_binder : public std::enable_shared_from_this<lazy_binder>
+    {
+    public:
+        //! Public typedefs
+        using binder_t = std::function<void()>;
+
+        //! Public member functions
+
+        /**
+         * \note register a deferred binding, do nothing if the type is already bound.
+         * \param name reflected class name of the type
+         * \param binder functor which register the type and his helpers inside the lua state
+         */
+        inline void add(std::string name, binder_t binder) noexcept;
+
+        /**
+         * \note forget the binder of the given type if it's still waiting, a bound type stays bound.
+         * \param name reflected class name of the type
+         */
+        inline void remove(const std::string &name) noexcept;
+
+        /**
+         * \note execute the binder of the given type if it's not already done.
+         * \param name reflected class name of the type
+         * \return true if the type is bound, false if the type is unknown
+         */
+        inline bool bind(const std::string &name) noexcept;
+
+        /**
+         * \return true if the type has been bound, false otherwise
+         */
+        inline bool is_bound(const std::string &name) const noexcept;
+
+        /**
+         * \return true if the type is waiting to be bound, false otherwise
+         */
+        inline bool is_pending(const std::string &name) const noexcept;
+
+        /**
+         * \return number of types that are still waiting to be bound
+         */
+        inline size_t nb_pending() const noexcept;
+
+    private:
+        //! Private data members
+        std::unordered_map<std::string, binder_t> pending_;
+        std::unordered_set<std::string> bound_;
+    };
+
+    /**
+     * \note This class removes the pending bindings of a plugin when it's destroyed, a plugin keeps it
+     * as long as its system lives: the binder lives in the shared library of the plugin, it must not outlive it.
+     * \note The lazy binder may be destroyed first (the lua_system is gone), it's then left untouched.
+     * \class plugin_bindings
+     */
+    class plugin_bindings
+    {
+    public:
+        //! Constructors
+        plugin_bindings() noexcept = default;
+
+        plugin_bindings(std::weak_ptr<lazy_binder> binder, std::string name) noexcept :
+            binder_(std::move(binder)), name_(std::move(name))
+        {
+        }
+
+        plugin_bindings(const plugin_bindings &) = delete;
+
+        plugin_bindings &operator=(const plugin_bindings &) = delete;
+
+        plugin_bindings(plugin_bindings &&other) noexcept = default;
+
+        plugin_bindings &operator=(plugin_bindings &&other) noexcept
+        {
+            reset();
+            binder_ = std::move(other.binder_);
+            name_ = std::move(other.name_);
+            return *this;
+        }
+
+        //! Destructor
+        ~plugin_bindings() noexcept
+        {
+            reset();
+        }
+
+        //! Public member functions
+        void reset() noexcept
+        {
+            if (auto binder = binder_.lock(); binder != nullptr) {
+                binder->remove(name_);
+            }
+            binder_.reset();
+        }
+
+    private:
+        //! Private data members
+        std::weak_ptr<lazy_binder> binder_;
+        std::string name_;
+    };
+
+    /**
+     * \note retrieve the component name from a key of the entity_registry table.
+     * \example get_transform_2d_component -> transform_2d, layer_1_id -> layer_1, get_texture_id -> ""
+     * \return the component name, an empty string_view if the key doesn't match a component helper.
+     */
+    inline std::string_view component_name_from_key(std::string_view key) noexcept;
+
+    /**
+     * \note retrieve the event name from a key of the dispatcher table.
+     * \example trigger_quit_game_event -> quit_game
+     * \return the event name, an empty string_view if the key doesn't match an event helper.
+     */
+    inline std::string_view event_name_from_key(std::string_view key) noexcept;
+}
+
+namespace shiva::lua
+{
+    namespace details
+    {
+        inline bool starts_with(std::string_view str, std::string_view prefix) noexcept
+        {
+            return str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0;
+        }
+
+        inline bool ends_with(std::string_view str, std::string_view suffix) noexcept
+        {
+            return str.size() >= suffix.size() &&
+                   str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+        }
+
+        inline std::string_view strip(std::string_view str, std::string_view prefix,
+                                      std::string_view suffix) noexcept
+        {
+            if (str.size() <= prefix.size() + suffix.size() ||
+                !starts_with(str, prefix) || !ends_with(str, suffix)) {
+                return {};
+            }
+            return str.substr(prefix.size(), str.size() - prefix.size() - suffix.size());
+        }
+    }
+
+    //! Public member functions
+    void lazy_binder::add(std::string name, lazy_binder::binder_t binder) noexcept
+    {
+        if (bound_.count(name) == 0u) {
+            pending_.insert_or_assign(std::move(name), std::move(binder));
+        }
+    }
+
+    void lazy_binder::remove(const std::string &name) noexcept
+    {
+        pending_.erase(name);
+    }
+
+    bool lazy_binder::bind(const std::string &name) noexcept
+    {
+        auto it = pending_.find(name);
+        if (it == pending_.end()) {
+            return is_bound(name);
+        }
+        //! The binder is moved out before being invoked, so a binder can safely trigger other bindings.
+        auto binder = std::move(it->second);
+        pending_.erase(it);
+        bound_.insert(name);
+        binder();
+        return true;
+    }
+
+    bool lazy_binder::is_bound(const std::string &name) const noexcept
+    {
+        return bound_.count(name) > 0u;
+    }
+
+    bool lazy_binder::is_pending(const std::string &name) const noexcept
+    {
+        return pending_.count(name) > 0u;
+    }
+
+    size_t lazy_binder::nb_pending() const noexcept
+    {
+        return pending_.size();
+    }
+
+    std::string_view component_name_from_key(std::string_view key) noexcept
+    {
+        using namespace std::string_view_literals;
+        constexpr std::string_view prefixes[] = {"for_each_entities_which_have_"sv, "get_"sv, "has_"sv, "add_"sv,
+                                                 "remove_"sv};
+        for (auto &&prefix : prefixes) {
+            if (details::starts_with(key, prefix)) {
+                //! a helper prefix needs the _component suffix, get_texture_id is not the id of a component
+                return details::strip(key, prefix, "_component"sv);
+            }
+        }
+        return details::strip(key, ""sv, "_id"sv);
+    }
+
+    std::string_view event_name_from_key(std::string_view key) noexcept
+    {
+        using namespace std::string_view_literals;
+        return details::strip(key, "trigger_"sv, "_event"sv);
+    }
+}
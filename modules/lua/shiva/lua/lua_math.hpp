@@ -0,0 +1,146 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <tuple>
+#include <stdexcept>
+#include <shiva/lua/lua_helpers.hpp>
+#include <shiva/math/math.hpp>
+
+namespace shiva::lua
+{
+    namespace details
+    {
+        template <typename T, typename ...Args>
+        void register_math_type(sol::table &math_table, Args &&...additional_args)
+        {
+            const auto table = std::tuple_cat(
+                std::make_tuple(T::class_name()),
+                T::reflected_functions(),
+                T::reflected_members(),
+                std::make_tuple(std::forward<Args>(additional_args)...));
+
+            std::apply([&math_table](auto &&...params) {
+                math_table.new_usertype<T>(std::forward<decltype(params)>(params)...);
+            }, table);
+        }
+    }
+
+    /**
+     * \note register the shiva.math types (vec2, rect, transform, vec2_array) inside the given lua state.
+     * \note the types are userdata values: each vec2 (rect, transform) created by a script is still an allocation.
+     * \note the hot loops use the functions on packed numbers instead (add, sub, scale, dot, length, distance,
+     * normalize, transform_point, vec2_array:get_xy/set_xy), they take and return plain numbers (multiple returns)
+     * and never allocate, vec2_array provides the batched (SIMD) operations.
+     * \note like the lua tables (and the tables returned by distances), vec2_array:get and vec2_array:set are 1-based.
+     * \return the math table, to be stored as shiva.math
+     */
+    inline sol::table register_math(sol::state &state, shiva::logging::logger logger) noexcept
+    {
+        using namespace shiva::math;
+        sol::table math_table = state.create_table();
+        try {
+            auto vec2_factories = sol::factories([]() { return vec2{}; },
+                                                 [](float x, float y) { return vec2{x, y}; });
+            details::register_math_type<vec2>(math_table,
+                                              sol::call_constructor, vec2_factories,
+                                              "new", vec2_factories,
+                                              sol::meta_function::addition, &vec2::operator+,
+                                              sol::meta_function::subtraction,
+                                              sol::resolve<vec2(const vec2 &) const>(&vec2::operator-),
+                                              sol::meta_function::unary_minus,
+                                              sol::resolve<vec2() const>(&vec2::operator-),
+                                              sol::meta_function::multiplication, &vec2::operator*,
+                                              sol::meta_function::division, &vec2::operator/,
+                                              sol::meta_function::equal_to, &vec2::operator==,
+                                              sol::meta_function::to_string, &vec2::to_string);
+
+            auto rect_factories = sol::factories([]() { return rect{}; },
+                                                 [](float left, float top, float width, float height) {
+                                                     return rect{left, top, width, height};
+                                                 });
+            details::register_math_type<rect>(math_table,
+                                              sol::call_constructor, rect_factories,
+                                              "new", rect_factories,
+                                              sol::meta_function::equal_to, &rect::operator==);
+
+            auto transform_factories = sol::factories([]() { return transform{}; },
+                                                      [](const vec2 &position, const vec2 &scale, float angle) {
+                                                          return transform{position, scale, angle};
+                                                      });
+            details::register_math_type<transform>(math_table,
+                                                   sol::call_constructor, transform_factories,
+                                                   "new", transform_factories);
+
+            auto array_constructors = sol::constructors<vec2_array(), vec2_array(size_t)>();
+            details::register_math_type<vec2_array>(math_table,
+                                                    sol::call_constructor, array_constructors,
+                                                    "new", array_constructors,
+                                                    "get", [](const vec2_array &self, size_t index) {
+                        if (index == 0u || index > self.size()) {
+                            throw std::out_of_range("vec2_array index out of range");
+                        }
+                        return self.get(index - 1u);
+                    },
+                                                    "set", [](vec2_array &self, size_t index, const vec2 &value) {
+                        if (index == 0u || index > self.size()) {
+                            throw std::out_of_range("vec2_array index out of range");
+                        }
+                        self.set(index - 1u, value);
+                    },
+                                                    "get_xy", [](const vec2_array &self, size_t index) {
+                        if (index == 0u || index > self.size()) {
+                            throw std::out_of_range("vec2_array index out of range");
+                        }
+                        const auto value = self.get(index - 1u);
+                        return std::make_tuple(value.x, value.y);
+                    },
+                                                    "set_xy", [](vec2_array &self, size_t index, float x, float y) {
+                        if (index == 0u || index > self.size()) {
+                            throw std::out_of_range("vec2_array index out of range");
+                        }
+                        self.set(index - 1u, vec2{x, y});
+                    },
+                                                    "distances", sol::overload(
+                    sol::resolve<std::vector<float>(const vec2 &) const>(&vec2_array::distances),
+                    sol::resolve<std::vector<float>(const vec2_array &) const>(&vec2_array::distances)),
+                                                    sol::meta_function::length, &vec2_array::size);
+
+            //! packed numbers, no userdata: local x, y = shiva.math.add(x1, y1, x2, y2)
+            math_table.set_function("add", [](float x1, float y1, float x2, float y2) {
+                return std::make_tuple(x1 + x2, y1 + y2);
+            });
+            math_table.set_function("sub", [](float x1, float y1, float x2, float y2) {
+                return std::make_tuple(x1 - x2, y1 - y2);
+            });
+            math_table.set_function("scale", [](float x, float y, float factor) {
+                return std::make_tuple(x * factor, y * factor);
+            });
+            math_table.set_function("dot", [](float x1, float y1, float x2, float y2) {
+                return vec2{x1, y1}.dot(vec2{x2, y2});
+            });
+            math_table.set_function("length", [](float x, float y) {
+                return vec2{x, y}.length();
+            });
+            math_table.set_function("distance", [](float x1, float y1, float x2, float y2) {
+                return vec2{x1, y1}.distance(vec2{x2, y2});
+            });
+            math_table.set_function("normalize", [](float x, float y) {
+                const auto normalized = vec2{x, y}.normalized();
+                return std::make_tuple(normalized.x, normalized.y);
+            });
+            math_table.set_function("transform_point", [](const transform &self, float x, float y) {
+                const auto point = self.apply(vec2{x, y});
+                return std::make_tuple(point.x, point.y);
+            });
+        }
+        catch (const std::exception &error) {
+            logger->error("error: {}", error.what());
+            return math_table;
+        }
+        logger->info("successfully registering shiva.math");
+        return math_table;
+    }
+}
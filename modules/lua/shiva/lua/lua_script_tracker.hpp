@@ -0,0 +1,177 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+#include <shiva/filesystem/filesystem.hpp>
+
+namespace shiva::lua
+{
+    /**
+     * \note This class keeps track of the scripts executed in a lua state and of the dependencies between them.
+     * \note A dependency is recorded each time a script calls load_script or require while being executed.
+     * \note The generation number is increased after each reload, holders of cached lua handles compare it
+     * to know if they need to resolve their handles again.
+     * \class script_tracker
+     */
+    class script_tracker
+    {
+    public:
+        //! Public member functions
+
+        /**
+         * \note mark the script as being executed, the script becomes a dependency of the script currently executed.
+         * \param script path of the script, normalized with the normalize function.
+         */
+        inline void enter(const std::string &script) noexcept;
+
+        /**
+         * \note mark the last entered script as executed.
+         */
+        inline void leave() noexcept;
+
+        /**
+         * \note forget the dependencies of the script, to be called before executing it (again):
+         * the modules it still requires are recorded again, the ones it no longer requires are pruned.
+         */
+        inline void forget_dependencies(const std::string &script) noexcept;
+
+        /**
+         * \note remember that this script is a lua module, loaded through require(module_name).
+         */
+        inline void set_module_name(const std::string &script, std::string module_name) noexcept;
+
+        /**
+         * \return the module name of the script, nullptr if the script was not loaded through require.
+         */
+        inline const std::string *get_module_name(const std::string &script) const noexcept;
+
+        /**
+         * \return true if the script has already been executed in the lua state, false otherwise
+         */
+        inline bool is_tracked(const std::string &script) const noexcept;
+
+        /**
+         * \return the modified script followed by all the scripts that depend on it (directly or not),
+         * each script appears after its dependencies. An empty array is returned for an unknown script.
+         */
+        inline std::vector<std::string> reload_order(const std::string &modified_script) const noexcept;
+
+        /**
+         * \note invalidate every cached handle, see get_generation
+         */
+        inline void invalidate() noexcept;
+
+        inline unsigned int get_generation() const noexcept;
+
+        //! Public static functions
+        static inline std::string normalize(const shiva::fs::path &script) noexcept;
+
+    private:
+        //! Private member functions
+        inline void visit_(const std::string &script, std::unordered_set<std::string> &visited,
+                           std::vector<std::string> &order) const noexcept;
+
+        //! Private data members
+        std::vector<std::string> loading_stack_;
+        std::unordered_set<std::string> scripts_;
+        std::unordered_map<std::string, std::unordered_set<std::string>> dependents_;
+        std::unordered_map<std::string, std::string> modules_;
+        unsigned int generation_{0u};
+    };
+}
+
+namespace shiva::lua
+{
+    //! Public member functions
+    void script_tracker::enter(const std::string &script) noexcept
+    {
+        if (!loading_stack_.empty() && loading_stack_.back() != script) {
+            dependents_[script].insert(loading_stack_.back());
+        }
+        scripts_.insert(script);
+        loading_stack_.push_back(script);
+    }
+
+    void script_tracker::leave() noexcept
+    {
+        if (!loading_stack_.empty()) {
+            loading_stack_.pop_back();
+        }
+    }
+
+    void script_tracker::forget_dependencies(const std::string &script) noexcept
+    {
+        for (auto it = dependents_.begin(); it != dependents_.end();) {
+            it->second.erase(script);
+            it = it->second.empty() ? dependents_.erase(it) : std::next(it);
+        }
+    }
+
+    void script_tracker::set_module_name(const std::string &script, std::string module_name) noexcept
+    {
+        modules_.insert_or_assign(script, std::move(module_name));
+    }
+
+    const std::string *script_tracker::get_module_name(const std::string &script) const noexcept
+    {
+        auto it = modules_.find(script);
+        return it != modules_.end() ? &it->second : nullptr;
+    }
+
+    bool script_tracker::is_tracked(const std::string &script) const noexcept
+    {
+        return scripts_.count(script) > 0u;
+    }
+
+    std::vector<std::string> script_tracker::reload_order(const std::string &modified_script) const noexcept
+    {
+        std::vector<std::string> order;
+        if (!is_tracked(modified_script)) {
+            return order;
+        }
+        std::unordered_set<std::string> visited;
+        visit_(modified_script, visited, order);
+        //! post-order of the dependents graph, reversed: dependencies first.
+        return std::vector<std::string>(order.rbegin(), order.rend());
+    }
+
+    void script_tracker::invalidate() noexcept
+    {
+        ++generation_;
+    }
+
+    unsigned int script_tracker::get_generation() const noexcept
+    {
+        return generation_;
+    }
+
+    //! Public static functions
+    std::string script_tracker::normalize(const shiva::fs::path &script) noexcept
+    {
+        std::error_code ec;
+        auto canonical_path = shiva::fs::canonical(script, ec);
+        return ec ? shiva::fs::absolute(script).string() : canonical_path.string();
+    }
+
+    //! Private member functions
+    void script_tracker::visit_(const std::string &script, std::unordered_set<std::string> &visited,
+                                std::vector<std::string> &order) const noexcept
+    {
+        if (!visited.insert(script).second) {
+            return;
+        }
+        if (auto it = dependents_.find(script); it != dependents_.end()) {
+            for (auto &&dependent : it->second) {
+                visit_(dependent, visited, order);
+            }
+        }
+        order.push_back(script);
+    }
+}
@@ -10,11 +10,19 @@
 #else
 #include <sol/state.hpp>
 #endif
+#include <chrono>
+#include <memory>
+#include <unordered_map>
 #include <shiva/filesystem/filesystem.hpp>
+#include <shiva/filesystem/file_watcher.hpp>
+#include <shiva/filesystem/vfs.hpp>
 #include <shiva/ecs/system.hpp>
 #include <shiva/event/add_base_system.hpp>
 #include <shiva/input/input.hpp>
 #include <shiva/lua/lua_helpers.hpp>
+#include <shiva/lua/lua_lazy_binder.hpp>
+#include <shiva/lua/lua_math.hpp>
+#include <shiva/lua/lua_script_tracker.hpp>
 #include <shiva/lua/details/lua_scripted_system.hpp>
 
 namespace sol
@@ -47,6 +55,11 @@ namespace shiva::scripting
 
         inline void register_world_() noexcept;
 
+        inline void register_require_() noexcept;
+
+        inline sol::object lazy_index_(const std::string &table_name, const std::string &key,
+                                       std::string_view type_name, sol::this_state state) noexcept;
+
     public:
         //! Constructors
         inline lua_system(entt::dispatcher &dispatcher,
@@ -61,6 +74,23 @@ namespace shiva::scripting
 
         inline bool load_script(const std::string &file_name) noexcept;
 
+        /**
+         * \note Execute again the script and every script that depends on it (through load_script or require).
+         * \note The cached functions handles of the scripted systems and the scripted entities are rebound.
+         * \param script path of the modified script
+         * \return false if the script was never loaded or if one of the scripts failed, true otherwise.
+         */
+        inline bool reload_script(const shiva::fs::path &script) noexcept;
+
+        /**
+         * \note Watch the scripts directory and reload the modified scripts during update.
+         * \param scripts_root directory to watch, assets/scripts by default.
+         */
+        inline void enable_hot_reload(shiva::fs::path scripts_root = shiva::fs::current_path() /
+                                                                     "assets/scripts") noexcept;
+
+        inline void disable_hot_reload() noexcept;
+
         inline bool load_script_from_entities() noexcept;
 
         template <typename ...Types>
@@ -74,6 +104,10 @@ namespace shiva::scripting
 
         inline sol::state &get_state() noexcept;
 
+        inline const shiva::lua::lazy_binder &get_binder() const noexcept;
+
+        inline const shiva::lua::script_tracker &get_script_tracker() const noexcept;
+
         //! Reflection
         reflect_class(lua_system)
 
@@ -96,7 +130,22 @@ namespace shiva::scripting
             }
         }
 
+        inline bool execute_script_(const shiva::fs::path &script) noexcept;
+
+        inline const sol::protected_function &entity_update_function_(const std::string &table_name) noexcept;
+
+        inline void poll_scripts_() noexcept;
+
         std::shared_ptr<sol::state> state_{std::make_shared<sol::state>()};
+        std::shared_ptr<shiva::lua::lazy_binder> binder_{std::make_shared<shiva::lua::lazy_binder>()};
+        std::shared_ptr<shiva::lua::script_tracker> tracker_{std::make_shared<shiva::lua::script_tracker>()};
+        std::unordered_map<std::string, sol::protected_function> entities_update_functions_;
+        sol::protected_function no_update_function_;
+        unsigned int entities_generation_{0u};
+        std::shared_ptr<shiva::filesystem::vfs> vfs_{shiva::filesystem::vfs::shared()};
+        std::unique_ptr<shiva::filesystem::file_watcher> watcher_{nullptr};
+        std::chrono::steady_clock::time_point last_poll_{std::chrono::steady_clock::now()};
+        static constexpr std::chrono::milliseconds hot_reload_interval_{250};
         shiva::fs::path script_directory_;
         shiva::fs::path systems_scripts_directory_;
     };
@@ -166,7 +215,12 @@ namespace shiva::scripting
 
     void lua_system::register_entity_registry_() noexcept
     {
-        shiva::lua::register_type<shiva::entt::entity_registry>(*state_, log_);
+        //! Components helpers are bound the first time a script asks for them, see register_components_
+        shiva::lua::register_type<shiva::entt::entity_registry>(*state_, log_, sol::meta_function::index, [this](
+            [[maybe_unused]] shiva::entt::entity_registry &self, const std::string &key, sol::this_state state) {
+            return this->lazy_index_(entity_registry_.class_name(), key, shiva::lua::component_name_from_key(key),
+                                     state);
+        });
         using comp_type = shiva::entt::entity_registry::component_type;
         (*state_)[entity_registry_.class_name()]["for_each_runtime"] = [](shiva::entt::entity_registry &self,
                                                                           std::vector<comp_type> array,
@@ -184,15 +238,19 @@ namespace shiva::scripting
     template <typename... Types>
     void lua_system::register_components_(meta::type_list<Types...>) noexcept
     {
-        (shiva::lua::register_type<Types>(*state_, log_), ...);
-        (register_component_<Types>(), ...);
+        (binder_->add(Types::class_name(), [this]() {
+            shiva::lua::register_type<Types>(*state_, log_);
+            register_component_<Types>();
+        }), ...);
     }
 
     template <typename... Types>
     void lua_system::register_events_(meta::type_list<Types...>) noexcept
     {
-        (shiva::lua::register_type<Types>(*state_, log_), ...);
-        (register_event_<Types>(), ...);
+        (binder_->add(Types::class_name(), [this]() {
+            shiva::lua::register_type<Types>(*state_, log_);
+            register_event_<Types>();
+        }), ...);
     }
 
     void lua_system::register_world_() noexcept
@@ -207,9 +265,123 @@ namespace shiva::scripting
             }
             return entity_id;
         };
-        (*state_)["shiva"] = state_->create_table_with("entity_registry", std::ref(entity_registry_),
-                                                       "dispatcher", std::ref(dispatcher_),
-                                                       "fixed_delta_time", fixed_delta_time_);
+        sol::table shiva_table = state_->create_table_with("entity_registry", std::ref(entity_registry_),
+                                                           "dispatcher", std::ref(dispatcher_),
+                                                           "fixed_delta_time", fixed_delta_time_);
+        shiva_table["math"] = shiva::lua::register_math(*state_, log_);
+
+        //! shiva.transform_2d for example bind the type on the fly and return the usertype.
+        shiva_table[sol::metatable_key] = state_->create_table_with("__index", [this](
+            [[maybe_unused]] sol::table self, const std::string &key, sol::this_state state) {
+            return this->lazy_index_("", key, key, state);
+        });
+        (*state_)["shiva"] = shiva_table;
+    }
+
+    sol::object lua_system::lazy_index_(const std::string &table_name, const std::string &key,
+                                        std::string_view type_name, sol::this_state state) noexcept
+    {
+        if (type_name.empty() || !binder_->bind(std::string(type_name))) {
+            return sol::make_object(state, sol::lua_nil);
+        }
+        log_->debug("lazy binding of {0} through key: {1}", type_name, key);
+        if (table_name.empty()) {
+            //! the plugins set their instance in the shiva table (shiva.render), the types are globals
+            sol::table shiva_table = (*state_)["shiva"];
+            sol::object object = shiva_table.raw_get<sol::object>(key);
+            if (object.get_type() == sol::type::lua_nil) {
+                object = (*state_)[key];
+            }
+            return object;
+        }
+        sol::object object = (*state_)[table_name][key];
+        return object;
+    }
+
+    void lua_system::register_require_() noexcept
+    {
+        //! require is wrapped to know which script requires which module, needed by reload_script.
+        sol::protected_function original_require = (*state_)["require"];
+        (*state_)["require"] = [this, original_require](const std::string &module_name) -> sol::object {
+            sol::protected_function search_path = (*state_)["package"]["searchpath"];
+            std::string package_path = (*state_)["package"]["path"];
+            sol::optional<std::string> module_path = search_path(module_name, package_path).get<sol::optional<std::string>>();
+            std::string script;
+            if (module_path) {
+                script = shiva::lua::script_tracker::normalize(module_path.value());
+                tracker_->set_module_name(script, module_name);
+                //! the module is executed only if it is not already loaded, its requires are recorded again
+                sol::object loaded = (*state_)["package"]["loaded"][module_name];
+                if (loaded.get_type() == sol::type::lua_nil) {
+                    tracker_->forget_dependencies(script);
+                }
+                tracker_->enter(script);
+            }
+            sol::protected_function_result result = original_require(module_name);
+            if (module_path) {
+                tracker_->leave();
+            }
+            if (!result.valid()) {
+                sol::error error = result;
+                throw error;
+            }
+            return result.get<sol::object>();
+        };
+    }
+
+    //! \note the script is read through the vfs (loose file, archive or overlay), the chunk keeps the path of the file
+    bool lua_system::execute_script_(const shiva::fs::path &script) noexcept
+    {
+        const auto path = vfs_->virtual_path(script);
+        auto buffer = vfs_->read(path);
+        if (!buffer) {
+            log_->error("error when loading script {0}: unable to read {1}", script.string(), path);
+            return false;
+        }
+        const auto tracked_script = shiva::lua::script_tracker::normalize(script);
+        tracker_->forget_dependencies(tracked_script);
+        tracker_->enter(tracked_script);
+        sol::protected_function_result result = state_->safe_script(buffer->view(), sol::script_pass_on_error,
+                                                                    "@" + script.string());
+        tracker_->leave();
+        if (!result.valid()) {
+            sol::error error = result;
+            log_->error("error when loading script {0}: {1}", script.string(), error.what());
+            return false;
+        }
+        return true;
+    }
+
+    const sol::protected_function &lua_system::entity_update_function_(const std::string &table_name) noexcept
+    {
+        if (auto it = entities_update_functions_.find(table_name); it != entities_update_functions_.end()) {
+            return it->second;
+        }
+        //! a miss is not cached, the table can be defined by a script loaded later
+        sol::optional<sol::table> table = (*state_)[table_name];
+        if (!table) {
+            return no_update_function_;
+        }
+        sol::optional<sol::protected_function> function = table.value()["on_update"];
+        if (!function) {
+            return no_update_function_;
+        }
+        return entities_update_functions_.emplace(table_name, function.value()).first->second;
+    }
+
+    void lua_system::poll_scripts_() noexcept
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_poll_ < hot_reload_interval_) {
+            return;
+        }
+        last_poll_ = now;
+        watcher_->poll([this](const shiva::fs::path &script) {
+            if (tracker_->is_tracked(shiva::lua::script_tracker::normalize(script))) {
+                log_->info("script modified: {}", script.string());
+                this->reload_script(script);
+            }
+        });
     }
 
     //! Constructors
@@ -221,6 +393,7 @@ namespace shiva::scripting
         systems_scripts_directory_(std::move(systems_scripts_directory))
     {
         state_->open_libraries();
+        register_require_();
         state_->new_enum<shiva::ecs::system_type>("system_type",
                                                   {
                                                       {"pre_update",   shiva::ecs::system_type::pre_update},
@@ -237,22 +410,28 @@ namespace shiva::scripting
         };
         register_entity_registry_();
         register_components_(shiva::ecs::common_components{});
-        this->state_->new_usertype<shiva::entt::dispatcher>("dispatcher");
+        this->state_->new_usertype<shiva::entt::dispatcher>("dispatcher", sol::meta_function::index, [this](
+            [[maybe_unused]] shiva::entt::dispatcher &self, const std::string &key, sol::this_state state) {
+            return this->lazy_index_("dispatcher", key, shiva::lua::event_name_from_key(key), state);
+        });
         register_events_(shiva::event::common_events_list{});
         register_world_();
+        shiva::lua::set_lazy_binder(*state_, binder_.get());
+        (*state_)["reload_script"] = [this](std::string path) {
+            return this->reload_script(fs::path(std::move(path)));
+        };
+#if defined(DEBUG)
+        enable_hot_reload();
+#endif
     }
 
     //! Public member functions
     bool lua_system::load_script(const std::string &file_name, const fs::path &script_directory) noexcept
     {
-        try {
-            state_->script_file((script_directory / fs::path(file_name)).string());
-            log_->info("successfully register script: {}", file_name);
-        } catch (const std::exception &e) {
-            log_->error("error when loading script {0}: {1}\n script_directory {2}", file_name,
-                        e.what(), script_directory.string());
+        if (!execute_script_(script_directory / fs::path(file_name))) {
             return false;
         }
+        log_->info("successfully register script: {}", file_name);
         return true;
     }
 
@@ -261,6 +440,55 @@ namespace shiva::scripting
         return load_script(file_name, script_directory_);
     }
 
+    bool lua_system::reload_script(const shiva::fs::path &script) noexcept
+    {
+        auto scripts = tracker_->reload_order(shiva::lua::script_tracker::normalize(script));
+        if (scripts.empty()) {
+            log_->warn("script {} was never loaded, cannot reload it", script.string());
+            return false;
+        }
+
+        //! Every module of the chain must be evicted before re-executing anything, otherwise require hits the cache.
+        for (auto &&current : scripts) {
+            if (auto module_name = tracker_->get_module_name(current); module_name != nullptr) {
+                (*state_)["package"]["loaded"][*module_name] = sol::lua_nil;
+            }
+        }
+
+        bool res = true;
+        for (auto &&current : scripts) {
+            if (auto module_name = tracker_->get_module_name(current); module_name != nullptr) {
+                sol::protected_function require = (*state_)["require"];
+                sol::protected_function_result result = require(*module_name);
+                if (!result.valid()) {
+                    sol::error error = result;
+                    log_->error("error when reloading module {0}: {1}", *module_name, error.what());
+                    res = false;
+                }
+            } else {
+                res &= execute_script_(current);
+            }
+        }
+        log_->info("{0} script(s) reloaded from {1}", scripts.size(), script.string());
+
+        tracker_->invalidate();
+        return res;
+    }
+
+    void lua_system::enable_hot_reload(shiva::fs::path scripts_root) noexcept
+    {
+        watcher_ = std::make_unique<shiva::filesystem::file_watcher>(std::move(scripts_root));
+        if (!watcher_->is_valid()) {
+            log_->warn("cannot watch {}, hot reload disabled", watcher_->get_root().string());
+            watcher_ = nullptr;
+        }
+    }
+
+    void lua_system::disable_hot_reload() noexcept
+    {
+        watcher_ = nullptr;
+    }
+
     template <typename... Types>
     void lua_system::register_types_list(meta::type_list<Types...>) noexcept
     {
@@ -269,9 +497,26 @@ namespace shiva::scripting
 
     void lua_system::update() noexcept
     {
+        if (watcher_ != nullptr) {
+            poll_scripts_();
+        }
+        //! Handles are dropped here rather than in reload_script, which can be called from an on_update.
+        if (entities_generation_ != tracker_->get_generation()) {
+            entities_update_functions_.clear();
+            entities_generation_ = tracker_->get_generation();
+        }
         this->entity_registry_.view<shiva::ecs::lua_script>().each([this](auto entity_id,
                                                                           auto &&comp) {
-            execute_safe_function_(comp.table_name, "on_update", entity_id);
+            const auto &function = entity_update_function_(comp.table_name);
+            if (!function.valid()) {
+                return;
+            }
+            sol::protected_function_result result = function(entity_id);
+            if (!result.valid()) {
+                sol::error error = result;
+                this->log_->error("lua error: [table: {0}, function: on_update, err: {1}]", comp.table_name,
+                                  error.what());
+            }
         });
     }
 
@@ -301,7 +546,7 @@ namespace shiva::scripting
             case shiva::ecs::post_update:
                 dispatcher_.trigger<shiva::event::add_base_system>(
                     std::make_unique<shiva::ecs::details::lua_post_scripted_system>(dispatcher_, entity_registry_,
-                                                                                    fixed_delta_time_, state_,
+                                                                                    fixed_delta_time_, state_, binder_, tracker_,
                                                                                     table_name,
                                                                                     script_name.filename().stem().string()),
                     prioritize, system_to_swap);
@@ -309,7 +554,7 @@ namespace shiva::scripting
             case shiva::ecs::pre_update:
                 dispatcher_.trigger<shiva::event::add_base_system>(
                     std::make_unique<shiva::ecs::details::lua_pre_scripted_system>(dispatcher_, entity_registry_,
-                                                                                   fixed_delta_time_, state_,
+                                                                                   fixed_delta_time_, state_, binder_, tracker_,
                                                                                    table_name,
                                                                                    script_name.filename().stem().string()),
                     prioritize, system_to_swap);
@@ -317,7 +562,7 @@ namespace shiva::scripting
             case shiva::ecs::logic_update:
                 dispatcher_.trigger<shiva::event::add_base_system>(
                     std::make_unique<shiva::ecs::details::lua_logic_scripted_system>(dispatcher_, entity_registry_,
-                                                                                     fixed_delta_time_, state_,
+                                                                                     fixed_delta_time_, state_, binder_, tracker_,
                                                                                      table_name,
                                                                                      script_name.filename().stem().string()),
                     prioritize, system_to_swap);
@@ -333,19 +578,19 @@ namespace shiva::scripting
     inline bool lua_system::load_all_scripted_systems() noexcept
     {
         bool res = true;
-        if (!shiva::fs::exists(systems_scripts_directory_)) {
+        const auto directory = vfs_->mount_path(systems_scripts_directory_);
+        if (!vfs_->is_directory(directory)) {
             this->log_->warn("{0} directory doesn't exist cannot load scripted systems",
                              systems_scripts_directory_.string());
             return false;
         }
-        fs::recursive_directory_iterator endit;
-        for (fs::recursive_directory_iterator it(systems_scripts_directory_); it != endit; ++it) {
-            if (!fs::is_regular_file(*it)) {
-                continue;
-            }
-            log_->info("path -> {}", it->path().string());
-            res &= create_scripted_system(it->path());
-        }
+        //! the scripts are listed by the vfs (loose files, archives and overlays), they are read back through it.
+        vfs_->for_each_file(directory, [this, &res, &directory](const std::string &path) {
+            const auto relative = directory.empty() ? path : path.substr(directory.size() + 1u);
+            const auto script = systems_scripts_directory_ / shiva::fs::path(relative);
+            log_->info("path -> {}", script.string());
+            res &= create_scripted_system(script);
+        });
         return res;
     }
 
@@ -354,6 +599,16 @@ namespace shiva::scripting
         return *state_;
     }
 
+    const shiva::lua::lazy_binder &lua_system::get_binder() const noexcept
+    {
+        return *binder_;
+    }
+
+    const shiva::lua::script_tracker &lua_system::get_script_tracker() const noexcept
+    {
+        return *tracker_;
+    }
+
     constexpr auto lua_system::reflected_functions() noexcept
     {
         return meta::makeMap(reflect_function(&lua_system::update));
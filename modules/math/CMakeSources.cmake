@@ -0,0 +1,18 @@
+set(MODULE_PATH
+        ${CMAKE_CURRENT_SOURCE_DIR}/shiva/math)
+
+set(MODULE_PUBLIC_HEADERS
+        "${MODULE_PATH}/math.hpp"
+        "${MODULE_PATH}/vec2.hpp"
+        "${MODULE_PATH}/rect.hpp"
+        "${MODULE_PATH}/transform.hpp"
+        "${MODULE_PATH}/vec2_array.hpp"
+        "${MODULE_PATH}/rect_packer.hpp"
+        )
+
+set(MODULE_PRIVATE_HEADERS
+        "")
+
+set(MODULE_SOURCES
+        ${MODULE_PUBLIC_HEADERS}
+        ${MODULE_PRIVATE_HEADERS})
@@ -0,0 +1,17 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <shiva/meta/list.hpp>
+#include <shiva/math/vec2.hpp>
+#include <shiva/math/rect.hpp>
+#include <shiva/math/transform.hpp>
+#include <shiva/math/vec2_array.hpp>
+#include <shiva/math/rect_packer.hpp>
+
+namespace shiva::math
+{
+    using math_types_list = meta::type_list<vec2, rect, transform, vec2_array>;
+}
@@ -0,0 +1,92 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <shiva/math/vec2.hpp>
+
+namespace shiva::math
+{
+    /**
+     * \note Axis aligned rectangle, same layout as sf::FloatRect (left, top, width, height).
+     */
+    struct rect
+    {
+        //! Public member functions
+        constexpr bool contains(const vec2 &point) const noexcept
+        {
+            return point.x >= left && point.x < left + width && point.y >= top && point.y < top + height;
+        }
+
+        constexpr bool intersects(const rect &other) const noexcept
+        {
+            return left < other.left + other.width && other.left < left + width &&
+                   top < other.top + other.height && other.top < top + height;
+        }
+
+        /**
+         * \return the overlapping area of the two rectangles, an empty rectangle if they don't intersect.
+         */
+        constexpr rect intersection(const rect &other) const noexcept
+        {
+            if (!intersects(other)) {
+                return rect{};
+            }
+            const float new_left = std::max(left, other.left);
+            const float new_top = std::max(top, other.top);
+            return rect{new_left, new_top,
+                        std::min(left + width, other.left + other.width) - new_left,
+                        std::min(top + height, other.top + other.height) - new_top};
+        }
+
+        constexpr vec2 position() const noexcept
+        {
+            return {left, top};
+        }
+
+        constexpr vec2 size() const noexcept
+        {
+            return {width, height};
+        }
+
+        constexpr vec2 center() const noexcept
+        {
+            return {left + width * 0.5f, top + height * 0.5f};
+        }
+
+        //! Operators
+        constexpr bool operator==(const rect &other) const noexcept
+        {
+            return left == other.left && top == other.top && width == other.width && height == other.height;
+        }
+
+        //! Reflection
+        reflect_class(rect)
+
+        static constexpr auto reflected_functions() noexcept
+        {
+            return meta::makeMap(reflect_function(&rect::contains),
+                                 reflect_function(&rect::intersects),
+                                 reflect_function(&rect::intersection),
+                                 reflect_function(&rect::position),
+                                 reflect_function(&rect::size),
+                                 reflect_function(&rect::center));
+        }
+
+        static constexpr auto reflected_members() noexcept
+        {
+            return meta::makeMap(reflect_member(&rect::left),
+                                 reflect_member(&rect::top),
+                                 reflect_member(&rect::width),
+                                 reflect_member(&rect::height));
+        }
+
+        //! Public data members
+        float left{0.0f};
+        float top{0.0f};
+        float width{0.0f};
+        float height{0.0f};
+    };
+}
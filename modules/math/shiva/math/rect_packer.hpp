@@ -0,0 +1,148 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <limits>
+#include <vector>
+#include <optional>
+#include <algorithm>
+
+namespace shiva::math
+{
+    /**
+     * \note Position of a rectangle packed by the rect_packer, in pixels.
+     */
+    struct packed_rect
+    {
+        unsigned int x{0u};
+        unsigned int y{0u};
+        unsigned int width{0u};
+        unsigned int height{0u};
+    };
+
+    /**
+     * \note This class packs rectangles in a fixed size bin (skyline bottom-left algorithm).
+     * \note Insert the rectangles sorted by decreasing height for a better occupancy.
+     * \class rect_packer
+     */
+    class rect_packer
+    {
+    public:
+        //! Constructors
+        rect_packer(unsigned int width, unsigned int height) noexcept : width_(width), height_(height)
+        {
+            skyline_.push_back(node{0u, 0u, width});
+        }
+
+        //! Public member functions
+
+        /**
+         * \return the position of the rectangle, std::nullopt if there is not enough space left in the bin.
+         */
+        std::optional<packed_rect> insert(unsigned int width, unsigned int height) noexcept
+        {
+            if (width == 0u || height == 0u || width > width_ || height > height_) {
+                return std::nullopt;
+            }
+            size_t best_idx = skyline_.size();
+            unsigned int best_y = std::numeric_limits<unsigned int>::max();
+            unsigned int best_width = std::numeric_limits<unsigned int>::max();
+            for (size_t idx = 0u; idx < skyline_.size(); ++idx) {
+                if (auto y = fit_(idx, width, height); y && (*y < best_y || (*y == best_y &&
+                                                                                skyline_[idx].width < best_width))) {
+                    best_idx = idx;
+                    best_y = *y;
+                    best_width = skyline_[idx].width;
+                }
+            }
+            if (best_idx == skyline_.size()) {
+                return std::nullopt;
+            }
+            const packed_rect res{skyline_[best_idx].x, best_y, width, height};
+            add_level_(best_idx, res);
+            used_area_ += static_cast<unsigned long long>(width) * height;
+            return res;
+        }
+
+        //! \return ratio of the used area of the bin [0, 1]
+        float occupancy() const noexcept
+        {
+            return static_cast<float>(used_area_) / (static_cast<float>(width_) * height_);
+        }
+
+        unsigned int width() const noexcept
+        {
+            return width_;
+        }
+
+        unsigned int height() const noexcept
+        {
+            return height_;
+        }
+
+    private:
+        //! Private typedefs
+        struct node
+        {
+            unsigned int x;
+            unsigned int y;
+            unsigned int width;
+        };
+
+        //! Private member functions
+
+        //! \return the y position of a rectangle placed at the start of the node idx, std::nullopt if it doesn't fit
+        std::optional<unsigned int> fit_(size_t idx, unsigned int width, unsigned int height) const noexcept
+        {
+            const unsigned int x = skyline_[idx].x;
+            if (x + width > width_) {
+                return std::nullopt;
+            }
+            unsigned int y = 0u;
+            for (unsigned int width_left = width; width_left > 0u; ++idx) {
+                y = std::max(y, skyline_[idx].y);
+                if (y + height > height_) {
+                    return std::nullopt;
+                }
+                width_left -= std::min(width_left, skyline_[idx].width);
+            }
+            return y;
+        }
+
+        void add_level_(size_t idx, const packed_rect &rect) noexcept
+        {
+            skyline_.insert(skyline_.begin() + idx, node{rect.x, rect.y + rect.height, rect.width});
+            const unsigned int right = rect.x + rect.width;
+            for (size_t next = idx + 1u; next < skyline_.size();) {
+                auto &current = skyline_[next];
+                if (current.x >= right) {
+                    break;
+                }
+                const unsigned int shrink = std::min(current.width, right - current.x);
+                current.x += shrink;
+                current.width -= shrink;
+                if (current.width == 0u) {
+                    skyline_.erase(skyline_.begin() + next);
+                } else {
+                    break;
+                }
+            }
+            for (size_t next = 0u; next + 1u < skyline_.size();) {
+                if (skyline_[next].y == skyline_[next + 1u].y) {
+                    skyline_[next].width += skyline_[next + 1u].width;
+                    skyline_.erase(skyline_.begin() + next + 1u);
+                } else {
+                    ++next;
+                }
+            }
+        }
+
+        //! Private data members
+        unsigned int width_;
+        unsigned int height_;
+        unsigned long long used_area_{0u};
+        std::vector<node> skyline_;
+    };
+}
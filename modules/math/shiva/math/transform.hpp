@@ -0,0 +1,90 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <cmath>
+#include <shiva/math/rect.hpp>
+
+namespace shiva::math
+{
+    /**
+     * \note Position, scale and rotation (in degrees, like SFML and transform_2d) of a 2D object.
+     * \note The scale is applied first, then the rotation, then the translation.
+     */
+    struct transform
+    {
+        //! Public member functions
+        vec2 apply(const vec2 &point) const noexcept
+        {
+            constexpr float deg_to_rad = 3.14159265358979323846f / 180.0f;
+            const float cos_angle = std::cos(angle * deg_to_rad);
+            const float sin_angle = std::sin(angle * deg_to_rad);
+            const vec2 scaled{point.x * scale.x, point.y * scale.y};
+            return vec2{scaled.x * cos_angle - scaled.y * sin_angle + position.x,
+                        scaled.x * sin_angle + scaled.y * cos_angle + position.y};
+        }
+
+        /**
+         * \return the bounding box of the transformed rectangle.
+         */
+        rect apply(const rect &area) const noexcept
+        {
+            const vec2 corners[] = {apply(vec2{area.left, area.top}),
+                                    apply(vec2{area.left + area.width, area.top}),
+                                    apply(vec2{area.left, area.top + area.height}),
+                                    apply(vec2{area.left + area.width, area.top + area.height})};
+            vec2 min_corner = corners[0];
+            vec2 max_corner = corners[0];
+            for (auto &&corner : corners) {
+                min_corner = {std::min(min_corner.x, corner.x), std::min(min_corner.y, corner.y)};
+                max_corner = {std::max(max_corner.x, corner.x), std::max(max_corner.y, corner.y)};
+            }
+            return rect{min_corner.x, min_corner.y, max_corner.x - min_corner.x, max_corner.y - min_corner.y};
+        }
+
+        vec2 apply_point(const vec2 &point) const noexcept
+        {
+            return apply(point);
+        }
+
+        rect apply_rect(const rect &area) const noexcept
+        {
+            return apply(area);
+        }
+
+        constexpr void translate(const vec2 &offset) noexcept
+        {
+            position += offset;
+        }
+
+        constexpr void rotate(float degrees) noexcept
+        {
+            angle += degrees;
+        }
+
+        //! Reflection
+        reflect_class(transform)
+
+        static constexpr auto reflected_functions() noexcept
+        {
+            return meta::makeMap(reflect_function(&transform::apply_point),
+                                 reflect_function(&transform::apply_rect),
+                                 reflect_function(&transform::translate),
+                                 reflect_function(&transform::rotate));
+        }
+
+        static constexpr auto reflected_members() noexcept
+        {
+            return meta::makeMap(reflect_member(&transform::position),
+                                 reflect_member(&transform::scale),
+                                 reflect_member(&transform::angle));
+        }
+
+        //! Public data members
+        vec2 position{};
+        vec2 scale{1.0f, 1.0f};
+        float angle{0.0f};
+    };
+}
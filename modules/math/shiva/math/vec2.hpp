@@ -0,0 +1,132 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <cmath>
+#include <string>
+#include <shiva/reflection/reflection.hpp>
+
+namespace shiva::math
+{
+    /**
+     * \note 2D vector value type shared by the C++ code and the scripting languages.
+     */
+    struct vec2
+    {
+        //! Public member functions
+        constexpr float dot(const vec2 &other) const noexcept
+        {
+            return x * other.x + y * other.y;
+        }
+
+        constexpr float length_squared() const noexcept
+        {
+            return dot(*this);
+        }
+
+        float length() const noexcept
+        {
+            return std::sqrt(length_squared());
+        }
+
+        float distance(const vec2 &other) const noexcept
+        {
+            return vec2{other.x - x, other.y - y}.length();
+        }
+
+        /**
+         * \return the unit vector of the same direction, a null vector stays null.
+         */
+        vec2 normalized() const noexcept
+        {
+            const float len = length();
+            return len > 0.0f ? vec2{x / len, y / len} : vec2{};
+        }
+
+        std::string to_string() const noexcept
+        {
+            return "vec2(" + std::to_string(x) + ", " + std::to_string(y) + ")";
+        }
+
+        //! Operators
+        constexpr vec2 operator+(const vec2 &other) const noexcept
+        {
+            return {x + other.x, y + other.y};
+        }
+
+        constexpr vec2 operator-(const vec2 &other) const noexcept
+        {
+            return {x - other.x, y - other.y};
+        }
+
+        constexpr vec2 operator*(float factor) const noexcept
+        {
+            return {x * factor, y * factor};
+        }
+
+        constexpr vec2 operator/(float factor) const noexcept
+        {
+            return {x / factor, y / factor};
+        }
+
+        constexpr vec2 operator-() const noexcept
+        {
+            return {-x, -y};
+        }
+
+        constexpr vec2 &operator+=(const vec2 &other) noexcept
+        {
+            x += other.x;
+            y += other.y;
+            return *this;
+        }
+
+        constexpr vec2 &operator-=(const vec2 &other) noexcept
+        {
+            x -= other.x;
+            y -= other.y;
+            return *this;
+        }
+
+        constexpr vec2 &operator*=(float factor) noexcept
+        {
+            x *= factor;
+            y *= factor;
+            return *this;
+        }
+
+        constexpr bool operator==(const vec2 &other) const noexcept
+        {
+            return x == other.x && y == other.y;
+        }
+
+        constexpr bool operator!=(const vec2 &other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+        //! Reflection
+        reflect_class(vec2)
+
+        static constexpr auto reflected_functions() noexcept
+        {
+            return meta::makeMap(reflect_function(&vec2::dot),
+                                 reflect_function(&vec2::length_squared),
+                                 reflect_function(&vec2::length),
+                                 reflect_function(&vec2::distance),
+                                 reflect_function(&vec2::normalized));
+        }
+
+        static constexpr auto reflected_members() noexcept
+        {
+            return meta::makeMap(reflect_member(&vec2::x),
+                                 reflect_member(&vec2::y));
+        }
+
+        //! Public data members
+        float x{0.0f};
+        float y{0.0f};
+    };
+}
@@ -0,0 +1,269 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <shiva/math/vec2.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SHIVA_MATH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace shiva::math
+{
+    /**
+     * \note Contiguous array of vec2 stored as two columns (x and y), used for batched operations.
+     * \note The batched operations are vectorized with SSE2 when available, a scalar loop is used otherwise.
+     * \note Operations between two arrays only process the elements that both arrays have.
+     * \class vec2_array
+     */
+    class vec2_array
+    {
+    public:
+        //! Constructors
+        vec2_array() noexcept = default;
+
+        inline explicit vec2_array(size_t size) noexcept;
+
+        //! Public member functions
+        inline size_t size() const noexcept;
+
+        inline void resize(size_t size) noexcept;
+
+        inline void reserve(size_t capacity) noexcept;
+
+        inline void clear() noexcept;
+
+        inline void push_back(const vec2 &value) noexcept;
+
+        /**
+         * \note no bounds checking, the scripting bindings check the index before calling it.
+         */
+        inline vec2 get(size_t index) const noexcept;
+
+        inline void set(size_t index, const vec2 &value) noexcept;
+
+        inline const float *xs() const noexcept;
+
+        inline const float *ys() const noexcept;
+
+        //! Batched operations
+
+        /**
+         * \note this[i] += other[i]
+         */
+        inline void add(const vec2_array &other) noexcept;
+
+        /**
+         * \note this[i] -= other[i]
+         */
+        inline void sub(const vec2_array &other) noexcept;
+
+        /**
+         * \note this[i] += offset
+         */
+        inline void translate(const vec2 &offset) noexcept;
+
+        /**
+         * \note this[i] *= factor
+         */
+        inline void scale(float factor) noexcept;
+
+        /**
+         * \return result[i] = distance(this[i], point)
+         */
+        inline std::vector<float> distances(const vec2 &point) const noexcept;
+
+        /**
+         * \return result[i] = distance(this[i], other[i])
+         */
+        inline std::vector<float> distances(const vec2_array &other) const noexcept;
+
+        //! Reflection
+        reflect_class(vec2_array)
+
+        static constexpr auto reflected_functions() noexcept
+        {
+            return meta::makeMap(reflect_function(&vec2_array::size),
+                                 reflect_function(&vec2_array::resize),
+                                 reflect_function(&vec2_array::clear),
+                                 reflect_function(&vec2_array::push_back),
+                                 reflect_function(&vec2_array::add),
+                                 reflect_function(&vec2_array::sub),
+                                 reflect_function(&vec2_array::translate),
+                                 reflect_function(&vec2_array::scale));
+        }
+
+        static constexpr auto reflected_members() noexcept
+        {
+            return meta::makeMap();
+        }
+
+    private:
+        //! Private data members
+        std::vector<float> xs_;
+        std::vector<float> ys_;
+    };
+}
+
+namespace shiva::math
+{
+    namespace details
+    {
+        //! dst[i] += src[i] * sign
+        inline void add_columns(float *dst, const float *src, float sign, size_t size) noexcept
+        {
+            size_t i = 0u;
+#if defined(SHIVA_MATH_SSE2)
+            const __m128 sign_v = _mm_set1_ps(sign);
+            for (; i + 4u <= size; i += 4u) {
+                const __m128 res = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), sign_v));
+                _mm_storeu_ps(dst + i, res);
+            }
+#endif
+            for (; i < size; ++i) {
+                dst[i] += src[i] * sign;
+            }
+        }
+
+        //! dst[i] = dst[i] * factor + offset
+        inline void fma_column(float *dst, float factor, float offset, size_t size) noexcept
+        {
+            size_t i = 0u;
+#if defined(SHIVA_MATH_SSE2)
+            const __m128 factor_v = _mm_set1_ps(factor);
+            const __m128 offset_v = _mm_set1_ps(offset);
+            for (; i + 4u <= size; i += 4u) {
+                _mm_storeu_ps(dst + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(dst + i), factor_v), offset_v));
+            }
+#endif
+            for (; i < size; ++i) {
+                dst[i] = dst[i] * factor + offset;
+            }
+        }
+
+        //! out[i] = distance((xs[i], ys[i]), (others_x[i * stride], others_y[i * stride])), stride is 0 or 1
+        inline void distances(const float *xs, const float *ys, const float *others_x, const float *others_y,
+                              size_t stride, float *out, size_t size) noexcept
+        {
+            size_t i = 0u;
+#if defined(SHIVA_MATH_SSE2)
+            for (; i + 4u <= size; i += 4u) {
+                const __m128 other_x = stride ? _mm_loadu_ps(others_x + i) : _mm_set1_ps(*others_x);
+                const __m128 other_y = stride ? _mm_loadu_ps(others_y + i) : _mm_set1_ps(*others_y);
+                const __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), other_x);
+                const __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), other_y);
+                _mm_storeu_ps(out + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy))));
+            }
+#endif
+            for (; i < size; ++i) {
+                const float dx = xs[i] - others_x[i * stride];
+                const float dy = ys[i] - others_y[i * stride];
+                out[i] = std::sqrt(dx * dx + dy * dy);
+            }
+        }
+    }
+
+    //! Constructors
+    vec2_array::vec2_array(size_t size) noexcept : xs_(size, 0.0f), ys_(size, 0.0f)
+    {
+    }
+
+    //! Public member functions
+    size_t vec2_array::size() const noexcept
+    {
+        return xs_.size();
+    }
+
+    void vec2_array::resize(size_t size) noexcept
+    {
+        xs_.resize(size, 0.0f);
+        ys_.resize(size, 0.0f);
+    }
+
+    void vec2_array::reserve(size_t capacity) noexcept
+    {
+        xs_.reserve(capacity);
+        ys_.reserve(capacity);
+    }
+
+    void vec2_array::clear() noexcept
+    {
+        xs_.clear();
+        ys_.clear();
+    }
+
+    void vec2_array::push_back(const vec2 &value) noexcept
+    {
+        xs_.push_back(value.x);
+        ys_.push_back(value.y);
+    }
+
+    vec2 vec2_array::get(size_t index) const noexcept
+    {
+        return vec2{xs_[index], ys_[index]};
+    }
+
+    void vec2_array::set(size_t index, const vec2 &value) noexcept
+    {
+        xs_[index] = value.x;
+        ys_[index] = value.y;
+    }
+
+    const float *vec2_array::xs() const noexcept
+    {
+        return xs_.data();
+    }
+
+    const float *vec2_array::ys() const noexcept
+    {
+        return ys_.data();
+    }
+
+    //! Batched operations
+    void vec2_array::add(const vec2_array &other) noexcept
+    {
+        const size_t count = std::min(size(), other.size());
+        details::add_columns(xs_.data(), other.xs_.data(), 1.0f, count);
+        details::add_columns(ys_.data(), other.ys_.data(), 1.0f, count);
+    }
+
+    void vec2_array::sub(const vec2_array &other) noexcept
+    {
+        const size_t count = std::min(size(), other.size());
+        details::add_columns(xs_.data(), other.xs_.data(), -1.0f, count);
+        details::add_columns(ys_.data(), other.ys_.data(), -1.0f, count);
+    }
+
+    void vec2_array::translate(const vec2 &offset) noexcept
+    {
+        details::fma_column(xs_.data(), 1.0f, offset.x, size());
+        details::fma_column(ys_.data(), 1.0f, offset.y, size());
+    }
+
+    void vec2_array::scale(float factor) noexcept
+    {
+        details::fma_column(xs_.data(), factor, 0.0f, size());
+        details::fma_column(ys_.data(), factor, 0.0f, size());
+    }
+
+    std::vector<float> vec2_array::distances(const vec2 &point) const noexcept
+    {
+        std::vector<float> result(size());
+        details::distances(xs_.data(), ys_.data(), &point.x, &point.y, 0u, result.data(), size());
+        return result;
+    }
+
+    std::vector<float> vec2_array::distances(const vec2_array &other) const noexcept
+    {
+        std::vector<float> result(std::min(size(), other.size()));
+        details::distances(xs_.data(), ys_.data(), other.xs_.data(), other.ys_.data(), 1u, result.data(),
+                           result.size());
+        return result;
+    }
+}
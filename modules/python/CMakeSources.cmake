@@ -5,6 +5,8 @@ set(MODULE_PUBLIC_HEADERS
         "${MODULE_PATH}/python.hpp"
         "${MODULE_PATH}/python_system.hpp"
         "${MODULE_PATH}/python_scripted_system.hpp"
+        "${MODULE_PATH}/python_math.hpp"
+        "${MODULE_PATH}/python_component_views.hpp"
         )
 
 set(MODULE_PRIVATE_HEADERS
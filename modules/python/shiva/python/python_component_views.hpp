@@ -0,0 +1,111 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <type_traits>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <shiva/entt/entt.hpp>
+#include <shiva/reflection/reflection.hpp>
+
+namespace shiva::scripting
+{
+    namespace details
+    {
+        template <typename Component, typename Member>
+        using member_type_t = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<Component &>().*
+                                                                                  std::declval<Member>())>>;
+
+        template <typename Component>
+        inline bool has_only_arithmetic_members() noexcept
+        {
+            bool res = true;
+            size_t nb_members = 0u;
+            shiva::meta::for_each(Component::reflected_members(), [&res, &nb_members](auto &&, auto &&member) {
+                using member_type = member_type_t<Component, std::decay_t<decltype(member)>>;
+                res &= std::is_arithmetic_v<member_type>;
+                ++nb_members;
+            });
+            return res && nb_members > 0u;
+        }
+    }
+
+    /**
+     * \note A component can be viewed as a numpy structured array if his layout is C compatible
+     * and if all his reflected members are arithmetic (transform_2d for example).
+     */
+    template <typename Component>
+    inline bool is_viewable_component() noexcept
+    {
+        if constexpr (std::is_standard_layout_v<Component> && std::is_trivially_copyable_v<Component> &&
+                      shiva::refl::has_reflectible_members_v<Component>) {
+            return details::has_only_arithmetic_members<Component>();
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * \return the numpy structured dtype of the component, one field per reflected member.
+     * \note the non-reflected members are kept as padding (itemsize is sizeof(Component)).
+     */
+    template <typename Component>
+    pybind11::dtype component_dtype()
+    {
+        namespace py = pybind11;
+        py::list names;
+        py::list formats;
+        py::list offsets;
+        std::aligned_storage_t<sizeof(Component), alignof(Component)> storage;
+        const auto *base = reinterpret_cast<const char *>(&storage);
+        const auto *object = reinterpret_cast<const Component *>(&storage);
+        shiva::meta::for_each(Component::reflected_members(), [&](auto &&name, auto &&member) {
+            using member_type = details::member_type_t<Component, std::decay_t<decltype(member)>>;
+            names.append(py::str(name.data(), name.size()));
+            formats.append(py::dtype::of<member_type>());
+            offsets.append(reinterpret_cast<const char *>(&(object->*member)) - base);
+        });
+        return py::dtype(names, formats, offsets, sizeof(Component));
+    }
+
+    /**
+     * \return a numpy structured array over the packed storage of the component inside the registry, without copy.
+     * \note the array is writable, modifications are seen by the C++ side.
+     * \note the view is invalidated when a component of this type is added or removed,
+     * the same rules apply as for an EnTT view: take it, use it, drop it.
+     * \param owner python object of the registry, kept alive by the array
+     */
+    template <typename Component>
+    pybind11::array component_array(shiva::entt::entity_registry &registry, pybind11::handle owner)
+    {
+        namespace py = pybind11;
+        const auto size = static_cast<py::ssize_t>(registry.size<Component>());
+        //! not cached: a dtype must not outlive the interpreter.
+        const py::dtype dtype = component_dtype<Component>();
+        if (size == 0) {
+            return py::array(dtype, {py::ssize_t{0}}, {static_cast<py::ssize_t>(sizeof(Component))});
+        }
+        return py::array(dtype, {size}, {static_cast<py::ssize_t>(sizeof(Component))},
+                         registry.raw<Component>(), owner);
+    }
+
+    /**
+     * \return a read-only numpy array of the entities owning the component, in the same order as component_array.
+     */
+    template <typename Component>
+    pybind11::array component_entities(shiva::entt::entity_registry &registry, pybind11::handle owner)
+    {
+        namespace py = pybind11;
+        using entity_type = shiva::entt::entity_registry::entity_type;
+        const auto size = static_cast<py::ssize_t>(registry.size<Component>());
+        if (size == 0) {
+            return py::array_t<entity_type>(0);
+        }
+        py::array_t<entity_type> entities({size}, {static_cast<py::ssize_t>(sizeof(entity_type))},
+                                          registry.data<Component>(), owner);
+        entities.attr("setflags")(py::arg("write") = false);
+        return std::move(entities);
+    }
+}
@@ -0,0 +1,104 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <pybind11/operators.h>
+#include <pybind11/stl.h>
+#include <shiva/math/math.hpp>
+
+namespace shiva::scripting
+{
+    /**
+     * \note register the shiva.math types (vec2, rect, transform, vec2_array) as the submodule math of the given module.
+     * \note the batched operations of vec2_array run in C++ (SIMD), without the GIL.
+     */
+    inline pybind11::module register_math(pybind11::module &module_) noexcept
+    {
+        namespace py = pybind11;
+        using namespace shiva::math;
+        auto math_module = module_.def_submodule("math");
+
+        py::class_<vec2>(math_module, vec2::class_name().c_str())
+            .def(py::init([]() { return vec2{}; }))
+            .def(py::init([](float x, float y) { return vec2{x, y}; }))
+            .def_readwrite("x", &vec2::x)
+            .def_readwrite("y", &vec2::y)
+            .def("dot", &vec2::dot)
+            .def("length", &vec2::length)
+            .def("length_squared", &vec2::length_squared)
+            .def("distance", &vec2::distance)
+            .def("normalized", &vec2::normalized)
+            .def(py::self + py::self)
+            .def(py::self - py::self)
+            .def(py::self += py::self)
+            .def(py::self -= py::self)
+            .def(py::self * float())
+            .def(py::self / float())
+            .def(-py::self)
+            .def(py::self == py::self)
+            .def(py::self != py::self)
+            .def("__repr__", &vec2::to_string);
+
+        py::class_<rect>(math_module, rect::class_name().c_str())
+            .def(py::init([]() { return rect{}; }))
+            .def(py::init([](float left, float top, float width, float height) {
+                return rect{left, top, width, height};
+            }))
+            .def_readwrite("left", &rect::left)
+            .def_readwrite("top", &rect::top)
+            .def_readwrite("width", &rect::width)
+            .def_readwrite("height", &rect::height)
+            .def("contains", &rect::contains)
+            .def("intersects", &rect::intersects)
+            .def("intersection", &rect::intersection)
+            .def("position", &rect::position)
+            .def("size", &rect::size)
+            .def("center", &rect::center)
+            .def(py::self == py::self);
+
+        py::class_<transform>(math_module, transform::class_name().c_str())
+            .def(py::init([]() { return transform{}; }))
+            .def(py::init([](const vec2 &position, const vec2 &scale, float angle) {
+                return transform{position, scale, angle};
+            }))
+            .def_readwrite("position", &transform::position)
+            .def_readwrite("scale", &transform::scale)
+            .def_readwrite("angle", &transform::angle)
+            .def("apply_point", &transform::apply_point)
+            .def("apply_rect", &transform::apply_rect)
+            .def("translate", &transform::translate)
+            .def("rotate", &transform::rotate);
+
+        py::class_<vec2_array>(math_module, vec2_array::class_name().c_str())
+            .def(py::init<>())
+            .def(py::init<size_t>())
+            .def("__len__", &vec2_array::size)
+            .def("__getitem__", [](const vec2_array &self, size_t index) {
+                if (index >= self.size()) {
+                    throw py::index_error();
+                }
+                return self.get(index);
+            })
+            .def("__setitem__", [](vec2_array &self, size_t index, const vec2 &value) {
+                if (index >= self.size()) {
+                    throw py::index_error();
+                }
+                self.set(index, value);
+            })
+            .def("resize", &vec2_array::resize)
+            .def("clear", &vec2_array::clear)
+            .def("push_back", &vec2_array::push_back)
+            .def("add", &vec2_array::add, py::call_guard<py::gil_scoped_release>())
+            .def("sub", &vec2_array::sub, py::call_guard<py::gil_scoped_release>())
+            .def("translate", &vec2_array::translate, py::call_guard<py::gil_scoped_release>())
+            .def("scale", &vec2_array::scale, py::call_guard<py::gil_scoped_release>())
+            .def("distances", py::overload_cast<const vec2 &>(&vec2_array::distances, py::const_),
+                 py::call_guard<py::gil_scoped_release>())
+            .def("distances", py::overload_cast<const vec2_array &>(&vec2_array::distances, py::const_),
+                 py::call_guard<py::gil_scoped_release>());
+        return math_module;
+    }
+}
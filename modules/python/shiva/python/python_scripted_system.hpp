@@ -4,13 +4,105 @@
 
 #pragma once
 
+#include <array>
+#include <vector>
+#include <algorithm>
 #include <shiva/ecs/system.hpp>
 #include <shiva/filesystem/filesystem.hpp>
 #include <pybind11/pybind11.h>
+#include <pybind11/embed.h>
 #include <shiva/event/all.hpp>
 
 namespace shiva::ecs
 {
+    /**
+     * \note This class stores the python scripts of one kind of system (pre, logic or post update)
+     * with their callables (update, on_construct, on_destruct and the events handlers) resolved once.
+     * \note The callables are resolved again only when a script is reloaded, see rebind_script.
+     * \note Every function of this class expects the GIL to be held by the caller.
+     * \class python_scripts
+     */
+    class python_scripts
+    {
+    public:
+        //! Public typedefs
+        using events_list = shiva::event::common_events_list;
+
+        struct script
+        {
+            std::string module_name;
+            pybind11::object update;
+            pybind11::object on_construct;
+            pybind11::object on_destruct;
+            std::array<pybind11::object, meta::list::Length<events_list>::value> events_handlers;
+        };
+
+        //! Constructors
+        explicit python_scripts(std::shared_ptr<pybind11::module> module) noexcept : module_(std::move(module))
+        {
+        }
+
+        //! Public member functions
+        void add_script(const std::string &module_name)
+        {
+            scripts_.push_back(script{module_name, {}, {}, {}, {}});
+            bind_(scripts_.back(), events_list{});
+        }
+
+        /**
+         * \note resolve again the callables of the script, to be called after the module has been reloaded.
+         * \return false if the script is unknown, true otherwise
+         */
+        bool rebind_script(const std::string &module_name)
+        {
+            auto it = std::find_if(scripts_.begin(), scripts_.end(), [&module_name](const script &current) {
+                return current.module_name == module_name;
+            });
+            if (it == scripts_.end()) {
+                return false;
+            }
+            bind_(*it, events_list{});
+            return true;
+        }
+
+        std::vector<script> &get_scripts() noexcept
+        {
+            return scripts_;
+        }
+
+        size_t size() const noexcept
+        {
+            return scripts_.size();
+        }
+
+    private:
+        //! Private member functions
+        pybind11::object resolve_(const pybind11::object &module, const char *function_name) const
+        {
+            return pybind11::hasattr(module, function_name) ? module.attr(function_name) : pybind11::none();
+        }
+
+        template <typename ... Types>
+        void bind_(script &current, meta::type_list<Types...>)
+        {
+            using namespace std::string_literals;
+            pybind11::object module = module_->attr(current.module_name.c_str());
+            current.update = resolve_(module, "update");
+            current.on_construct = resolve_(module, "on_construct");
+            current.on_destruct = resolve_(module, "on_destruct");
+            ((current.events_handlers[meta::list::Position<events_list, Types>::value] = resolve_(
+                module, ("on_"s + Types::class_name()).c_str())), ...);
+        }
+
+        //! Private data members
+        std::shared_ptr<pybind11::module> module_;
+        std::vector<script> scripts_;
+    };
+
+    /**
+     * \note This system runs all the python scripts of one kind of system,
+     * the GIL is acquired once per update for all of them.
+     */
     template <typename SystemType>
     class python_scripted_system : public system<python_scripted_system<SystemType>, SystemType>
     {
@@ -21,22 +113,24 @@ namespace shiva::ecs
                                shiva::entt::entity_registry &entity_registry,
                                const float &fixed_delta_time,
                                std::shared_ptr<pybind11::scoped_interpreter> guard,
-                               std::shared_ptr<pybind11::module> module,
-                               std::string table_name,
+                               std::shared_ptr<python_scripts> scripts,
                                std::string class_name) noexcept :
             TSystem::system(dispatcher, entity_registry, fixed_delta_time, class_name),
             guard_(guard),
-            module_(module),
-            table_name_(std::move(table_name))
+            scripts_(std::move(scripts))
         {
             register_common_events(shiva::event::common_events_list{});
             class_name_ = std::move(class_name);
-            safe_function("on_construct");
         }
 
         ~python_scripted_system() noexcept override
         {
-            safe_function("on_destruct");
+            pybind11::gil_scoped_acquire acquire;
+            for (auto &&current : scripts_->get_scripts()) {
+                safe_call(current.on_destruct, current.module_name, "on_destruct");
+            }
+            //! the python objects must be released with the GIL held
+            scripts_ = nullptr;
         }
 
         template <typename EventType>
@@ -55,14 +149,24 @@ namespace shiva::ecs
         template <typename EventType>
         void receive([[maybe_unused]] const EventType &evt)
         {
-            using namespace std::string_literals;
+            using events_list = python_scripts::events_list;
             this->log_->info("event_type received: {}", EventType::class_name());
-            safe_function("on_"s + EventType::class_name());
+            pybind11::gil_scoped_acquire acquire;
+            for (auto &&current : scripts_->get_scripts()) {
+                safe_call(current.events_handlers[meta::list::Position<events_list, EventType>::value],
+                          current.module_name, EventType::class_name());
+            }
         }
 
         void update() noexcept override
         {
-            safe_function("update");
+            if (!scripts_->size()) {
+                return;
+            }
+            pybind11::gil_scoped_acquire acquire;
+            for (auto &&current : scripts_->get_scripts()) {
+                safe_call(current.update, current.module_name, "update");
+            }
         }
 
         static const std::string &class_name() noexcept
@@ -81,31 +185,27 @@ namespace shiva::ecs
         }
 
     private:
-        template <typename ... Args>
-        void safe_function(const std::string &function, Args &&... args)
+        void safe_call(const pybind11::object &function, const std::string &module_name,
+                       const std::string &function_name) noexcept
         {
+            if (!function || function.is_none()) {
+                return;
+            }
             try {
-                const char *c_function_name = function.c_str();
-                auto current = module_->attr(class_name_.c_str());
-                if (pybind11::hasattr(current, c_function_name)) {
-                    pybind11::object obj = current.attr(c_function_name);
-                    if (!obj.is_none()) {
-                        obj(std::forward<Args>(args)...);
-                    }
-                }
+                function();
             }
             catch (const std::exception &error) {
-                this->log_->error("python error: {}", error.what());
+                this->log_->error("python error: [module: {0}, function: {1}, err: {2}]", module_name,
+                                  function_name, error.what());
             }
         }
 
         std::shared_ptr<pybind11::scoped_interpreter> guard_;
-        std::shared_ptr<pybind11::module> module_;
-        std::string table_name_;
+        std::shared_ptr<python_scripts> scripts_;
         static inline std::string class_name_{""};
     };
 
     using python_post_scripted_system = python_scripted_system<shiva::ecs::system_post_update>;
     using python_pre_scripted_system = python_scripted_system<shiva::ecs::system_pre_update>;
     using python_logic_scripted_system = python_scripted_system<shiva::ecs::system_logic_update>;
-}
\ No newline at end of file
+}
@@ -4,13 +4,20 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
+#include <vector>
+#include <stdexcept>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/embed.h>
 #include <shiva/filesystem/filesystem.hpp>
+#include <shiva/filesystem/vfs.hpp>
 #include <shiva/ecs/system.hpp>
 #include <shiva/input/input.hpp>
 #include <shiva/python/python_scripted_system.hpp>
+#include <shiva/python/python_math.hpp>
+#include <shiva/python/python_component_views.hpp>
 #include <shiva/event/add_base_system.hpp>
 
 namespace py = pybind11;
@@ -54,12 +61,27 @@ namespace shiva::scripting
                            "_component"s).c_str(),
                           [](shiva::entt::entity_registry &self,
                              py::object functor) {
-                              auto view = self.view<Component>();
-                              for (auto entity : view) {
+                              //! the view is walked without the GIL, only the python calls need it.
+                              std::vector<shiva::entt::entity_registry::entity_type> entities;
+                              {
+                                  py::gil_scoped_release release;
+                                  auto view = self.view<Component>();
+                                  entities.assign(view.begin(), view.end());
+                              }
+                              for (auto entity : entities) {
                                   functor(entity);
                               }
                           });
 
+            //! Zero-copy numpy views over the component storage, see python_component_views.hpp
+            if (is_viewable_component<Component>()) {
+                type.def((Component::class_name() + "_array"s).c_str(), [](py::object self) {
+                    return component_array<Component>(self.cast<shiva::entt::entity_registry &>(), self);
+                }).def((Component::class_name() + "_entities"s).c_str(), [](py::object self) {
+                    return component_entities<Component>(self.cast<shiva::entt::entity_registry &>(), self);
+                });
+            }
+
             if constexpr (std::is_default_constructible_v<Component>) {
                 type.def(("add_"s + Component::class_name() + "_component"s).c_str(),
                          [](shiva::entt::entity_registry &self,
@@ -80,7 +102,6 @@ namespace shiva::scripting
             script_directory_(std::move(scripts_directory)),
             systems_scripts_directory_(std::move(systems_scripts_directory))
         {
-            globals_ = py::globals();
             py::enum_<shiva::ecs::system_type>(*module_, "system_type")
                 .value("pre_update", shiva::ecs::system_type::pre_update)
                 .value("logic_update", shiva::ecs::system_type::logic_update)
@@ -91,6 +112,7 @@ namespace shiva::scripting
                 pyenum.value(cur.toString().c_str(), cur);
             }
             pyenum.export_values();
+            register_math(*module_);
             disable();
         }
 
@@ -102,9 +124,9 @@ namespace shiva::scripting
                 log_->warn("file_name: {} have a bad extension, ignoring.", file_name);
                 return false;
             }
+            py::gil_scoped_acquire acquire;
             try {
-                import_module(fs::path(file_name).stem().string(), (script_directory / fs::path(file_name)).string(),
-                              globals_);
+                import_module(fs::path(file_name).stem().string(), (script_directory / fs::path(file_name)).string());
             }
             catch (const std::exception &error) {
                 log_->error("error -> {}", error.what());
@@ -118,6 +140,69 @@ namespace shiva::scripting
             return load_script(file_name, script_directory_);
         }
 
+        /**
+         * \note execute again the module in place from its file, the objects holding the module see the changes.
+         * \note importlib.reload is not used: the scripts are imported from their location, outside of sys.path.
+         * \param module_name name of the module (stem of the script)
+         * \return false if the module was never imported, has no file or if the reload failed, true otherwise
+         */
+        bool reload_module(const std::string &module_name) noexcept
+        {
+            py::gil_scoped_acquire acquire;
+            try {
+                py::dict sys_modules = py::module::import("sys").attr("modules");
+                if (!sys_modules.contains(module_name)) {
+                    log_->warn("module {} was never imported, cannot reload it", module_name);
+                    return false;
+                }
+                py::object current_module = sys_modules[module_name.c_str()];
+                if (!py::hasattr(current_module, "__file__") || current_module.attr("__file__").is_none()) {
+                    log_->warn("module {} was not imported from a file, cannot reload it", module_name);
+                    return false;
+                }
+                py::object spec = py::module::import("importlib.util").attr("spec_from_file_location")(
+                    module_name, current_module.attr("__file__"));
+                if (spec.is_none()) {
+                    log_->warn("cannot find a loader for module {}", module_name);
+                    return false;
+                }
+                spec.attr("loader").attr("exec_module")(current_module);
+                module_->add_object(module_name.c_str(), current_module, true);
+                for (auto &&scripts : scripts_) {
+                    if (scripts != nullptr) {
+                        scripts->rebind_script(module_name);
+                    }
+                }
+            }
+            catch (const std::exception &error) {
+                log_->error("error when reloading module {0}: {1}", module_name, error.what());
+                return false;
+            }
+            log_->info("successfully reloaded module: {}", module_name);
+            return true;
+        }
+
+        /**
+         * \note release the GIL held by the main thread since the creation of the interpreter,
+         * the python scripted systems and the python_system functions acquire it only when they need it,
+         * native worker threads are then able to run python code between the phases.
+         * \warning once released, the code using the python api directly must acquire the GIL (py::gil_scoped_acquire).
+         */
+        void release_gil() noexcept
+        {
+            if (gil_release_ == nullptr) {
+                gil_release_ = std::make_unique<py::gil_scoped_release>();
+            }
+        }
+
+        /**
+         * \note take back the GIL released by release_gil.
+         */
+        void acquire_gil() noexcept
+        {
+            gil_release_ = nullptr;
+        }
+
         pybind11::module &get_module() noexcept
         {
             return *module_;
@@ -130,58 +215,39 @@ namespace shiva::scripting
 
         bool create_scripted_system(const shiva::fs::path &script_name)
         {
-            auto real_name = script_name.filename().string();
-            auto stem_name = script_name.filename().stem().string();
-            bool res = load_script(real_name, systems_scripts_directory_);
-            if (res) {
-                shiva::ecs::system_type sys_type = module_->attr(script_name.filename().stem().string().c_str()).attr(
-                    "current_system_type").cast<shiva::ecs::system_type>();
-                log_->info("attr {0}, type {1}", script_name.filename().stem().string().c_str(), sys_type);
-                switch (sys_type) {
-                    case shiva::ecs::post_update:
-                        dispatcher_.trigger<shiva::event::add_base_system>(
-                            std::make_unique<shiva::ecs::python_post_scripted_system>(dispatcher_, entity_registry_,
-                                                                                      fixed_delta_time_, guard_,
-                                                                                      module_,
-                                                                                      stem_name,
-                                                                                      stem_name));
-                        break;
-                    case shiva::ecs::pre_update:
-                        dispatcher_.trigger<shiva::event::add_base_system>(
-                            std::make_unique<shiva::ecs::python_pre_scripted_system>(dispatcher_, entity_registry_,
-                                                                                     fixed_delta_time_, guard_, module_,
-                                                                                     stem_name,
-                                                                                     stem_name));
-                        break;
-                    case shiva::ecs::logic_update:
-                        dispatcher_.trigger<shiva::event::add_base_system>(
-                            std::make_unique<shiva::ecs::python_logic_scripted_system>(dispatcher_, entity_registry_,
-                                                                                       fixed_delta_time_, guard_,
-                                                                                       module_,
-                                                                                       stem_name,
-                                                                                       stem_name));
-                        break;
-                    case shiva::ecs::system_type::size:
-                        break;
-                    default:
-                        break;
-                }
-            }
-            return res;
+            py::gil_scoped_acquire acquire;
+            bool res = load_script(script_name.filename().string(), systems_scripts_directory_);
+            return res && create_scripted_system_from_module_(script_name);
         }
 
+        /**
+         * \note all the modules are imported first (one listing of the vfs, bytecode from __pycache__),
+         * then the systems are created.
+         */
         bool load_all_scripted_systems() noexcept
         {
             bool res = true;
-            fs::recursive_directory_iterator endit;
-            for (fs::recursive_directory_iterator it(systems_scripts_directory_); it != endit; ++it) {
-                if (!fs::is_regular_file(*it)) {
-                    continue;
+            std::vector<shiva::fs::path> scripts;
+            const auto directory = vfs_->mount_path(systems_scripts_directory_);
+            vfs_->for_each_file(directory, [this, &res, &scripts, &directory](const std::string &path) {
+                const auto script = systems_scripts_directory_ /
+                                    fs::path(directory.empty() ? path : path.substr(directory.size() + 1u));
+                //! the compiled bytecode (__pycache__) is listed too
+                if (script.extension() != ".py") {
+                    return;
+                }
+                log_->info("path -> {}", script.string());
+                if (load_script(script.filename().string(), systems_scripts_directory_)) {
+                    scripts.push_back(script);
+                } else {
+                    res = false;
                 }
-                log_->info("path -> {}", it->path().string());
-                res &= create_scripted_system(it->path());
+            });
+            for (auto &&script : scripts) {
+                py::gil_scoped_acquire acquire;
+                res &= create_scripted_system_from_module_(script);
             }
-            return true;
+            return res;
         }
 
         template <typename T>
@@ -208,10 +274,16 @@ namespace shiva::scripting
             using comp_type = shiva::entt::entity_registry::component_type;
             type.def("for_each_runtime",
                      [](shiva::entt::entity_registry &self, std::vector<comp_type> array, py::object functor) {
-                         return self.view(std::cbegin(array), std::cend(array)).each(
-                             [func = std::move(functor)](auto entity) {
-                                 func(entity);
+                         std::vector<shiva::entt::entity_registry::entity_type> entities;
+                         {
+                             py::gil_scoped_release release;
+                             self.view(std::cbegin(array), std::cend(array)).each([&entities](auto entity) {
+                                 entities.push_back(entity);
                              });
+                         }
+                         for (auto entity : entities) {
+                             functor(entity);
+                         }
                      });
             module_->attr("ett_registry") = &entity_registry_;
         }
@@ -228,6 +300,61 @@ namespace shiva::scripting
         }
 
     private:
+        /**
+         * \note the scripts of the same kind are run by a single system, created with the first script of this kind.
+         */
+        bool create_scripted_system_from_module_(const shiva::fs::path &script_name)
+        {
+            auto module_name = script_name.filename().stem().string();
+            shiva::ecs::system_type sys_type = module_->attr(module_name.c_str()).attr(
+                "current_system_type").cast<shiva::ecs::system_type>();
+            log_->info("attr {0}, type {1}", module_name, sys_type);
+            if (sys_type >= shiva::ecs::system_type::size) {
+                return false;
+            }
+            auto &scripts = scripts_[sys_type];
+            if (scripts == nullptr) {
+                scripts = std::make_shared<shiva::ecs::python_scripts>(module_);
+                switch (sys_type) {
+                    case shiva::ecs::post_update:
+                        dispatcher_.trigger<shiva::event::add_base_system>(
+                            std::make_unique<shiva::ecs::python_post_scripted_system>(dispatcher_, entity_registry_,
+                                                                                      fixed_delta_time_, guard_,
+                                                                                      scripts,
+                                                                                      "python_post_scripted_system"));
+                        break;
+                    case shiva::ecs::pre_update:
+                        dispatcher_.trigger<shiva::event::add_base_system>(
+                            std::make_unique<shiva::ecs::python_pre_scripted_system>(dispatcher_, entity_registry_,
+                                                                                     fixed_delta_time_, guard_,
+                                                                                     scripts,
+                                                                                     "python_pre_scripted_system"));
+                        break;
+                    case shiva::ecs::logic_update:
+                        dispatcher_.trigger<shiva::event::add_base_system>(
+                            std::make_unique<shiva::ecs::python_logic_scripted_system>(dispatcher_, entity_registry_,
+                                                                                       fixed_delta_time_, guard_,
+                                                                                       scripts,
+                                                                                       "python_logic_scripted_system"));
+                        break;
+                    default:
+                        break;
+                }
+            }
+            try {
+                scripts->add_script(module_name);
+                auto &&current = scripts->get_scripts().back();
+                if (current.on_construct && !current.on_construct.is_none()) {
+                    current.on_construct();
+                }
+            }
+            catch (const std::exception &error) {
+                log_->error("python error: [module: {0}, function: on_construct, err: {1}]", module_name,
+                            error.what());
+            }
+            return true;
+        }
+
         template <typename T, typename ClassType>
         void register_type_epilogue(ClassType &&type)
         {
@@ -246,21 +373,58 @@ namespace shiva::scripting
             log_->info("successfully registering type: {}", T::class_name());
         }
 
-        py::object import_module(const std::string &module, const std::string &path, py::object &globals)
+        /**
+         * \note import the file through importlib, the compiled bytecode is cached in __pycache__
+         * and reused as long as the source file is unchanged.
+         * \note the module is stored in sys.modules, so it can be reloaded in place with reload_module.
+         * \note a module found in an archive or an overlay of the vfs is compiled from its source, see import_source_.
+         */
+        py::object import_module(const std::string &module, const std::string &path)
+        {
+            if (const auto virtual_path = vfs_->virtual_path(path); !vfs_->disk_path(virtual_path)) {
+                return import_source_(module, virtual_path);
+            }
+            py::module importlib_util = py::module::import("importlib.util");
+            py::dict sys_modules = py::module::import("sys").attr("modules");
+            py::object spec = importlib_util.attr("spec_from_file_location")(module, path);
+            if (spec.is_none()) {
+                throw std::runtime_error("cannot find a loader for " + path);
+            }
+            py::object new_module = importlib_util.attr("module_from_spec")(spec);
+            sys_modules[module.c_str()] = new_module;
+            try {
+                spec.attr("loader").attr("exec_module")(new_module);
+            }
+            catch (const py::error_already_set &) {
+                PyDict_DelItemString(sys_modules.ptr(), module.c_str());
+                throw;
+            }
+            module_->add_object(module.c_str(), new_module, true);
+            return new_module;
+        }
+
+        //! \note the source is read through the vfs, the module has no loader and can't be reloaded in place
+        py::object import_source_(const std::string &module, const std::string &path)
         {
-            py::dict locals;
-            locals["module_name"] = py::cast(module);
-            locals["path"] = py::cast(path);
-
-            const char *expression = "import imp\n"
-                                     "new_module = imp.load_module(module_name, open(path), path, ('py', 'U', imp.PY_SOURCE))\n";
-            py::eval<py::eval_statements>(
-                expression,
-                globals,
-                locals);
-
-            module_->add_object(module.c_str(), locals["new_module"]);
-            return locals["new_module"];
+            auto buffer = vfs_->read(path);
+            if (!buffer) {
+                throw std::runtime_error("cannot read " + path);
+            }
+            py::module builtins = py::module::import("builtins");
+            py::dict sys_modules = py::module::import("sys").attr("modules");
+            py::object spec = py::module::import("importlib.util").attr("spec_from_loader")(module, py::none());
+            py::object new_module = py::module::import("importlib.util").attr("module_from_spec")(spec);
+            sys_modules[module.c_str()] = new_module;
+            try {
+                py::object code = builtins.attr("compile")(py::bytes(buffer->data(), buffer->size()), path, "exec");
+                builtins.attr("exec")(code, new_module.attr("__dict__"));
+            }
+            catch (const py::error_already_set &) {
+                PyDict_DelItemString(sys_modules.ptr(), module.c_str());
+                throw;
+            }
+            module_->add_object(module.c_str(), new_module, true);
+            return new_module;
         }
 
     public:
@@ -278,9 +442,11 @@ namespace shiva::scripting
 
     private:
         std::shared_ptr<py::scoped_interpreter> guard_{std::make_shared<py::scoped_interpreter>()};
-        py::dict globals_;
         py::dict locals_;
         std::shared_ptr<py::module> module_{std::make_shared<py::module>(py::module::import("shiva"))};
+        std::array<std::shared_ptr<shiva::ecs::python_scripts>, shiva::ecs::system_type::size> scripts_{};
+        std::unique_ptr<py::gil_scoped_release> gil_release_{nullptr};
+        std::shared_ptr<shiva::filesystem::vfs> vfs_{shiva::filesystem::vfs::shared()};
         shiva::fs::path script_directory_;
         shiva::fs::path systems_scripts_directory_;
     };
@@ -3,6 +3,7 @@ set(MODULE_PATH
 
 set(MODULE_PUBLIC_HEADERS
         "${MODULE_PATH}/reflection.hpp"
+        "${MODULE_PATH}/binary_serialization.hpp"
         )
 
 set(MODULE_PRIVATE_HEADERS
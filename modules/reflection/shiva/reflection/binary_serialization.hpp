@@ -0,0 +1,194 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <shiva/meta/map.hpp>
+#include <shiva/meta/type_traits.hpp>
+#include <shiva/reflection/reflection.hpp>
+
+/**
+ * \note binary form of the reflected members of a type, in the order of reflected_members:
+ * the arithmetic values are copied as is, the strings are prefixed by their size (32 bits),
+ * the enums (ENUM) are stored as their underlying integer, the arrays and the reflected types element by element.
+ * \note the schema hash changes as soon as a member is renamed, added, removed or changes of type,
+ * a binary blob is only valid for the schema it has been written with.
+ */
+namespace shiva::refl
+{
+    namespace details
+    {
+        template <typename T>
+        using enum_type_t = typename T::EnumType;
+
+        template <typename T>
+        static inline constexpr bool is_reflected_enum_v = meta::is_detected<enum_type_t, T>::value;
+
+        template <typename T>
+        struct is_std_array : std::false_type
+        {
+        };
+
+        template <typename T, std::size_t N>
+        struct is_std_array<std::array<T, N>> : std::true_type
+        {
+        };
+
+        constexpr std::uint64_t hash_combine(std::uint64_t hash, std::string_view data) noexcept
+        {
+            for (auto c : data) {
+                hash ^= static_cast<std::uint8_t>(c);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        template <typename Member, typename Functor>
+        constexpr void for_each_member(Functor &&functor) noexcept
+        {
+            meta::for_each(Member::reflected_members(), functor);
+        }
+
+        template <typename T>
+        std::uint64_t schema_of(std::uint64_t hash) noexcept;
+
+        template <typename T>
+        std::uint64_t field_schema(std::uint64_t hash) noexcept
+        {
+            if constexpr (std::is_same_v<T, std::string>) {
+                return hash_combine(hash, "string");
+            } else if constexpr (is_reflected_enum_v<T>) {
+                return hash_combine(hash, "enum" + std::to_string(sizeof(typename T::EnumType)));
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                return hash_combine(hash, std::string(std::is_floating_point_v<T> ? "float" : "int") +
+                                          (std::is_signed_v<T> ? "s" : "u") + std::to_string(sizeof(T)));
+            } else if constexpr (is_std_array<T>::value) {
+                hash = hash_combine(hash, "array" + std::to_string(std::tuple_size_v<T>));
+                return field_schema<typename T::value_type>(hash);
+            } else {
+                static_assert(has_reflectible_members_v<T>, "unsupported type in a binary serialized member");
+                return schema_of<T>(hash_combine(hash, "struct"));
+            }
+        }
+
+        template <typename T>
+        std::uint64_t schema_of(std::uint64_t hash) noexcept
+        {
+            for_each_member<T>([&hash](auto &&name, auto &&member) {
+                using member_type = std::decay_t<decltype(std::declval<T &>().*member)>;
+                hash = field_schema<member_type>(hash_combine(hash, name));
+            });
+            return hash_combine(hash, "end");
+        }
+
+        template <typename T>
+        void write_field(std::string &out, const T &value) noexcept
+        {
+            if constexpr (std::is_same_v<T, std::string>) {
+                const auto size = static_cast<std::uint32_t>(value.size());
+                out.append(reinterpret_cast<const char *>(&size), sizeof(size));
+                out.append(value);
+            } else if constexpr (is_reflected_enum_v<T>) {
+                const auto raw = static_cast<std::underlying_type_t<typename T::EnumType>>(
+                    static_cast<typename T::EnumType>(value));
+                out.append(reinterpret_cast<const char *>(&raw), sizeof(raw));
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+            } else if constexpr (is_std_array<T>::value) {
+                for (auto &&element : value) {
+                    write_field(out, element);
+                }
+            } else {
+                for_each_member<T>([&out, &value](auto &&, auto &&member) {
+                    write_field(out, value.*member);
+                });
+            }
+        }
+
+        template <typename T>
+        bool read_field(std::string_view &in, T &value) noexcept
+        {
+            const auto read_raw = [&in](void *dst, std::size_t size) {
+                if (in.size() < size) {
+                    return false;
+                }
+                std::memcpy(dst, in.data(), size);
+                in.remove_prefix(size);
+                return true;
+            };
+            if constexpr (std::is_same_v<T, std::string>) {
+                std::uint32_t size = 0u;
+                if (!read_raw(&size, sizeof(size)) || in.size() < size) {
+                    return false;
+                }
+                value.assign(in.data(), size);
+                in.remove_prefix(size);
+                return true;
+            } else if constexpr (is_reflected_enum_v<T>) {
+                std::underlying_type_t<typename T::EnumType> raw{};
+                if (!read_raw(&raw, sizeof(raw))) {
+                    return false;
+                }
+                value = static_cast<typename T::EnumType>(raw);
+                return true;
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                return read_raw(&value, sizeof(T));
+            } else if constexpr (is_std_array<T>::value) {
+                for (auto &&element : value) {
+                    if (!read_field(in, element)) {
+                        return false;
+                    }
+                }
+                return true;
+            } else {
+                bool res = true;
+                for_each_member<T>([&in, &value, &res](auto &&, auto &&member) {
+                    res = res && read_field(in, value.*member);
+                });
+                return res;
+            }
+        }
+    }
+
+    /**
+     * \return the hash of the names and the types of the reflected members of T (computed once)
+     */
+    template <typename T>
+    std::uint64_t schema_hash() noexcept
+    {
+        static const std::uint64_t hash = details::schema_of<T>(14695981039346656037ull);
+        return hash;
+    }
+
+    //! \note append the reflected members of value to out
+    template <typename T>
+    void to_binary(const T &value, std::string &out) noexcept
+    {
+        details::write_field(out, value);
+    }
+
+    template <typename T>
+    std::string to_binary(const T &value) noexcept
+    {
+        std::string out;
+        to_binary(value, out);
+        return out;
+    }
+
+    /**
+     * \note read the reflected members of value from in, in is advanced past them.
+     * \return false if in is too short
+     */
+    template <typename T>
+    bool from_binary(std::string_view &in, T &value) noexcept
+    {
+        return details::read_field(in, value);
+    }
+}
@@ -6,6 +6,7 @@
 #include <shiva/sfml/animation/system-sfml-animation.hpp>
 #include <shiva/sfml/common/animation_config.hpp>
 #include <shiva/sfml/common/drawable_component_impl.hpp>
+#include <shiva/sfml/common/texture_region.hpp>
 #include "system-sfml-animation.hpp"
 
 namespace shiva::plugins
@@ -21,48 +22,51 @@ namespace shiva::plugins
     void animation_system::on_set_user_data_() noexcept
     {
         state_ = static_cast<sol::state *>(user_data_);
-        shiva::lua::register_type<animation_system>(*state_, log_);
         state_->new_enum<status_t::EnumType>("anim_status",
                                              {
                                                  {"playing", static_cast<status_t::EnumType>(status_t::playing)},
                                                  {"paused",  static_cast<status_t::EnumType>(status_t::paused)},
                                                  {"stopped", static_cast<status_t::EnumType>(status_t::stopped)}
                                              });
-        (*state_)[animation_system::class_name()]["create_animated_game_object_from_json"] = [](animation_system &self,
-                                                                                                const char *json_id) {
-            self.log_->info("json_id is {}", json_id);
-            sol::table table = (*self.state_)["shiva"]["resource_registry"];
-            const shiva::sfml::animation_config &cfg = table["get_anim_cfg_c"](table, json_id);
-            auto entity_id = self.create_game_object_with_animated_sprite(cfg.status,
-                                                                          static_cast<double>(cfg.speed),
-                                                                          cfg.loop,
-                                                                          cfg.repeat,
-                                                                          cfg.columns,
-                                                                          cfg.lines,
-                                                                          cfg.nb_anims,
-                                                                          cfg.texture.c_str());
-            return entity_id;
-        };
-
-        (*state_)[animation_system::class_name()]["add_animated_game_object_from_json"] = [](animation_system &self,
-                                                                                             const char *json_id,
-                                                                                             entt::entity_registry::entity_type entity) {
-            self.log_->info("json_id is {}", json_id);
-            sol::table table = (*self.state_)["shiva"]["resource_registry"];
-            const shiva::sfml::animation_config &cfg = table["get_anim_cfg_c"](table, json_id);
-            self.add_animated_sprite_(entity,
-                                      cfg.status,
-                                      static_cast<double>(cfg.speed),
-                                      cfg.loop,
-                                      cfg.repeat,
-                                      cfg.columns,
-                                      cfg.lines,
-                                      cfg.nb_anims,
-                                      cfg.texture.c_str(),
-                                      cfg.pos_x,
-                                      cfg.pos_y);
-        };
-        (*state_)["shiva"]["anim"] = std::ref(*this);
+        //! bound the first time shiva.anim is read
+        bindings_ = shiva::lua::register_plugin_bindings(*state_, "anim", [this]() {
+            shiva::lua::register_type<animation_system>(*state_, log_);
+            (*state_)[animation_system::class_name()]["create_animated_game_object_from_json"] = [](animation_system &self,
+                                                                                                    const char *json_id) {
+                self.log_->info("json_id is {}", json_id);
+                sol::table table = (*self.state_)["shiva"]["resource_registry"];
+                const shiva::sfml::animation_config &cfg = table["get_anim_cfg_c"](table, json_id);
+                auto entity_id = self.create_game_object_with_animated_sprite(cfg.status,
+                                                                              static_cast<double>(cfg.speed),
+                                                                              cfg.loop,
+                                                                              cfg.repeat,
+                                                                              cfg.columns,
+                                                                              cfg.lines,
+                                                                              cfg.nb_anims,
+                                                                              cfg.texture_id);
+                return entity_id;
+            };
+
+            (*state_)[animation_system::class_name()]["add_animated_game_object_from_json"] = [](animation_system &self,
+                                                                                                 const char *json_id,
+                                                                                                 entt::entity_registry::entity_type entity) {
+                self.log_->info("json_id is {}", json_id);
+                sol::table table = (*self.state_)["shiva"]["resource_registry"];
+                const shiva::sfml::animation_config &cfg = table["get_anim_cfg_c"](table, json_id);
+                self.add_animated_sprite_(entity,
+                                          cfg.status,
+                                          static_cast<double>(cfg.speed),
+                                          cfg.loop,
+                                          cfg.repeat,
+                                          cfg.columns,
+                                          cfg.lines,
+                                          cfg.nb_anims,
+                                          cfg.texture_id,
+                                          cfg.pos_x,
+                                          cfg.pos_y);
+            };
+            (*state_)["shiva"]["anim"] = std::ref(*this);
+        });
     }
 
     //! Public member functions overriden
@@ -124,10 +128,10 @@ namespace shiva::plugins
                                                                                                  unsigned int nb_columns,
                                                                                                  unsigned int nb_lines,
                                                                                                  unsigned int nb_anims,
-                                                                                                 const char *texture_name) noexcept
+                                                                                                 shiva::sfml::resource_id texture_id) noexcept
     {
         auto entity_id = this->entity_registry_.create();
-        add_animated_sprite_(entity_id, status, delta_time, loop, repeat, nb_columns, nb_lines, nb_anims, texture_name);
+        add_animated_sprite_(entity_id, status, delta_time, loop, repeat, nb_columns, nb_lines, nb_anims, texture_id);
         return entity_id;
     }
 
@@ -142,13 +146,13 @@ namespace shiva::plugins
                                            unsigned int numberY, unsigned int line, unsigned int columns) noexcept
     {
 
-        const sf::Vector2u size = get_sprite_(entity).getTexture()->getSize();
-        const float delta_x = (numberY == 1) ? (size.x / float(columns * numberX)) : (size.x / float(columns));
-        const float delta_y = size.y / float(numberY);
+        const sf::IntRect &sheet = get_animation_ptr_(entity)->sheet;
+        const float delta_x = (numberY == 1) ? (sheet.width / float(columns * numberX)) : (sheet.width / float(columns));
+        const float delta_y = sheet.height / float(numberY);
 
         for (unsigned int i = 0; i < numberX; ++i)
-            add_frame(entity, sf::IntRect(static_cast<int>(i * delta_x),
-                                          static_cast<int>(line * delta_y),
+            add_frame(entity, sf::IntRect(sheet.left + static_cast<int>(i * delta_x),
+                                          sheet.top + static_cast<int>(line * delta_y),
                                           static_cast<int>(delta_x),
                                           static_cast<int>(delta_y)));
     }
@@ -156,13 +160,13 @@ namespace shiva::plugins
     void animation_system::add_frames_column(entt::entity_registry::entity_type entity, int numberX, int numberY,
                                              int column) noexcept
     {
-        const sf::Vector2u size = get_sprite_(entity).getTexture()->getSize();
-        const float delta_x = size.x / float(numberX);
-        const float delta_y = size.y / float(numberY);
+        const sf::IntRect &sheet = get_animation_ptr_(entity)->sheet;
+        const float delta_x = sheet.width / float(numberX);
+        const float delta_y = sheet.height / float(numberY);
 
         for (int i = 0; i < numberY; ++i)
-            add_frame(entity, sf::IntRect(static_cast<int>(column * delta_x),
-                                          static_cast<int>(i * delta_y),
+            add_frame(entity, sf::IntRect(sheet.left + static_cast<int>(column * delta_x),
+                                          sheet.top + static_cast<int>(i * delta_y),
                                           static_cast<int>(delta_x),
                                           static_cast<int>(delta_y)));
     }
@@ -244,7 +248,7 @@ namespace shiva::plugins
                                                 unsigned int nb_columns,
                                                 unsigned int nb_lines,
                                                 unsigned int nb_anims,
-                                                const char *texture_name,
+                                                shiva::sfml::resource_id texture_id,
                                                 float pos_x,
                                                 float pos_y) noexcept
     {
@@ -256,8 +260,13 @@ namespace shiva::plugins
             std::static_pointer_cast<sf::Transformable>(sprite_ptr)));
 
         sol::table self = (*state_)["shiva"]["resource_registry"];
-        const sf::Texture &texture = self["get_texture_c"](self, texture_name);
-        sprite_ptr->setTexture(texture);
+        //! the frames are relative to the sheet, which can be packed in an atlas page
+        const shiva::sfml::texture_region region = self["get_texture_region"](self, texture_id);
+        //! headless mode, only the size of the texture is known
+        if (region.texture != nullptr) {
+            sprite_ptr->setTexture(*region.texture);
+        }
+        sprite_ptr->setTextureRect(region.rect);
 
         sprite_ptr->setPosition(pos_x, pos_y);
         //! Animation
@@ -271,6 +280,7 @@ namespace shiva::plugins
         animation_ptr->repeat = repeat;
         animation_ptr->elapsed = sf::Time::Zero;
         animation_ptr->current_frame = 0;
+        animation_ptr->sheet = region.rect;
         add_one_shot_animation(entity_id, nb_columns, nb_lines, nb_anims);
         set_frame(entity_id, 0);
 
@@ -8,6 +8,7 @@
 #include <shiva/lua/lua_helpers.hpp>
 #include <shiva/ecs/system.hpp>
 #include <shiva/sfml/common/animation_component_impl.hpp>
+#include <shiva/sfml/common/lua_resource_id.hpp>
 
 namespace shiva::plugins
 {
@@ -62,7 +63,7 @@ namespace shiva::plugins
                                                                                    unsigned int nb_columns,
                                                                                    unsigned int nb_lines,
                                                                                    unsigned int nb_anims,
-                                                                                   const char *texture) noexcept;
+                                                                                   shiva::sfml::resource_id texture) noexcept;
 
         status_t get_status(entt::entity_registry::entity_type entity) const noexcept;
 
@@ -100,11 +101,12 @@ namespace shiva::plugins
                                   unsigned int nb_columns,
                                   unsigned int nb_lines,
                                   unsigned int nb_anims,
-                                  const char *texture_name,
+                                  shiva::sfml::resource_id texture_id,
                                   float pos_x = 0.0f,
                                   float pos_y = 0.0f) noexcept;
 
         //! Private data members
         sol::state *state_{nullptr};
+        shiva::lua::plugin_bindings bindings_; //!< removed with the system, before the plugin is unloaded
     };
 }
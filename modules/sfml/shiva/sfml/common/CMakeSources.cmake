@@ -5,6 +5,11 @@ set(MODULE_PUBLIC_HEADERS
         "${MODULE_PATH}/animation_component_impl.hpp"
         "${MODULE_PATH}/drawable_component_impl.hpp"
         "${MODULE_PATH}/animation_config.hpp"
+        "${MODULE_PATH}/texture_region.hpp"
+        "${MODULE_PATH}/resource_id.hpp"
+        "${MODULE_PATH}/lua_resource_id.hpp"
+        "${MODULE_PATH}/compiled_config.hpp"
+        "${MODULE_PATH}/cooked_image.hpp"
         )
 
 set(MODULE_PRIVATE_HEADERS
@@ -26,5 +26,6 @@ namespace shiva::sfml
         status current_status; //!< status of the animation
         size_t current_frame; //!< current frame of the animation
         std::vector<sf::IntRect> frames; //!< array of frames.
+        sf::IntRect sheet; //!< area of the sprite sheet in his texture (sub-rect of an atlas page).
     };
 }
@@ -6,7 +6,9 @@
 
 #include <string>
 #include <shiva/json/json.hpp>
+#include <shiva/reflection/reflection.hpp>
 #include "animation_component_impl.hpp"
+#include "resource_id.hpp"
 
 namespace shiva::sfml
 {
@@ -21,8 +23,24 @@ namespace shiva::sfml
         unsigned int lines{0};
         unsigned int nb_anims{0};
         std::string texture{"none"};
+        resource_id texture_id{"none"}; //!< hashed texture, interned when the config is parsed.
         float pos_x{0.0f};
         float pos_y{0.0f};
+
+        //! \note schema of the compiled config, texture_id is interned from texture after the loading
+        static constexpr auto reflected_members() noexcept
+        {
+            return meta::makeMap(reflect_member(&animation_config::status),
+                                 reflect_member(&animation_config::speed),
+                                 reflect_member(&animation_config::loop),
+                                 reflect_member(&animation_config::repeat),
+                                 reflect_member(&animation_config::columns),
+                                 reflect_member(&animation_config::lines),
+                                 reflect_member(&animation_config::nb_anims),
+                                 reflect_member(&animation_config::texture),
+                                 reflect_member(&animation_config::pos_x),
+                                 reflect_member(&animation_config::pos_y));
+        }
     };
 
     inline void to_json(shiva::json::json &j, const animation_config &cfg)
@@ -49,6 +67,7 @@ namespace shiva::sfml
         cfg.lines = j.at("nb_lines").get<unsigned int>();
         cfg.nb_anims = j.at("nb_anims");
         cfg.texture = j.at("texture").get<std::string>();
+        cfg.texture_id = resource_id::intern(cfg.texture);
         cfg.pos_x = j.at("pos_x").get<float>();
         cfg.pos_y = j.at("pos_y").get<float>();
     }
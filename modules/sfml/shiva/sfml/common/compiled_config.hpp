@@ -0,0 +1,183 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+#include <system_error>
+#include <shiva/json/json.hpp>
+#include <shiva/filesystem/filesystem.hpp>
+#include <shiva/reflection/binary_serialization.hpp>
+
+/**
+ * \note The JSON configs stay the authoring format, each of them is compiled to the binary form of its
+ * reflected members (shiva/reflection/binary_serialization.hpp) in the cache directory.
+ * \note A compiled config is read with a single read and no parsing, it is compiled again
+ * as soon as the size or the modification time of its JSON changes, or when the schema of the type changes.
+ * \note layout: [magic "SHIVACFG"] [version] [schema hash] [size of the JSON] [modification time of the JSON] [members]
+ */
+namespace shiva::sfml::compiled_config
+{
+    inline constexpr char magic[8] = {'S', 'H', 'I', 'V', 'A', 'C', 'F', 'G'};
+    inline constexpr std::uint32_t version = 1u;
+
+    struct header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t padding;
+        std::uint64_t schema;
+        std::uint64_t source_size;
+        std::int64_t source_mtime;
+    };
+
+    inline shiva::fs::path cache_directory() noexcept
+    {
+        return shiva::fs::current_path() / "cache" / "configs";
+    }
+
+    //! \return the compiled file of a JSON config: cache/configs/<hash of the absolute path>.shivacfg
+    inline shiva::fs::path compiled_path(const shiva::fs::path &json_path) noexcept
+    {
+        std::error_code ec;
+        const auto absolute = json_path.is_absolute() ? json_path : shiva::fs::current_path(ec) / json_path;
+        std::uint64_t hash = 14695981039346656037ull;
+        for (auto c : absolute.generic_string()) {
+            hash = (hash ^ static_cast<std::uint8_t>(c)) * 1099511628211ull;
+        }
+        char name[32] = {};
+        std::snprintf(name, sizeof(name), "%016llx.shivacfg", static_cast<unsigned long long>(hash));
+        return cache_directory() / name;
+    }
+
+    template <typename T>
+    header make_header(std::uint64_t source_size, std::int64_t source_mtime) noexcept
+    {
+        header res{};
+        std::memcpy(res.magic, magic, sizeof(magic));
+        res.version = version;
+        res.schema = shiva::refl::schema_hash<T>();
+        res.source_size = source_size;
+        res.source_mtime = source_mtime;
+        return res;
+    }
+
+    //! \return true if data is a compiled config of T
+    template <typename T>
+    bool is_compiled(std::string_view data) noexcept
+    {
+        header current{};
+        if (data.size() < sizeof(header)) {
+            return false;
+        }
+        std::memcpy(&current, data.data(), sizeof(header));
+        return std::memcmp(current.magic, magic, sizeof(magic)) == 0 && current.version == version &&
+               current.schema == shiva::refl::schema_hash<T>();
+    }
+
+    //! \return the binary form of cfg, with a header describing the JSON it has been compiled from
+    template <typename T>
+    std::string compile(const T &cfg, std::uint64_t source_size = 0u, std::int64_t source_mtime = 0) noexcept
+    {
+        const auto current = make_header<T>(source_size, source_mtime);
+        std::string data(reinterpret_cast<const char *>(&current), sizeof(header));
+        shiva::refl::to_binary(cfg, data);
+        return data;
+    }
+
+    /**
+     * \note the file is written aside then renamed, an interrupted write leaves the previous file.
+     * \return false if the file can't be written
+     */
+    inline bool write_file(const shiva::fs::path &path, std::string_view data) noexcept
+    {
+        std::error_code ec;
+        shiva::fs::create_directories(path.parent_path(), ec);
+        auto tmp_path = path;
+        tmp_path += ".tmp";
+        {
+            std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+            if (!ofs.is_open() || !ofs.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+                ofs.close();
+                shiva::fs::remove(tmp_path, ec);
+                return false;
+            }
+        }
+        shiva::fs::rename(tmp_path, path, ec);
+        return !ec;
+    }
+
+    /**
+     * \note a compiled config (cooked archives) or a JSON config.
+     * \throw nlohmann::json::exception if the JSON is invalid
+     */
+    template <typename T>
+    bool load_from_memory(std::string_view data, T &cfg)
+    {
+        if (is_compiled<T>(data)) {
+            data.remove_prefix(sizeof(header));
+            return shiva::refl::from_binary(data, cfg);
+        }
+        cfg = shiva::json::json::parse(data.begin(), data.end());
+        return true;
+    }
+
+    /**
+     * \note load the compiled form of the JSON config if it is up to date, otherwise parse the JSON
+     * and compile it. A compiled config without its JSON (stripped build) is loaded as is.
+     * \throw nlohmann::json::exception if the JSON is invalid
+     * \return false if neither the JSON nor its compiled form exist
+     */
+    template <typename T>
+    bool load(const shiva::fs::path &json_path, T &cfg)
+    {
+        std::error_code ec;
+        const auto source_size = static_cast<std::uint64_t>(shiva::fs::file_size(json_path, ec));
+        const bool has_source = !ec;
+        const auto source_mtime = has_source ?
+                                  static_cast<std::int64_t>(shiva::fs::last_write_time(json_path, ec)
+                                      .time_since_epoch().count()) : 0;
+        const auto compiled = compiled_path(json_path);
+        if (std::ifstream ifs(compiled, std::ios::binary); ifs.is_open()) {
+            const std::string data(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>{});
+            if (is_compiled<T>(data)) {
+                header current{};
+                std::memcpy(&current, data.data(), sizeof(header));
+                std::string_view members(data);
+                members.remove_prefix(sizeof(header));
+                if ((!has_source || (current.source_size == source_size && current.source_mtime == source_mtime)) &&
+                    shiva::refl::from_binary(members, cfg)) {
+                    return true;
+                }
+            }
+        }
+        if (!has_source) {
+            return false;
+        }
+        std::ifstream ifs(json_path);
+        if (!ifs.is_open()) {
+            return false;
+        }
+        shiva::json::json j;
+        ifs >> j;
+        cfg = j;
+        //! the config is loaded even if the cache can't be written, it is compiled again at the next load
+        write_file(compiled, compile(cfg, source_size, source_mtime));
+        return true;
+    }
+
+    //! \note write the JSON config (authoring format), its compiled form is refreshed at the next load
+    template <typename T>
+    bool save(const shiva::fs::path &json_path, const T &cfg)
+    {
+        shiva::json::json j = cfg;
+        return write_file(json_path, j.dump(4) + "\n");
+    }
+}
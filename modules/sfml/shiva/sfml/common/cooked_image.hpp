@@ -0,0 +1,64 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <SFML/Graphics/Image.hpp>
+
+/**
+ * \note Runtime form of the images cooked by shiva-asset-cook: the decoded RGBA pixels behind a small header,
+ * loading them is a copy instead of a PNG/JPG decoding (the archive compresses them with LZ4).
+ * \note layout: [magic "SHIVAIMG"] [width] [height] [width * height * 4 bytes of pixels]
+ */
+namespace shiva::sfml::cooked_image
+{
+    inline constexpr char magic[8] = {'S', 'H', 'I', 'V', 'A', 'I', 'M', 'G'};
+
+    struct header
+    {
+        char magic[8];
+        std::uint32_t width;
+        std::uint32_t height;
+    };
+
+    inline std::string cook(const sf::Image &image) noexcept
+    {
+        header current{};
+        std::memcpy(current.magic, magic, sizeof(magic));
+        current.width = image.getSize().x;
+        current.height = image.getSize().y;
+        std::string data(reinterpret_cast<const char *>(&current), sizeof(header));
+        const auto nb_bytes = static_cast<std::size_t>(current.width) * current.height * 4u;
+        if (nb_bytes != 0u) {
+            data.append(reinterpret_cast<const char *>(image.getPixelsPtr()), nb_bytes);
+        }
+        return data;
+    }
+
+    inline bool is_cooked(std::string_view data) noexcept
+    {
+        return data.size() >= sizeof(header) && std::memcmp(data.data(), magic, sizeof(magic)) == 0;
+    }
+
+    //! \return false if data is not a cooked image or is truncated
+    inline bool load(std::string_view data, sf::Image &image) noexcept
+    {
+        if (!is_cooked(data)) {
+            return false;
+        }
+        header current{};
+        std::memcpy(&current, data.data(), sizeof(header));
+        const auto nb_bytes = static_cast<std::size_t>(current.width) * current.height * 4u;
+        if (data.size() - sizeof(header) < nb_bytes) {
+            return false;
+        }
+        image.create(current.width, current.height,
+                     reinterpret_cast<const sf::Uint8 *>(data.data() + sizeof(header)));
+        return true;
+    }
+}
@@ -0,0 +1,68 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <shiva/lua/lua_helpers.hpp>
+#include <shiva/sfml/common/resource_id.hpp>
+
+/**
+ * \note resource_id in lua: a function taking a resource_id accepts the name of the resource (hashed at the call)
+ * or the integer returned by shiva.resource_id(name), which should be kept by the hot paths of the scripts.
+ * \note a resource_id is pushed as an integer.
+ */
+namespace sol
+{
+    template <>
+    struct lua_type_of<shiva::sfml::resource_id> : std::integral_constant<sol::type, sol::type::poly>
+    {
+    };
+
+    namespace stack
+    {
+        template <>
+        struct checker<shiva::sfml::resource_id>
+        {
+            template <typename Handler>
+            static bool check(lua_State *L, int index, Handler &&handler, record &tracking)
+            {
+                tracking.use(1);
+                const auto type = sol::type_of(L, index);
+                if (type == sol::type::string || type == sol::type::number) {
+                    return true;
+                }
+                handler(L, index, sol::type::string, type);
+                return false;
+            }
+        };
+
+        template <>
+        struct getter<shiva::sfml::resource_id>
+        {
+            static shiva::sfml::resource_id get(lua_State *L, int index, record &tracking)
+            {
+                tracking.use(1);
+                if (lua_type(L, index) == LUA_TNUMBER) {
+                    return shiva::sfml::resource_id::from_value(
+                        static_cast<shiva::sfml::resource_id::hash_type>(lua_tointeger(L, index)));
+                }
+                std::size_t size = 0u;
+                const char *name = lua_tolstring(L, index, &size);
+                //! interned, shiva.resource_name (and the logs) know the names coming from the scripts,
+                //! only the first conversion of a name takes the table for writing
+                return shiva::sfml::resource_id::intern(std::string_view(name, size));
+            }
+        };
+
+        template <>
+        struct pusher<shiva::sfml::resource_id>
+        {
+            static int push(lua_State *L, const shiva::sfml::resource_id &id)
+            {
+                lua_pushinteger(L, static_cast<lua_Integer>(id.value()));
+                return 1;
+            }
+        };
+    }
+}
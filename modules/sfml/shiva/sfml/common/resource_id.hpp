@@ -0,0 +1,158 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <cassert>
+#include <mutex>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace shiva::sfml
+{
+    /**
+     * \note Identifier of a resource: the 64 bits FNV-1a hash of its name ("game_scene/toto").
+     * \note The hash is computed at compile time for the literals (_rid), once at load time for the names
+     * of the files, the lookups in the caches are integer compares.
+     * \note The names are kept in an interned reverse table (intern/name) for the debug output,
+     * the table is per binary: each plugin only knows the names it interned itself.
+     * \class resource_id
+     */
+    class resource_id
+    {
+    public:
+        //! Public typedefs
+        using hash_type = std::uint64_t;
+
+        //! Constructors
+        constexpr resource_id() noexcept = default;
+
+        constexpr resource_id(std::string_view name) noexcept : hash_(hash(name))
+        {
+        }
+
+        constexpr resource_id(const char *name) noexcept : resource_id(std::string_view(name))
+        {
+        }
+
+        resource_id(const std::string &name) noexcept : resource_id(std::string_view(name))
+        {
+        }
+
+        //! Public static functions
+        static constexpr resource_id from_value(hash_type value) noexcept
+        {
+            resource_id id;
+            id.hash_ = value;
+            return id;
+        }
+
+        static constexpr hash_type hash(std::string_view name) noexcept
+        {
+            hash_type res = 14695981039346656037ull;
+            for (const char c : name) {
+                res = (res ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+            }
+            return res;
+        }
+
+        /**
+         * \note hash the name and keep it in the reverse table, thread safe.
+         * \note a name already interned only costs a lookup under a shared lock, the table is locked for writing
+         * the first time a name is seen.
+         */
+        static resource_id intern(std::string_view name)
+        {
+            const resource_id id(name);
+            auto &table = table_();
+            {
+                std::shared_lock lock(table.mutex);
+                if (const auto it = table.names.find(id.hash_); it != table.names.end()) {
+                    assert(it->second == name && "resource_id collision");
+                    return id;
+                }
+            }
+            std::unique_lock lock(table.mutex);
+            auto[it, inserted] = table.names.try_emplace(id.hash_, name);
+            assert((inserted || it->second == name) && "resource_id collision");
+            (void) inserted;
+            (void) it;
+            return id;
+        }
+
+        //! Public member functions
+        constexpr hash_type value() const noexcept
+        {
+            return hash_;
+        }
+
+        /**
+         * \return the interned name of the resource, "<unknown>" if the name has not been interned in this binary
+         */
+        std::string_view name() const noexcept
+        {
+            auto &table = table_();
+            std::shared_lock lock(table.mutex);
+            const auto it = table.names.find(hash_);
+            return it != table.names.end() ? std::string_view(it->second) : std::string_view("<unknown>");
+        }
+
+        constexpr bool operator==(const resource_id &other) const noexcept
+        {
+            return hash_ == other.hash_;
+        }
+
+        constexpr bool operator!=(const resource_id &other) const noexcept
+        {
+            return hash_ != other.hash_;
+        }
+
+        constexpr bool operator<(const resource_id &other) const noexcept
+        {
+            return hash_ < other.hash_;
+        }
+
+    private:
+        //! Private typedefs
+        struct interned_table
+        {
+            std::shared_mutex mutex;
+            std::unordered_map<hash_type, std::string> names;
+        };
+
+        //! Private static functions
+        static interned_table &table_() noexcept
+        {
+            static interned_table table;
+            return table;
+        }
+
+        //! Private data members
+        hash_type hash_{hash({})};
+    };
+
+    namespace literals
+    {
+        //! \note compile time id: "game_scene/toto"_rid
+        constexpr resource_id operator ""_rid(const char *name, std::size_t size) noexcept
+        {
+            return resource_id(std::string_view(name, size));
+        }
+    }
+}
+
+namespace std
+{
+    template <>
+    struct hash<shiva::sfml::resource_id>
+    {
+        size_t operator()(const shiva::sfml::resource_id &id) const noexcept
+        {
+            return static_cast<size_t>(id.value());
+        }
+    };
+}
@@ -0,0 +1,20 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+namespace shiva::sfml
+{
+    /**
+     * \note area of a texture resource: the whole texture, or a sub-rect of an atlas page.
+     */
+    struct texture_region
+    {
+        const sf::Texture *texture{nullptr};
+        sf::IntRect rect;
+    };
+}
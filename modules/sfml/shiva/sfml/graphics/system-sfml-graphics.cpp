@@ -9,6 +9,9 @@
 #include <shiva/sfml/graphics/system-sfml-graphics.hpp>
 #include <shiva/filesystem/filesystem.hpp>
 #include <shiva/sfml/common/drawable_component_impl.hpp>
+#include <shiva/sfml/common/texture_region.hpp>
+#include <shiva/sfml/common/lua_resource_id.hpp>
+#include <shiva/sfml/common/compiled_config.hpp>
 #include "system-sfml-graphics.hpp"
 
 namespace shiva::plugins
@@ -16,13 +19,9 @@ namespace shiva::plugins
     //! Destructor
     render_system::~render_system() noexcept
     {
-        std::string cfg_str = (shiva::fs::current_path() / "assets/cfg/sfml_config.json").string();
-        std::ofstream o(cfg_str, std::ofstream::trunc);
-        if (o.is_open()) {
-            shiva::json::json j;
-            j = cfg_;
-            o << std::setw(4) << j << std::endl;
-            o.close();
+        //! the JSON is only written again when the configuration changed during the game.
+        if (shiva::refl::to_binary(cfg_) != shiva::refl::to_binary(saved_cfg_)) {
+            shiva::sfml::compiled_config::save(shiva::fs::current_path() / "assets/cfg/sfml_config.json", cfg_);
         }
         ImGui::SFML::Shutdown();
     }
@@ -126,25 +125,19 @@ namespace shiva::plugins
     //! Private member functions
     void render_system::reload_json_configuration_() noexcept
     {
-        std::string cfg_str = (shiva::fs::current_path() / "assets/cfg/sfml_config.json").string();
-        shiva::json::json j;
-        if (!shiva::fs::exists(cfg_str)) {
+        const auto cfg_path = shiva::fs::current_path() / "assets/cfg/sfml_config.json";
+        if (!shiva::fs::exists(cfg_path)) {
             std::error_code ec;
             shiva::fs::create_directories(shiva::fs::current_path() / "assets/cfg", ec);
             if (!ec) {
                 log_->warn("create_directory fail -> {}", ec.message());
             }
-            std::ofstream o(cfg_str);
-            if (o.is_open()) {
-                j = cfg_;
-                o << std::setw(4) << j << std::endl;
-                o.close();
-            }
+            shiva::sfml::compiled_config::save(cfg_path, cfg_);
+            saved_cfg_ = cfg_;
         } else {
-            std::ifstream i(cfg_str);
-            if (i.is_open()) {
-                i >> j;
-                cfg_ = j;
+            //! compiled form of the JSON, parsed again only when the JSON changed.
+            if (shiva::sfml::compiled_config::load(cfg_path, cfg_)) {
+                saved_cfg_ = cfg_;
 
                 //! Reset window
                 unsigned int style = sf::Style::Default;
@@ -177,7 +170,6 @@ namespace shiva::plugins
                 }
                 this->dispatcher_.trigger<shiva::event::window_config_update>(
                     std::make_tuple(cfg_.name, cfg_.size, cfg_.vsync, cfg_.fullscreen, cfg_.native_resolution));
-                i.close();
             }
         }
         ImGui::SFML::Init(win_);
@@ -195,28 +187,35 @@ namespace shiva::plugins
     {
         state_ = static_cast<sol::state *>(user_data_);
         assert(state_);
-        shiva::lua::register_type<render_system>(*state_, log_);
-        (*state_)[render_system::class_name()]["imgui_image_button"] = []([[maybe_unused]] render_system &self,
-                                                                          const char *texture_id) {
-            //toto
-            sol::table table = (*self.state_)["shiva"]["resource_registry"];
-            const sf::Texture &texture = table["get_texture_c"](table, texture_id);
-            return ImGui::ImageButton(texture);
-        };
+        //! bound the first time shiva.render is read
+        bindings_ = shiva::lua::register_plugin_bindings(*state_, "render", [this]() {
+            shiva::lua::register_type<render_system>(*state_, log_);
+            (*state_)[render_system::class_name()]["imgui_image_button"] = []([[maybe_unused]] render_system &self,
+                                                                              shiva::sfml::resource_id texture_id) {
+                sol::table table = (*self.state_)["shiva"]["resource_registry"];
+                const shiva::sfml::texture_region region = table["get_texture_region"](table, texture_id);
+                //! headless mode, there is no texture to draw
+                if (region.texture == nullptr) {
+                    return false;
+                }
+                return ImGui::ImageButton(sf::Sprite(*region.texture, region.rect));
+            };
 
-        (*state_)[render_system::class_name()]["get_texture_size"] = []([[maybe_unused]] render_system &self,
-                                                                        const char *texture_id) {
-            sol::table table = (*self.state_)["shiva"]["resource_registry"];
-            const sf::Texture &texture = table["get_texture_c"](table, texture_id);
-            return std::make_pair(texture.getSize().x, texture.getSize().y);
-        };
+            (*state_)[render_system::class_name()]["get_texture_size"] = []([[maybe_unused]] render_system &self,
+                                                                            shiva::sfml::resource_id texture_id) {
+                sol::table table = (*self.state_)["shiva"]["resource_registry"];
+                const shiva::sfml::texture_region region = table["get_texture_region"](table, texture_id);
+                return std::make_pair(static_cast<unsigned int>(region.rect.width),
+                                      static_cast<unsigned int>(region.rect.height));
+            };
 
             (*state_)[render_system::class_name()]["update_font"] = [this]([[maybe_unused]] render_system &self) {
                 this->log_->debug("updating fonts");
                 ImGui::SFML::UpdateFontTexture();
             };
 
-        (*state_)["shiva"]["render"] = this;
+            (*state_)["shiva"]["render"] = this;
+        });
     }
 }
 
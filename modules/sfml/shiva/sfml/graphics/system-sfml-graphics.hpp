@@ -50,7 +50,9 @@ namespace shiva::plugins
 
         //! Private data members
         sol::state* state_{nullptr};
+        shiva::lua::plugin_bindings bindings_; //!< removed with the system, before the plugin is unloaded
         shiva::sfml::window_config cfg_;
+        shiva::sfml::window_config saved_cfg_; //!< configuration as written in sfml_config.json
         sf::RenderWindow win_{sf::VideoMode(cfg_.size[0], cfg_.size[1]), cfg_.name};
 
         bool debug_draw_{false};
@@ -7,6 +7,7 @@
 #include <array>
 #include <string>
 #include <shiva/json/json.hpp>
+#include <shiva/reflection/reflection.hpp>
 
 namespace shiva::sfml
 {
@@ -18,6 +19,17 @@ namespace shiva::sfml
         bool fullscreen{false};
         bool native_resolution{false};
         bool borderless{false};
+
+        //! \note schema of the compiled config
+        static constexpr auto reflected_members() noexcept
+        {
+            return meta::makeMap(reflect_member(&window_config::name),
+                                 reflect_member(&window_config::size),
+                                 reflect_member(&window_config::vsync),
+                                 reflect_member(&window_config::fullscreen),
+                                 reflect_member(&window_config::native_resolution),
+                                 reflect_member(&window_config::borderless));
+        }
     };
 
     inline void to_json(shiva::json::json &j, const window_config &cfg)
@@ -10,6 +10,14 @@ set(MODULE_PUBLIC_HEADERS
         "${MODULE_PATH}/system-sfml-resources.hpp"
         "${MODULE_PATH}/sfml-resources-registry.hpp"
         "${MODULE_PATH}/entt-sfml-loader.hpp"
+        "${MODULE_PATH}/load_ticket.hpp"
+        "${MODULE_PATH}/texture_atlas.hpp"
+        "${MODULE_PATH}/resource_residency.hpp"
+        "${MODULE_PATH}/resource_cache.hpp"
+        "${MODULE_PATH}/resource_graph.hpp"
+        "${MODULE_PATH}/access_trace.hpp"
+        "${MODULE_PATH}/image_header.hpp"
+        "${MODULE_PATH}/sound_bank.hpp"
         )
 
 set(MODULE_PRIVATE_HEADERS
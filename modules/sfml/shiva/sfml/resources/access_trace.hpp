@@ -0,0 +1,152 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <optional>
+#include <unordered_set>
+#include <shiva/filesystem/filesystem.hpp>
+#include <shiva/sfml/resources/resource_graph.hpp>
+
+namespace shiva::sfml
+{
+    /**
+     * \note This class records the resources looked up by a scene during its first seconds, in the order of their
+     * first lookup, and keeps them in a trace file per scene (<directory>/<scene>.shivatrace) to prefetch them
+     * the next time the scene is entered.
+     * \note layout: one resource per line, [category] [id in hexadecimal] [virtual path]
+     * \note record can be called from any thread, the other functions from the main thread.
+     * \class access_trace
+     */
+    class access_trace
+    {
+    public:
+        //! Public typedefs
+        using clock = std::chrono::steady_clock;
+
+        struct entry
+        {
+            resource_key key;
+            std::string path;
+        };
+
+        //! Public member functions
+        void set_directory(shiva::fs::path directory) noexcept
+        {
+            directory_ = std::move(directory);
+        }
+
+        //! \param duration recording time after the scene is entered, 0 disables the recordings
+        void set_duration(std::chrono::milliseconds duration) noexcept
+        {
+            duration_ = duration;
+        }
+
+        //! \note the previous recording is dropped, save it before
+        void start(std::string scene) noexcept
+        {
+            std::scoped_lock lock(mutex_);
+            scene_ = std::move(scene);
+            keys_.clear();
+            seen_.clear();
+            start_ = clock::now();
+            recording_ = duration_.count() > 0;
+        }
+
+        bool is_recording() const noexcept
+        {
+            return recording_.load(std::memory_order_relaxed);
+        }
+
+        //! \return true if the recording time of the scene is over
+        bool is_expired() const noexcept
+        {
+            return is_recording() && clock::now() - start_ >= duration_;
+        }
+
+        void record(const resource_key &key) noexcept
+        {
+            if (!is_recording()) {
+                return;
+            }
+            std::scoped_lock lock(mutex_);
+            if (recording_ && seen_.insert(key).second) {
+                keys_.push_back(key);
+            }
+        }
+
+        /**
+         * \note stop the recording and write the trace of the scene.
+         * \tparam PathOf std::optional<std::string>(const resource_key &), the resources without path are skipped
+         * \return false if the trace can't be written
+         */
+        template <typename PathOf>
+        bool stop(PathOf &&path_of)
+        {
+            std::vector<resource_key> keys;
+            std::string scene;
+            {
+                std::scoped_lock lock(mutex_);
+                if (!recording_) {
+                    return true;
+                }
+                recording_ = false;
+                keys.swap(keys_);
+                scene = std::move(scene_);
+                seen_.clear();
+            }
+            std::error_code ec;
+            shiva::fs::create_directories(directory_, ec);
+            std::ofstream ofs(path_of_scene(scene), std::ios::trunc);
+            if (!ofs.is_open()) {
+                return false;
+            }
+            for (auto &&key : keys) {
+                if (auto path = path_of(key); path) {
+                    ofs << key.category << ' ' << std::hex << key.id.value() << std::dec << ' ' << *path << '\n';
+                }
+            }
+            return ofs.good();
+        }
+
+        //! \return the resources of the trace of the scene in the order of their first lookup, empty if there is none
+        std::vector<entry> load(const std::string &scene) const
+        {
+            std::vector<entry> entries;
+            std::ifstream ifs(path_of_scene(scene));
+            size_t category = 0u;
+            resource_id::hash_type id = 0u;
+            std::string path;
+            while (ifs >> category >> std::hex >> id >> std::dec && std::getline(ifs >> std::ws, path)) {
+                if (category < resources_stats::nb_categories) {
+                    entries.push_back(entry{resource_key{static_cast<resource_residency::category>(category),
+                                                         resource_id::from_value(id)}, path});
+                }
+            }
+            return entries;
+        }
+
+        shiva::fs::path path_of_scene(const std::string &scene) const
+        {
+            return directory_ / (scene + ".shivatrace");
+        }
+
+    private:
+        //! Private data members
+        shiva::fs::path directory_{shiva::fs::current_path() / "assets/traces"};
+        std::chrono::milliseconds duration_{5000};
+        std::atomic_bool recording_{false};
+        clock::time_point start_{};
+        std::string scene_;
+        std::vector<resource_key> keys_;
+        std::unordered_set<resource_key> seen_;
+        std::mutex mutex_;
+    };
+}
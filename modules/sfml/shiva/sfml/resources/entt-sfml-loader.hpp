@@ -6,9 +6,12 @@
 
 #include <fstream>
 #include <SFML/Audio.hpp>
+#include <SFML/Graphics/Image.hpp>
 #include <sfeMovie/Movie.hpp>
 #include <entt/resource/loader.hpp>
 #include <shiva/sfml/common/animation_config.hpp>
+#include <shiva/sfml/common/compiled_config.hpp>
+#include <shiva/sfml/common/cooked_image.hpp>
 
 namespace shiva::sfml
 {
@@ -24,6 +27,41 @@ namespace shiva::sfml
           }
           return resource_ptr;
         }
+
+        std::shared_ptr<ResourceType> load_from_memory(const void *data, std::size_t size) const
+        {
+          auto resource_ptr = std::make_shared<ResourceType>();
+          if (!resource_ptr->loadFromMemory(data, size)) {
+            throw std::runtime_error("Impossible to load resource from memory");
+          }
+          return resource_ptr;
+        }
+    };
+
+    template <>
+    struct loader<sf::Image> final : ::entt::resource_loader<loader<sf::Image>, sf::Image>
+    {
+        template <typename ... Args>
+        std::shared_ptr<sf::Image> load(Args &&...args) const
+        {
+          auto resource_ptr = std::make_shared<sf::Image>();
+          if (!resource_ptr->loadFromFile(std::forward<Args>(args)...)) {
+            throw std::runtime_error("Impossible to load file");
+          }
+          return resource_ptr;
+        }
+
+        //! \note an image cooked by shiva-asset-cook (raw pixels) or an encoded image (png, jpg...)
+        std::shared_ptr<sf::Image> load_from_memory(const void *data, std::size_t size) const
+        {
+          auto resource_ptr = std::make_shared<sf::Image>();
+          const std::string_view view(static_cast<const char *>(data), size);
+          if (cooked_image::is_cooked(view) ? !cooked_image::load(view, *resource_ptr)
+                                            : !resource_ptr->loadFromMemory(data, size)) {
+            throw std::runtime_error("Impossible to load resource from memory");
+          }
+          return resource_ptr;
+        }
     };
 
     template <>
@@ -38,6 +76,16 @@ namespace shiva::sfml
           }
           return resource_ptr;
         }
+
+        //! \note the music is streamed, data must stay valid as long as the music is alive.
+        std::shared_ptr<sf::Music> load_from_memory(const void *data, std::size_t size) const
+        {
+          auto resource_ptr = std::make_shared<sf::Music>();
+          if (!resource_ptr->openFromMemory(data, size)) {
+            throw std::runtime_error("Impossible to load resource from memory");
+          }
+          return resource_ptr;
+        }
     };
 
     template <>
@@ -57,17 +105,39 @@ namespace shiva::sfml
     template <>
     struct loader<animation_config> final : ::entt::resource_loader<loader<animation_config>, animation_config>
     {
+        //! \note the compiled form of the config is used when it is up to date with the JSON
         template <typename ... Args>
         std::shared_ptr<animation_config> load(const std::string &path) const
         {
           auto resource_ptr = std::make_shared<animation_config>();
-          std::ifstream ifs(path);
-          if (ifs.is_open()) {
-            shiva::json::json j;
-            ifs >> j;
-            *resource_ptr = j;
+          if (compiled_config::load(path, *resource_ptr)) {
+            resource_ptr->texture_id = resource_id::intern(resource_ptr->texture);
+          }
+          return resource_ptr;
+        }
+
+        std::shared_ptr<animation_config> load_from_memory(const void *data, std::size_t size) const
+        {
+          auto resource_ptr = std::make_shared<animation_config>();
+          if (!compiled_config::load_from_memory(std::string_view(static_cast<const char *>(data), size),
+                                                 *resource_ptr)) {
+            throw std::runtime_error("Impossible to load compiled config");
           }
+          resource_ptr->texture_id = resource_id::intern(resource_ptr->texture);
           return resource_ptr;
         }
     };
+
+    /**
+     * \note loader publishing an already decoded resource in a cache,
+     * used by the main thread to insert the resources decoded by the workers.
+     */
+    template <typename ResourceType>
+    struct shared_loader final : ::entt::resource_loader<shared_loader<ResourceType>, ResourceType>
+    {
+        std::shared_ptr<ResourceType> load(std::shared_ptr<ResourceType> resource) const
+        {
+          return resource;
+        }
+    };
 }
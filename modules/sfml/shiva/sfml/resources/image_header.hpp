@@ -0,0 +1,102 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <SFML/System/Vector2.hpp>
+#include <shiva/sfml/common/cooked_image.hpp>
+
+/**
+ * \note Dimensions of an image read from the first bytes of its file, without decoding the pixels:
+ * cooked images, PNG, JPEG, BMP, GIF and TGA (which has no signature, so only when the extension tells it).
+ */
+namespace shiva::sfml::image_header
+{
+    //! \note bytes enough for the headers, a JPEG may need more (metadata before its frame header)
+    inline constexpr std::size_t prefix_size = 64u * 1024u;
+
+    namespace details
+    {
+        inline std::uint32_t be16(std::string_view data, std::size_t offset) noexcept
+        {
+            return static_cast<std::uint32_t>(static_cast<unsigned char>(data[offset]) << 8u |
+                                              static_cast<unsigned char>(data[offset + 1]));
+        }
+
+        inline std::uint32_t be32(std::string_view data, std::size_t offset) noexcept
+        {
+            return be16(data, offset) << 16u | be16(data, offset + 2);
+        }
+
+        inline std::uint32_t le16(std::string_view data, std::size_t offset) noexcept
+        {
+            return static_cast<std::uint32_t>(static_cast<unsigned char>(data[offset]) |
+                                              static_cast<unsigned char>(data[offset + 1]) << 8u);
+        }
+
+        inline std::uint32_t le32(std::string_view data, std::size_t offset) noexcept
+        {
+            return le16(data, offset) | le16(data, offset + 2) << 16u;
+        }
+
+        //! \note walks the segments until the frame header (SOF0 to SOF15, except DHT, JPG and DAC)
+        inline std::optional<sf::Vector2u> jpeg_size(std::string_view data) noexcept
+        {
+            std::size_t offset = 2u;
+            while (offset + 9u <= data.size()) {
+                if (static_cast<unsigned char>(data[offset]) != 0xFF) {
+                    return std::nullopt;
+                }
+                const auto marker = static_cast<unsigned char>(data[offset + 1]);
+                if (marker == 0xFF) {
+                    ++offset;
+                    continue;
+                }
+                if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+                    return sf::Vector2u(be16(data, offset + 7), be16(data, offset + 5));
+                }
+                offset += 2u + be16(data, offset + 2);
+            }
+            return std::nullopt;
+        }
+    }
+
+    /**
+     * \param data first bytes of the file (prefix_size is enough for most of them)
+     * \param extension extension of the file (".tga"), used for the formats without signature
+     * \return the dimensions of the image, std::nullopt if the format is unknown or the data too short
+     */
+    inline std::optional<sf::Vector2u> read_size(std::string_view data, std::string_view extension = {}) noexcept
+    {
+        using namespace details;
+        if (cooked_image::is_cooked(data)) {
+            cooked_image::header current{};
+            std::memcpy(&current, data.data(), sizeof(current));
+            return sf::Vector2u(current.width, current.height);
+        }
+        if (data.size() >= 24u && data.compare(0, 8, "\x89PNG\r\n\x1a\n") == 0) {
+            return sf::Vector2u(be32(data, 16), be32(data, 20));
+        }
+        if (data.size() >= 4u && static_cast<unsigned char>(data[0]) == 0xFF &&
+            static_cast<unsigned char>(data[1]) == 0xD8) {
+            return jpeg_size(data);
+        }
+        if (data.size() >= 26u && data.compare(0, 2, "BM") == 0) {
+            const auto height = static_cast<std::int32_t>(le32(data, 22));
+            return sf::Vector2u(le32(data, 18), static_cast<std::uint32_t>(std::abs(height)));
+        }
+        if (data.size() >= 10u && (data.compare(0, 6, "GIF87a") == 0 || data.compare(0, 6, "GIF89a") == 0)) {
+            return sf::Vector2u(le16(data, 6), le16(data, 8));
+        }
+        if (data.size() >= 18u && (extension == ".tga" || extension == ".TGA")) {
+            return sf::Vector2u(le16(data, 12), le16(data, 14));
+        }
+        return std::nullopt;
+    }
+}
@@ -0,0 +1,97 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <vector>
+#include <functional>
+
+namespace shiva::sfml
+{
+    class resources_registry;
+
+    /**
+     * \note This class represents an asynchronous loading started by the resources_registry.
+     * \note The files are decoded by the workers, then inserted in the caches by the main thread
+     * (resources_registry::update), a ticket is ready once every file has been inserted,
+     * including the dependencies discovered during the loading (the texture of an animation config).
+     * \note The callbacks are always called from the main thread, during resources_registry::update.
+     * \class load_ticket
+     */
+    class load_ticket
+    {
+    public:
+        //! Public typedefs
+        using callback_t = std::function<void(const load_ticket &)>;
+
+        //! Public member functions
+
+        /**
+         * \return true if every resource of the ticket is available in the caches, false otherwise
+         */
+        bool is_ready() const noexcept
+        {
+          return nb_decoding_batches_ == 0u && nb_pending_jobs_ == 0u;
+        }
+
+        /**
+         * \return false if at least one file failed to load
+         */
+        bool succeeded() const noexcept
+        {
+          return !failed_;
+        }
+
+        /**
+         * \return percentage of files loaded [0, 1]
+         */
+        float progress() const noexcept
+        {
+          const auto nb_files = nb_files_.load();
+          return nb_files == 0u ? static_cast<float>(is_ready()) : static_cast<float>(nb_loaded_) / nb_files;
+        }
+
+        unsigned int get_nb_files() const noexcept
+        {
+          return nb_files_;
+        }
+
+        unsigned int get_nb_loaded() const noexcept
+        {
+          return nb_loaded_;
+        }
+
+        /**
+         * \return future which becomes ready once the workers have decoded every file of the ticket
+         */
+        const std::shared_future<void> &get_decoding_future() const noexcept
+        {
+          return decoding_future_;
+        }
+
+        /**
+         * \note register a functor called once the ticket is ready, immediately called by the next update
+         * if the ticket is already ready.
+         */
+        void on_ready(callback_t callback) noexcept
+        {
+          callbacks_.push_back(std::move(callback));
+        }
+
+    private:
+        friend class resources_registry;
+
+        //! Private data members
+        std::atomic_uint32_t nb_files_{0u};
+        std::atomic_uint32_t nb_loaded_{0u};
+        std::atomic_uint32_t nb_pending_jobs_{0u};
+        std::atomic_uint32_t nb_decoding_batches_{0u}; //!< the dependencies found while decoding add batches.
+        std::atomic_bool failed_{false};
+        std::shared_future<void> decoding_future_;
+        std::vector<callback_t> callbacks_;
+        bool trigger_event_{true};
+    };
+}
@@ -0,0 +1,262 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <shiva/sfml/common/resource_id.hpp>
+
+namespace shiva::sfml
+{
+    /**
+     * \note Cache of the resources of one type, indexed by resource_id, safe to read from any thread
+     * while the resources are loaded and unloaded.
+     * \note Same interface as the EnTT resource cache, find gives the resource with a single integer lookup.
+     * \note The reads are lock-free: the resources are spread in buckets which are never modified once published,
+     * a writer (serialized by the mutex of the cache) publishes a modified copy of the bucket and destroys the old one
+     * after a grace period, when no reader started before the publication is still reading it.
+     * \note The resources are shared: a handle keeps its resource alive after a concurrent discard,
+     * the pointer returned by find is only valid until the resource is discarded.
+     * \class resource_cache
+     */
+    template <typename Resource>
+    class resource_cache
+    {
+    public:
+        //! Public typedefs
+        using resource_type = resource_id;
+        using size_type = std::size_t;
+        using handle_type = std::shared_ptr<Resource>;
+
+        //! Constructors
+        resource_cache() noexcept = default;
+
+        resource_cache(const resource_cache &) = delete;
+
+        resource_cache &operator=(const resource_cache &) = delete;
+
+        //! Destructor
+        ~resource_cache() noexcept
+        {
+            for (auto &&current : buckets_) {
+                delete current.load();
+            }
+        }
+
+        //! Public member functions
+
+        /**
+         * \note the resource is kept if the id is already in the cache, the loader runs outside of the lock.
+         * \return false if the loader didn't give any resource, true otherwise
+         */
+        template <typename Loader, typename ... Args>
+        bool load(resource_id id, Args &&...args)
+        {
+            if (contains(id)) {
+                return true;
+            }
+            handle_type resource = Loader{}.load(std::forward<Args>(args)...);
+            if (!resource) {
+                return false;
+            }
+            insert_(id, std::move(resource), false);
+            return true;
+        }
+
+        //! \note insert the resource, or replace the resource of the id
+        void assign(resource_id id, handle_type resource)
+        {
+            insert_(id, std::move(resource), true);
+        }
+
+        void discard(resource_id id)
+        {
+            std::scoped_lock lock(write_mutex_);
+            auto &current = buckets_[index_(id)];
+            const bucket *old = current.load();
+            if (old == nullptr || find_(*old, id) == nullptr) {
+                return;
+            }
+            auto copy = std::make_unique<bucket>();
+            std::copy_if(old->begin(), old->end(), std::back_inserter(*copy), [id](auto &&entry) {
+                return entry.first != id;
+            });
+            publish_(current, std::move(copy));
+            --size_;
+        }
+
+        /**
+         * \note discard every resource for which the predicate returns true, with a single grace period.
+         * \tparam Predicate bool(resource_id, const Resource &)
+         * \return number of discarded resources
+         */
+        template <typename Predicate>
+        size_type discard_if(Predicate &&predicate)
+        {
+            std::scoped_lock lock(write_mutex_);
+            std::vector<std::unique_ptr<const bucket>> retired;
+            size_type nb_discarded = 0u;
+            for (auto &&current : buckets_) {
+                const bucket *old = current.load();
+                if (old == nullptr) {
+                    continue;
+                }
+                auto copy = std::make_unique<bucket>();
+                for (auto &&entry : *old) {
+                    if (!predicate(entry.first, std::as_const(*entry.second))) {
+                        copy->push_back(entry);
+                    }
+                }
+                if (copy->size() != old->size()) {
+                    nb_discarded += old->size() - copy->size();
+                    retired.emplace_back(current.exchange(copy.release()));
+                }
+            }
+            if (!retired.empty()) {
+                synchronize_();
+            }
+            size_ -= nb_discarded;
+            return nb_discarded;
+        }
+
+        bool contains(resource_id id) const noexcept
+        {
+            read_guard guard(*this);
+            const bucket *current = buckets_[index_(id)].load();
+            return current != nullptr && find_(*current, id) != nullptr;
+        }
+
+        //! \return the resource, nullptr if the id is not in the cache
+        Resource *find(resource_id id) const noexcept
+        {
+            read_guard guard(*this);
+            const bucket *current = buckets_[index_(id)].load();
+            const auto *entry = current != nullptr ? find_(*current, id) : nullptr;
+            return entry != nullptr ? entry->second.get() : nullptr;
+        }
+
+        //! \return a handle keeping the resource alive, nullptr if the id is not in the cache
+        handle_type handle(resource_id id) const noexcept
+        {
+            read_guard guard(*this);
+            const bucket *current = buckets_[index_(id)].load();
+            const auto *entry = current != nullptr ? find_(*current, id) : nullptr;
+            return entry != nullptr ? entry->second : nullptr;
+        }
+
+        size_type size() const noexcept
+        {
+            return size_.load();
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0u;
+        }
+
+        void clear()
+        {
+            discard_if([](auto &&...) {
+                return true;
+            });
+        }
+
+    private:
+        //! Private typedefs
+        using entry_type = std::pair<resource_id, handle_type>;
+        using bucket = std::vector<entry_type>; //!< sorted by id
+
+        static constexpr size_type nb_buckets = 64u;
+
+        //! \note the counter of the parity of the epoch is held while reading
+        class read_guard
+        {
+        public:
+            explicit read_guard(const resource_cache &cache) noexcept :
+                counter_(cache.readers_[cache.epoch_.load() & 1u])
+            {
+                counter_.fetch_add(1u);
+            }
+
+            ~read_guard() noexcept
+            {
+                counter_.fetch_sub(1u, std::memory_order_release);
+            }
+
+        private:
+            std::atomic_uint32_t &counter_;
+        };
+
+        //! Private member functions
+        static size_type index_(resource_id id) noexcept
+        {
+            const auto value = id.value();
+            return static_cast<size_type>(value ^ (value >> 32u)) & (nb_buckets - 1u);
+        }
+
+        static const entry_type *find_(const bucket &current, resource_id id) noexcept
+        {
+            auto it = std::lower_bound(current.begin(), current.end(), id, [](auto &&entry, resource_id value) {
+                return entry.first < value;
+            });
+            return it != current.end() && it->first == id ? &*it : nullptr;
+        }
+
+        void insert_(resource_id id, handle_type resource, bool replace)
+        {
+            std::scoped_lock lock(write_mutex_);
+            auto &current = buckets_[index_(id)];
+            const bucket *old = current.load();
+            auto copy = old != nullptr ? std::make_unique<bucket>(*old) : std::make_unique<bucket>();
+            auto it = std::lower_bound(copy->begin(), copy->end(), id, [](auto &&entry, resource_id value) {
+                return entry.first < value;
+            });
+            if (it != copy->end() && it->first == id) {
+                if (!replace) {
+                    return;
+                }
+                it->second = std::move(resource);
+            } else {
+                copy->emplace(it, id, std::move(resource));
+                ++size_;
+            }
+            publish_(current, std::move(copy));
+        }
+
+        //! \note writer only, the old bucket is destroyed once no reader can see it
+        void publish_(std::atomic<const bucket *> &current, std::unique_ptr<bucket> copy)
+        {
+            std::unique_ptr<const bucket> old(current.exchange(copy.release()));
+            synchronize_();
+        }
+
+        /**
+         * \note grace period: the new readers take the other counter, the readers of the previous one are waited,
+         * twice so that a reader which read the epoch before the flip is also waited.
+         */
+        void synchronize_() const noexcept
+        {
+            for (int idx = 0; idx < 2; ++idx) {
+                const auto parity = epoch_.fetch_add(1u) & 1u;
+                while (readers_[parity].load() != 0u) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        //! Private data members
+        std::array<std::atomic<const bucket *>, nb_buckets> buckets_{};
+        mutable std::atomic_uint64_t epoch_{0u};
+        mutable std::array<std::atomic_uint32_t, 2> readers_{};
+        std::atomic<size_type> size_{0u};
+        std::mutex write_mutex_;
+    };
+}
@@ -0,0 +1,143 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <shiva/sfml/common/resource_id.hpp>
+#include <shiva/sfml/resources/resource_residency.hpp>
+
+namespace shiva::sfml
+{
+    //! \note a resource of a given kind, two kinds of resource can share the same id ("game_scene/kirito")
+    struct resource_key
+    {
+        resource_residency::category category;
+        resource_id id;
+
+        bool operator==(const resource_key &other) const noexcept
+        {
+            return category == other.category && id == other.id;
+        }
+    };
+}
+
+namespace std
+{
+    template <>
+    struct hash<shiva::sfml::resource_key>
+    {
+        size_t operator()(const shiva::sfml::resource_key &key) const noexcept
+        {
+            return static_cast<size_t>(key.id.value() ^ (static_cast<std::uint64_t>(key.category) << 59u));
+        }
+    };
+}
+
+namespace shiva::sfml
+{
+    /**
+     * \note This class keeps the dependencies between the resources (an animation config depends on its texture),
+     * they are discovered when the resources are decoded.
+     * \note Main thread only.
+     * \class resource_graph
+     */
+    class resource_graph
+    {
+    public:
+        //! Public member functions
+        void add_dependency(const resource_key &dependent, const resource_key &dependency) noexcept
+        {
+            auto &dependencies = dependencies_[dependent];
+            if (std::find(dependencies.begin(), dependencies.end(), dependency) != dependencies.end()) {
+                return;
+            }
+            dependencies.push_back(dependency);
+            nb_dependents_[dependency]++;
+        }
+
+        const std::vector<resource_key> &dependencies_of(const resource_key &key) const noexcept
+        {
+            static const std::vector<resource_key> empty;
+            const auto it = dependencies_.find(key);
+            return it != dependencies_.end() ? it->second : empty;
+        }
+
+        bool has_dependents(const resource_key &key) const noexcept
+        {
+            const auto it = nb_dependents_.find(key);
+            return it != nb_dependents_.end() && it->second > 0u;
+        }
+
+        /**
+         * \note remove the outgoing edges of the resource (it is unloaded).
+         * \return the dependencies of the resource which are no longer needed by any other resource
+         */
+        std::vector<resource_key> remove(const resource_key &key) noexcept
+        {
+            return replace_dependencies(key, {});
+        }
+
+        /**
+         * \note replace the outgoing edges of the resource (it is reloaded), a dependency kept is not orphaned.
+         * \return the previous dependencies of the resource which are no longer needed by any other resource
+         */
+        std::vector<resource_key> replace_dependencies(const resource_key &key,
+                                                       const std::vector<resource_key> &dependencies) noexcept
+        {
+            std::vector<resource_key> previous;
+            if (auto it = dependencies_.find(key); it != dependencies_.end()) {
+                previous = std::move(it->second);
+                dependencies_.erase(it);
+            }
+            for (auto &&dependency : dependencies) {
+                add_dependency(key, dependency);
+            }
+            std::vector<resource_key> orphans;
+            for (auto &&dependency : previous) {
+                if (auto count_it = nb_dependents_.find(dependency); count_it != nb_dependents_.end() &&
+                                                                    --count_it->second == 0u) {
+                    nb_dependents_.erase(count_it);
+                    orphans.push_back(dependency);
+                }
+            }
+            return orphans;
+        }
+
+        /**
+         * \return the keys and their known dependencies (transitively), every dependency is placed before
+         * the resources depending on it, each key appears once.
+         */
+        std::vector<resource_key> load_order(const std::vector<resource_key> &keys) const noexcept
+        {
+            std::vector<resource_key> order;
+            std::unordered_set<resource_key> visited;
+            for (auto &&key : keys) {
+                visit_(key, visited, order);
+            }
+            return order;
+        }
+
+    private:
+        //! Private member functions
+        void visit_(const resource_key &key, std::unordered_set<resource_key> &visited,
+                    std::vector<resource_key> &order) const noexcept
+        {
+            if (!visited.insert(key).second) {
+                return;
+            }
+            for (auto &&dependency : dependencies_of(key)) {
+                visit_(dependency, visited, order);
+            }
+            order.push_back(key);
+        }
+
+        //! Private data members
+        std::unordered_map<resource_key, std::vector<resource_key>> dependencies_;
+        std::unordered_map<resource_key, std::size_t> nb_dependents_;
+    };
+}
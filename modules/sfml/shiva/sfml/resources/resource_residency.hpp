@@ -0,0 +1,236 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <shiva/sfml/common/resource_id.hpp>
+
+namespace shiva::sfml
+{
+    /**
+     * \note counters of the resources_registry, the bytes are estimations
+     * (pixels for the textures, samples for the sounds, file size for the others).
+     */
+    struct resources_stats
+    {
+        static constexpr size_t nb_categories = 6u;
+
+        std::array<size_t, nb_categories> bytes{};
+        std::array<size_t, nb_categories> count{};
+        size_t total_bytes{0u};
+        size_t budget{0u};
+        std::uint64_t hits{0u};
+        std::uint64_t misses{0u};
+        std::uint64_t evictions{0u};
+        std::uint64_t loaded{0u};
+        double load_time_ms{0.0};
+    };
+
+    /**
+     * \note This class keeps track of the resources living in the caches of the resources_registry:
+     * their memory, their last use and whether they are referenced by a live entity.
+     * \note When the memory is over the budget, the unreferenced resources are evicted by least recently used order,
+     * the resources used during the current frame, the held ones and the non evictable ones (atlas pages, stubs)
+     * are never evicted.
+     * \note Main thread only.
+     * \class resource_residency
+     */
+    class resource_residency
+    {
+    public:
+        //! Public enum, same order as the loaders of the resources_registry
+        enum category : size_t
+        {
+            texture,
+            music,
+            sound,
+            font,
+            anim_cfg,
+            video
+        };
+
+        //! Public typedefs
+        struct entry
+        {
+            size_t bytes{0u};
+            const void *resource{nullptr};
+            std::string path;
+            bool evictable{true};
+            std::uint64_t last_use{0u};
+        };
+
+        //! Public member functions
+        void track(category cat, resource_id id, entry resident) noexcept
+        {
+            resident.last_use = frame_;
+            auto &resources = residents_[cat];
+            if (auto it = resources.find(id); it != resources.end()) {
+                remove_bytes_(cat, it->second.bytes);
+            }
+            add_bytes_(cat, resident.bytes);
+            resources.insert_or_assign(id, std::move(resident));
+            evicted_[cat].erase(id);
+            stats_.loaded++;
+        }
+
+        void untrack(category cat, resource_id id) noexcept
+        {
+            auto &resources = residents_[cat];
+            if (auto it = resources.find(id); it != resources.end()) {
+                remove_bytes_(cat, it->second.bytes);
+                resources.erase(it);
+            }
+            evicted_[cat].erase(id);
+        }
+
+        //! \note a lookup found the resource
+        void touch(category cat, resource_id id) noexcept
+        {
+            stats_.hits++;
+            if (auto it = residents_[cat].find(id); it != residents_[cat].end()) {
+                it->second.last_use = frame_;
+            }
+        }
+
+        /**
+         * \note a lookup didn't find the resource.
+         * \return the path of the resource if it has been evicted (only once), it should be loaded again.
+         */
+        std::optional<std::string> miss(category cat, resource_id id) noexcept
+        {
+            stats_.misses++;
+            auto it = evicted_[cat].find(id);
+            if (it == evicted_[cat].end()) {
+                return std::nullopt;
+            }
+            auto path = std::move(it->second);
+            evicted_[cat].erase(it);
+            return path;
+        }
+
+        //! \return the path of a resident or evicted resource, std::nullopt if the resource is unknown
+        std::optional<std::string> path_of(category cat, resource_id id) const noexcept
+        {
+            if (auto it = residents_[cat].find(id); it != residents_[cat].end()) {
+                return it->second.path;
+            }
+            if (auto it = evicted_[cat].find(id); it != evicted_[cat].end()) {
+                return it->second;
+            }
+            return std::nullopt;
+        }
+
+        //! \note the resource is used by a live entity and can't be evicted during this frame
+        void mark_referenced(const void *resource) noexcept
+        {
+            if (resource != nullptr) {
+                referenced_.insert(resource);
+            }
+        }
+
+        bool is_over_budget() const noexcept
+        {
+            return stats_.budget != 0u && stats_.total_bytes > stats_.budget;
+        }
+
+        //! \param budget in bytes, 0 means unlimited
+        void set_budget(size_t budget) noexcept
+        {
+            stats_.budget = budget;
+        }
+
+        /**
+         * \note evict the least recently used resources until the memory is under the budget.
+         * \note a resource referenced (mark_referenced) or used during the current frame is never evicted.
+         * \tparam Functor void(category, resource_id) discarding the resource from his cache
+         * \tparam Predicate bool(category, resource_id), true if the resource is still held outside of its cache
+         * \return number of evicted resources
+         */
+        template <typename Functor, typename Predicate>
+        size_t evict(Functor &&discard, Predicate &&is_held)
+        {
+            if (!is_over_budget()) {
+                return 0u;
+            }
+            struct candidate
+            {
+                category cat;
+                resource_id id;
+                std::uint64_t last_use;
+            };
+            std::vector<candidate> candidates;
+            for (size_t cat = 0u; cat < resources_stats::nb_categories; ++cat) {
+                for (auto &&[id, resident] : residents_[cat]) {
+                    if (resident.evictable && resident.last_use < frame_ && !referenced_.count(resident.resource)) {
+                        candidates.push_back(candidate{static_cast<category>(cat), id, resident.last_use});
+                    }
+                }
+            }
+            std::sort(candidates.begin(), candidates.end(), [](auto &&lhs, auto &&rhs) {
+                return lhs.last_use < rhs.last_use;
+            });
+
+            size_t nb_evicted = 0u;
+            for (auto &&current : candidates) {
+                if (!is_over_budget()) {
+                    break;
+                }
+                const auto id = current.id;
+                if (is_held(current.cat, id)) {
+                    continue;
+                }
+                auto path = residents_[current.cat].at(id).path;
+                discard(current.cat, id);
+                untrack(current.cat, id);
+                evicted_[current.cat].insert_or_assign(id, std::move(path));
+                stats_.evictions++;
+                ++nb_evicted;
+            }
+            return nb_evicted;
+        }
+
+        //! \note to be called once per frame, after the eviction
+        void next_frame() noexcept
+        {
+            referenced_.clear();
+            ++frame_;
+        }
+
+        const resources_stats &get_stats() const noexcept
+        {
+            return stats_;
+        }
+
+    private:
+        //! Private member functions
+        void add_bytes_(category cat, size_t bytes) noexcept
+        {
+            stats_.bytes[cat] += bytes;
+            stats_.count[cat]++;
+            stats_.total_bytes += bytes;
+        }
+
+        void remove_bytes_(category cat, size_t bytes) noexcept
+        {
+            stats_.bytes[cat] -= bytes;
+            stats_.count[cat]--;
+            stats_.total_bytes -= bytes;
+        }
+
+        //! Private data members
+        std::array<std::unordered_map<resource_id, entry>, resources_stats::nb_categories> residents_;
+        std::array<std::unordered_map<resource_id, std::string>, resources_stats::nb_categories> evicted_;
+        std::unordered_set<const void *> referenced_;
+        resources_stats stats_;
+        std::uint64_t frame_{0u};
+    };
+}
@@ -4,6 +4,21 @@
 
 #pragma once
 
+#include <array>
+#include <cassert>
+#include <deque>
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <future>
+#include <mutex>
+#include <tuple>
+#include <thread>
+#include <chrono>
+#include <utility>
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Audio/Music.hpp>
@@ -16,13 +31,24 @@
 #else
 #include <sol/resolve.hpp>
 #endif
-#include <entt/resource/cache.hpp>
 #include <shiva/event/after_load_resources.hpp>
+#include <shiva/event/change_scene.hpp>
 #include <shiva/entt/entt.hpp>
 #include <shiva/sfml/resources/taskflow.hpp>
 #include <shiva/spdlog/spdlog.hpp>
 #include <shiva/filesystem/filesystem.hpp>
+#include <shiva/filesystem/file_watcher.hpp>
+#include <shiva/filesystem/vfs.hpp>
 #include <shiva/sfml/resources/entt-sfml-loader.hpp>
+#include <shiva/sfml/resources/load_ticket.hpp>
+#include <shiva/sfml/resources/texture_atlas.hpp>
+#include <shiva/sfml/resources/resource_residency.hpp>
+#include <shiva/sfml/resources/resource_cache.hpp>
+#include <shiva/sfml/resources/access_trace.hpp>
+#include <shiva/sfml/resources/image_header.hpp>
+#include <shiva/sfml/resources/sound_bank.hpp>
+#include <shiva/sfml/resources/resource_graph.hpp>
+#include <shiva/sfml/common/lua_resource_id.hpp>
 #include <shiva/reflection/reflection.hpp>
 
 namespace shiva::sfml
@@ -39,18 +65,21 @@ namespace shiva::sfml
         };
 
         //! Public typedefs
-        using textures_cache = ::entt::resource_cache<sf::Texture>;
-        using musics_cache = ::entt::resource_cache<sf::Music>;
-        using sounds_cache = ::entt::resource_cache<sf::SoundBuffer>;
-        using fonts_cache = ::entt::resource_cache<sf::Font>;
-        using video_cache = ::entt::resource_cache<sfe::Movie>;
-        using anim_cfg_cache = ::entt::resource_cache<animation_config>;
+        using textures_cache = resource_cache<sf::Texture>;
+        using musics_cache = resource_cache<sf::Music>;
+        using sounds_cache = resource_cache<sf::SoundBuffer>;
+        using fonts_cache = resource_cache<sf::Font>;
+        using video_cache = resource_cache<sfe::Movie>;
+        using anim_cfg_cache = resource_cache<animation_config>;
 
     private:
         //! Private data members
         shiva::logging::logger log_{shiva::log::stdout_color_mt("resources_registry")};
         shiva::entt::dispatcher &dispatcher_;
 
+        //! Virtual filesystem, declared before the caches: the fonts and the musics are streamed from its mounts
+        std::shared_ptr<shiva::filesystem::vfs> vfs_;
+
         //! Caches
         textures_cache textures_{};
         musics_cache musics_{};
@@ -67,13 +96,129 @@ namespace shiva::sfml
         shiva::fs::path videos_path_;
         shiva::fs::path anim_cfg_path_;
 
-        //! Atomic/Multithread operation
+        //! Placeholders, returned while a resource is not available
+        mutable std::tuple<std::unique_ptr<sf::Texture>,
+            std::unique_ptr<sf::Music>,
+            std::unique_ptr<sf::SoundBuffer>,
+            std::unique_ptr<sf::Font>,
+            std::unique_ptr<sfe::Movie>,
+            std::unique_ptr<animation_config>> placeholders_;
+
+        //! Main thread jobs, pushed by the workers and run by update
+        struct main_thread_job
+        {
+            std::shared_ptr<load_ticket> ticket;
+            std::function<bool()> job;
+            unsigned int nb_files{1u};
+        };
+
+        //! Files of one loading, decoded in parallel by the workers
+        struct load_batch
+        {
+            using loader_t = std::function<bool(resource_id, const std::string &,
+                                                shiva::filesystem::vfs::read_result)>;
+
+            struct file
+            {
+                resource_id id;
+                std::string path;
+                size_t loader_idx;
+            };
+
+            std::array<loader_t, 6> loaders;
+            std::vector<file> files;
+            std::atomic_size_t next_file{0u};
+
+            //! Reads issued at once before the decoding, in the order of the files (invalid if not prefetched)
+            std::vector<std::future<shiva::filesystem::vfs::read_result>> reads;
+
+            //! Atlas of the folder, the eligible images are packed by the epilogue of the loading
+            std::string folder;
+            std::optional<atlas_config> atlas;
+            std::mutex atlas_mutex;
+            std::vector<std::pair<resource_id, std::shared_ptr<sf::Image>>> atlas_images;
+            std::unordered_map<resource_id, std::string> atlas_paths;
+
+            //! Resources of the folder, resident or not, explicitly loaded
+            std::vector<resource_key> folder_keys;
+
+            //! Last unload when the loading started
+            std::uint64_t nb_unloads{0u};
+        };
+
+        //! Atlas, sub-rect of the packed textures in their page
+        struct atlas_region
+        {
+            resource_id page;
+            sf::IntRect rect;
+        };
+
+        std::unordered_map<std::string, atlas_config> atlas_configs_;
+        resource_cache<atlas_region> atlas_regions_;
+        std::unordered_map<std::string, std::vector<resource_id>> atlas_pages_;
+
+        std::mutex jobs_mutex_;
+        std::deque<main_thread_job> jobs_;
+        std::vector<std::shared_ptr<load_ticket>> tickets_;
+        std::chrono::microseconds main_thread_budget_{4000};
+
+        //! Residency, memory of the resources in the caches
+        mutable resource_residency residency_;
+        std::atomic_uint64_t decoding_time_us_{0u};
+
+        //! On demand loading, resources looked up (evicted or indexed) and loaded at the next update
+        mutable std::vector<load_batch::file> requests_;
+        mutable std::mutex remote_misses_mutex_;
+        mutable std::vector<resource_key> remote_misses_;
+        std::array<std::unordered_map<resource_id, std::string>, resources_stats::nb_categories> lazy_index_;
+        std::unordered_map<resource_key, std::shared_ptr<load_ticket>> in_flight_;
+        resource_graph graph_;
+        //! resources loaded only as the dependency of another one, released with it
+        std::unordered_set<resource_key> dependency_only_;
+        //! number of the last unload of the resources, the insertions of a loading started before it are skipped
+        std::uint64_t nb_unloads_{0u};
+        std::unordered_map<resource_key, std::uint64_t> unloaded_;
+        //! functors waiting for a resource, see on_available
+        std::vector<std::pair<resource_key, std::function<void(bool)>>> waiters_;
+
+        //! Headless mode (servers), only the metadata of the resources are loaded
+        std::atomic_bool headless_{false};
+        resource_cache<sf::Vector2u> texture_sizes_;
+
+        //! Scene prefetching, lookups of the first seconds of the current scene and prefetches in progress
+        mutable access_trace trace_;
+        std::unordered_map<std::string, std::shared_ptr<load_ticket>> prefetches_;
+
+        //! Compressed sounds, the bytes of their files, decoded at their first play by the sound bank
+        std::atomic_bool compress_sounds_{false};
+        resource_cache<std::string> compressed_sounds_;
+
+        //! Hot reload, files of the resources loaded from the disk (and their virtual path), reloaded in place
+        std::unordered_map<std::string, std::pair<resource_key, std::string>> watched_files_;
+        std::vector<std::unique_ptr<shiva::filesystem::file_watcher>> watchers_;
+        std::vector<std::pair<shiva::filesystem::vfs::mount_id, shiva::fs::path>> archives_;
+        std::chrono::steady_clock::time_point last_poll_{std::chrono::steady_clock::now()};
+        static constexpr std::chrono::milliseconds hot_reload_interval_{250};
+
+        //! Atomic/Multithread operation, the lookups from the other threads don't touch the residency
+        std::thread::id main_thread_id_{std::this_thread::get_id()};
+        mutable std::mutex placeholders_mutex_;
         std::atomic_uint32_t current_files_loaded_{0u};
         std::atomic_uint32_t nb_files_{0u};
         std::atomic_bool working_{false};
-        work_type current_working_type_{work_type::inactive};
         tf::Taskflow tf_{std::thread::hardware_concurrency()};
 
+        //! Decodings of the compressed sounds, apart from the loadings which wait for their whole taskflow
+        tf::Taskflow sound_decoder_{1u};
+        bool sound_decoder_dispatched_{false};
+
+        //! Voices of the sounds, declared after the taskflow which decodes the compressed sounds
+        sound_bank sound_bank_{[this](std::function<void()> job) {
+            sound_decoder_.silent_emplace(std::move(job));
+            sound_decoder_.silent_dispatch();
+            sound_decoder_dispatched_ = true;
+        }};
+
     public:
         resources_registry(shiva::entt::dispatcher &dispatcher,
                            shiva::fs::path textures_path = shiva::fs::current_path() /= "assets/textures",
@@ -81,9 +226,11 @@ namespace shiva::sfml
                            shiva::fs::path musics_path = shiva::fs::current_path() /= "assets/musics",
                            shiva::fs::path fonts_path = shiva::fs::current_path() /= "assets/fonts",
                            shiva::fs::path videos_path = shiva::fs::current_path() /= "assets/videos",
-                           shiva::fs::path anim_cfg_path = shiva::fs::current_path() /= "assets/cfg/anim_cfg") noexcept
+                           shiva::fs::path anim_cfg_path = shiva::fs::current_path() /= "assets/cfg/anim_cfg",
+                           std::shared_ptr<shiva::filesystem::vfs> file_system = shiva::filesystem::vfs::shared()) noexcept
             :
             dispatcher_(dispatcher),
+            vfs_(std::move(file_system)),
             textures_path_(std::move(textures_path)),
             sounds_path_(std::move(sounds_path)),
             musics_path_(std::move(musics_path)),
@@ -91,6 +238,97 @@ namespace shiva::sfml
             videos_path_(std::move(videos_path)),
             anim_cfg_path_(std::move(anim_cfg_path))
         {
+          for (auto &&path : {textures_path_, sounds_path_, musics_path_, fonts_path_, videos_path_, anim_cfg_path_}) {
+            vfs_->mount_path(path);
+          }
+          const auto archive_path = shiva::fs::current_path() / "assets.shivapak";
+          if (shiva::fs::exists(archive_path)) {
+            mount_archive(archive_path);
+          }
+          const auto manifest_path = shiva::fs::current_path() / "assets.shivamanifest";
+          if (shiva::fs::exists(manifest_path)) {
+            open_manifest(manifest_path);
+          }
+          residency_.set_budget(512u * 1024u * 1024u);
+          trace_.set_directory(textures_path_.parent_path() / "traces");
+          dispatcher_.sink<shiva::event::change_scene>().connect<::entt::overload<void(
+              const shiva::event::change_scene &evt)>(
+              &resources_registry::receive)>(this);
+        }
+
+        //! Destructor
+        ~resources_registry() noexcept
+        {
+          dispatcher_.sink<shiva::event::change_scene>().disconnect<::entt::overload<void(
+              const shiva::event::change_scene &evt)>(
+              &resources_registry::receive)>(this);
+        }
+
+        //! Callbacks
+
+        /**
+         * \note the trace of the previous scene is saved, the resources recorded for the new one are prefetched
+         * (if prefetch_scene hasn't been called already) and its lookups are recorded.
+         */
+        void receive(const shiva::event::change_scene &evt) noexcept
+        {
+          if (evt.scene_name == nullptr) {
+            return;
+          }
+          save_trace_();
+          prefetch_scene(evt.scene_name);
+          trace_.start(evt.scene_name);
+        }
+
+        /**
+         * \note the archive is mounted in the vfs on the virtual path of assets_root, above the loose files:
+         * the resources found in the archive are loaded from it instead of the disk.
+         * \note the archive hides the modifications of the loose files, it is unmounted by enable_hot_reload.
+         * \param assets_root directory the archive was built from, the paths of the resources are relative to it
+         * \return true if the archive has been mounted, false otherwise
+         */
+        bool mount_archive(const shiva::fs::path &archive_path,
+                           const shiva::fs::path &assets_root = shiva::fs::current_path() / "assets") noexcept
+        {
+          auto archive = std::make_shared<shiva::filesystem::archive_mount>(archive_path);
+          if (!archive->is_open()) {
+            log_->error("unable to mount archive: {0}", archive_path.string());
+            return false;
+          }
+          const auto nb_entries = archive->get_archive().size();
+          archives_.emplace_back(vfs_->mount(vfs_->mount_path(assets_root), std::move(archive),
+                                             shiva::filesystem::vfs::archive_priority), assets_root);
+          log_->info("archive mounted: {0}, nb entries: {1}", archive_path.string(), nb_entries);
+          return true;
+        }
+
+        /**
+         * \note once opened, the directories of the resources are listed from the manifest instead of being walked,
+         * the manifest is refreshed (only the modified directories are listed again) and saved if needed.
+         * \note call refresh_manifest after adding or removing assets while the game is running.
+         * \param assets_root directory described by the manifest, the paths of the resources are relative to it
+         * \return true if the manifest has been opened, false otherwise
+         */
+        bool open_manifest(const shiva::fs::path &manifest_path,
+                           const shiva::fs::path &assets_root = shiva::fs::current_path() / "assets") noexcept
+        {
+          if (!vfs_->mount_directory(assets_root)->open_manifest(manifest_path)) {
+            log_->error("unable to open manifest: {0}", manifest_path.string());
+            return false;
+          }
+          log_->info("manifest opened: {0}", manifest_path.string());
+          return true;
+        }
+
+        //! \return number of directories listed again
+        size_t refresh_manifest() noexcept
+        {
+          return vfs_->refresh();
+        }
+
+        shiva::filesystem::vfs &get_vfs() noexcept
+        {
+          return *vfs_;
         }
 
         const std::atomic_uint32_t &get_nb_current_files_loaded_() const noexcept
@@ -108,91 +346,88 @@ namespace shiva::sfml
           return working_;
         }
 
-        template <typename ResourceCache, typename Identifier = const char *>
-        bool unload_resource(ResourceCache &resource_cache, Identifier id, const std::string &original_path) noexcept
+        template <typename ResourceCache>
+        bool unload_resource(ResourceCache &resource_cache, resource_id id, const std::string &original_path) noexcept
         {
-          const auto identifier = typename ResourceCache::resource_type{id};
-          resource_cache.discard(identifier);
-          log_->debug("unloading resource: {0} from original_path {1}", id, original_path);
-          return resource_cache.contains(identifier);
+          resource_cache.discard(id);
+          residency_.untrack(category_of_(resource_cache), id);
+          if (category_of_(resource_cache) == resource_residency::texture) {
+            texture_sizes_.discard(id);
+          } else if (category_of_(resource_cache) == resource_residency::sound) {
+            compressed_sounds_.discard(id);
+            sound_bank_.discard(id);
+          }
+          dependency_only_.erase(resource_key{category_of_(resource_cache), id});
+          unloaded_.insert_or_assign(resource_key{category_of_(resource_cache), id}, ++nb_unloads_);
+          release_orphans_(resource_key{category_of_(resource_cache), id});
+          log_->debug("unloading resource: {0} from original_path {1}", id.name(), original_path);
+          return resource_cache.contains(id);
         }
 
-        template <typename Identifier = const char *>
-        bool unload_music(Identifier id, const std::string &original_path) noexcept
+        bool unload_music(resource_id id, const std::string &original_path) noexcept
         {
           return unload_resource<musics_cache>(musics_, id, original_path);
         }
 
-        template <typename Identifier = const char *>
-        bool unload_font(Identifier id, const std::string &original_path) noexcept
+        bool unload_font(resource_id id, const std::string &original_path) noexcept
         {
           return unload_resource<fonts_cache>(fonts_, id, original_path);
         }
 
-        template <typename Identifier = const char *>
-        bool unload_video(Identifier id, const std::string &original_path) noexcept
+        bool unload_video(resource_id id, const std::string &original_path) noexcept
         {
           return unload_resource<video_cache>(videos_, id, original_path);
         }
 
-        template <typename Identifier = const char *>
-        bool unload_sound(Identifier id, const std::string &original_path) noexcept
+        bool unload_sound(resource_id id, const std::string &original_path) noexcept
         {
           return unload_resource<sounds_cache>(sounds_, id, original_path);
         }
 
-        template <typename Identifier = const char *>
-        bool unload_texture(Identifier id, const std::string &original_path) noexcept
+        bool unload_texture(resource_id id, const std::string &original_path) noexcept
         {
           return unload_resource<textures_cache>(textures_, id, original_path);
         }
 
-        template <typename Identifier = const char *>
-        bool unload_anim_cfg(Identifier id, const std::string &original_path) noexcept
+        bool unload_anim_cfg(resource_id id, const std::string &original_path) noexcept
         {
           return unload_resource<anim_cfg_cache>(anim_cfgs_, id, original_path);
         }
 
-        template <typename Identifier = const char *, typename ... Args>
-        bool load_anim_cfg(Identifier id, Args &&...args)
+        template <typename ... Args>
+        bool load_anim_cfg(resource_id id, Args &&...args)
         {
-          const auto identifier = anim_cfg_cache::resource_type{id};
-          return anim_cfgs_.load<loader<animation_config>>(identifier, std::forward<Args>(args)...);;
+          return anim_cfgs_.load<loader<animation_config>>(id, std::forward<Args>(args)...);
         }
 
-        template <typename Identifier = const char *, typename ... Args>
-        bool load_music(Identifier id, Args &&...args)
+        template <typename ... Args>
+        bool load_music(resource_id id, Args &&...args)
         {
-          const auto identifier = musics_cache::resource_type{id};
-          return musics_.load<loader<sf::Music>>(identifier, std::forward<Args>(args)...);
+          return musics_.load<loader<sf::Music>>(id, std::forward<Args>(args)...);
         }
 
-        template <typename Identifier = const char *, typename ... Args>
-        bool load_texture(Identifier id, Args &&...args)
+        template <typename ... Args>
+        bool load_texture(resource_id id, Args &&...args)
         {
-          const auto identifier = textures_cache::resource_type{id};
-          return textures_.load<loader<sf::Texture >>(identifier, std::forward<Args>(args)...);
+          return textures_.load<loader<sf::Texture>>(id, std::forward<Args>(args)...);
         }
 
-        template <typename Identifier = const char *, typename ... Args>
-        bool load_sound(Identifier id, Args &&...args)
+        template <typename ... Args>
+        bool load_sound(resource_id id, Args &&...args)
         {
-          const auto identifier = sounds_cache::resource_type{id};
-          return sounds_.load<loader<sf::SoundBuffer >>(identifier, std::forward<Args>(args)...);
+          return sounds_.load<loader<sf::SoundBuffer>>(id, std::forward<Args>(args)...);
         }
 
-        template <typename Identifier = const char *, typename ... Args>
-        bool load_font(Identifier id, Args &&...args)
+        template <typename ... Args>
+        bool load_font(resource_id id, Args &&...args)
         {
-          const auto identifier = fonts_cache::resource_type{id};
-          return fonts_.load<loader<sf::Font>>(identifier, std::forward<Args>(args)...);
+          return fonts_.load<loader<sf::Font>>(id, std::forward<Args>(args)...);
         }
 
-        template <typename Identifier = const char *, typename ... Args>
-        bool load_video(Identifier id, Args &&...args)
+        template <typename ... Args>
+        bool load_video(resource_id id, Args &&...args)
         {
-          const auto identifier = video_cache::resource_type{id};
-          return videos_.load<loader<sfe::Movie>>(identifier, std::forward<Args>(args)...);
+          return videos_.load<loader<sfe::Movie>>(id, std::forward<Args>(args)...);
         }
 
         template <typename LoaderFunctor>
@@ -200,233 +435,373 @@ namespace shiva::sfml
                                std::string_view resource_type,
                                std::string_view resource_type_singular,
                                LoaderFunctor &&loader_functor,
-                               const shiva::fs::path &additional_path) noexcept
+                               const shiva::fs::path &additional_path,
+                               work_type type = work_type::loading) noexcept
         {
           if (additional_path.empty())
             return work_on_resources(current_resource_path,
                                      resource_type,
                                      resource_type_singular,
                                      loader_functor,
-                                     current_resource_path);
+                                     current_resource_path,
+                                     type);
           std::string id;
-          shiva::fs::path directory_path = current_resource_path;
-
-          if (additional_path != current_resource_path) {
-            directory_path = current_resource_path / additional_path;
+          auto directory = virtual_directory_(current_resource_path);
+          const bool stem_ids = additional_path != current_resource_path;
+          if (stem_ids) {
+            directory += "/" + additional_path.generic_string();
             id = additional_path.string() + "/";
           }
 
-          if (!shiva::fs::exists(directory_path)) {
+          if (!vfs_->is_directory(directory)) {
             this->log_->warn("trying to {0} resources from a non existent directory: {1}",
-                             (current_working_type_ == work_type::loading) ? "load" : "unload",
-                             directory_path.string());
+                             (type == work_type::loading) ? "load" : "unload",
+                             directory);
             return false;
           }
 
-          log_->info("{0} {1} from path: {2}", (current_working_type_ == work_type::loading) ? "load" : "unload",
+          log_->info("{0} {1} from path: {2}", (type == work_type::loading) ? "load" : "unload",
                      resource_type,
-                     directory_path.string());
+                     directory);
           bool res = true;
-          fs::recursive_directory_iterator endit;
-          for (fs::recursive_directory_iterator it(directory_path); it != endit; ++it) {
-            if (!fs::is_regular_file(*it))
-              continue;
-            try {
-              std::string save = id;
-              std::string filename = it->path().filename().string();
-              std::string stem_filename = it->path().filename().stem().string();
-              if (additional_path != current_resource_path) {
-                id += stem_filename;
-              } else {
-                id = filename;
+          vfs_->for_each_file(directory, [&](const std::string &path) {
+              const shiva::fs::path file_path{path};
+              const std::string filename = file_path.filename().string();
+              const std::string name = stem_ids ? id + file_path.stem().string() : filename;
+              try {
+                res &= loader_functor(resource_id::intern(name), path);
+                log_->debug("{0} {1}: [ filename: {2}, id: {3}, path: {4} ]",
+                            (type == work_type::loading) ? "found" : "unloaded",
+                            resource_type_singular,
+                            filename,
+                            name,
+                            path);
               }
-              current_files_loaded_++;
-              res &= loader_functor(id.c_str(), it->path().string());
-              log_->debug("{0} {1}: [ filename: {2}, id: {3}, path: {4} ]\nremaining file: {5} / {6}",
-                          (current_working_type_ == work_type::loading) ? "loaded" : "unloaded",
-                          resource_type_singular,
-                          filename,
-                          id,
-                          it->path().string(),
-                          current_files_loaded_,
-                          nb_files_);
-              id = save;
-            }
-            catch (const shiva::fs::filesystem_error &error) {
-              this->log_->error("filesystem error occured: {0}", error.what());
-              res = false;
-              nb_files_--;
-            }
-            catch (const std::exception &error) {
-              this->log_->error("error occured: {0}", error.what());
-              res = false;
-              nb_files_--;
-            }
-          }
+              catch (const std::exception &error) {
+                this->log_->error("error occured: {0}", error.what());
+                res = false;
+                if (type == work_type::loading)
+                  nb_files_--;
+              }
+          });
           return res;
         }
 
         template <typename Functor>
-        bool work_on_textures(Functor &&functor, const shiva::fs::path &additional_path = "") noexcept
+        bool work_on_textures(Functor &&functor, const shiva::fs::path &additional_path = "",
+                              work_type type = work_type::loading) noexcept
         {
 
           return work_on_resources(textures_path_,
                                    "textures",
                                    "texture",
                                    std::forward<Functor>(functor),
-                                   additional_path);
+                                   additional_path,
+                                   type);
         }
 
         template <typename Functor>
-        bool work_on_anim_cfg(Functor &&functor, const shiva::fs::path &additional_path = "") noexcept
+        bool work_on_anim_cfg(Functor &&functor, const shiva::fs::path &additional_path = "",
+                              work_type type = work_type::loading) noexcept
         {
 
           return work_on_resources(anim_cfg_path_,
                                    "anim_cfgs",
                                    "anim_cfg",
                                    std::forward<Functor>(functor),
-                                   additional_path);
+                                   additional_path,
+                                   type);
         }
 
         template <typename Functor>
-        bool work_on_musics(Functor &&functor, const shiva::fs::path &additional_path = "") noexcept
+        bool work_on_musics(Functor &&functor, const shiva::fs::path &additional_path = "",
+                            work_type type = work_type::loading) noexcept
         {
           return work_on_resources(musics_path_,
                                    "musics",
                                    "music",
                                    std::forward<Functor>(functor),
-                                   additional_path);
+                                   additional_path,
+                                   type);
         }
 
         template <typename Functor>
-        bool work_on_sounds(Functor &&functor, const shiva::fs::path &additional_path = "") noexcept
+        bool work_on_sounds(Functor &&functor, const shiva::fs::path &additional_path = "",
+                            work_type type = work_type::loading) noexcept
         {
 
           return work_on_resources(sounds_path_,
                                    "sounds",
                                    "sound",
                                    std::forward<Functor>(functor),
-                                   additional_path);
+                                   additional_path,
+                                   type);
         }
 
         template <typename Functor>
-        bool work_on_fonts(Functor &&functor, const shiva::fs::path &additional_path = "") noexcept
+        bool work_on_fonts(Functor &&functor, const shiva::fs::path &additional_path = "",
+                           work_type type = work_type::loading) noexcept
         {
 
           return work_on_resources(fonts_path_,
                                    "fonts",
                                    "font",
                                    std::forward<Functor>(functor),
-                                   additional_path);
+                                   additional_path,
+                                   type);
         }
 
         template <typename Functor>
-        bool work_on_videos(Functor &&functor, const shiva::fs::path &additional_path = "") noexcept
+        bool work_on_videos(Functor &&functor, const shiva::fs::path &additional_path = "",
+                            work_type type = work_type::loading) noexcept
         {
           return work_on_resources(videos_path_,
                                    "videos",
                                    "video",
                                    std::forward<Functor>(functor),
-                                   additional_path);
+                                   additional_path,
+                                   type);
+        }
+
+        /**
+         * \note start the loading of all the resources of additional_path, without blocking the caller.
+         * \note the files are decoded by the workers, the resources are inserted in the caches
+         * (and the textures uploaded to the GPU) by update on the main thread, within the frame budget.
+         * \param trigger_event if true, after_load_resources is triggered from update once the ticket is ready
+         * \return the ticket of the loading
+         */
+        std::shared_ptr<load_ticket> load_all_resources_async(const shiva::fs::path &additional_path = "",
+                                                              bool trigger_event = true) noexcept
+        {
+          auto ticket = std::make_shared<load_ticket>();
+          ticket->trigger_event_ = trigger_event;
+          auto batch = make_batch_(ticket, additional_path.generic_string());
+          dispatch_batch_(ticket, batch, additional_path);
+          return ticket;
         }
 
+        /**
+         * \note loading: non blocking, see load_all_resources_async.
+         * \note unloading: the resources are discarded from the caches immediately, on the calling (main) thread.
+         */
         bool work_on_all_resources(const shiva::fs::path &additional_path = "",
                                    work_type type = work_type::loading) noexcept
         {
-          current_working_type_ = type;
-          working_ = true;
-          nb_files_ = static_cast<unsigned int>(count_all_resources(additional_path));
-          this->log_->info("nb_resources: {0}", nb_files_);
-
-          auto[texture_task, music_task, sound_task, font_task, anim_cfg_task, video_task, epilogue_task] = tf_.silent_emplace(
-              [this, additional_path]() {
-                  auto loader_functor = [this](auto &&...params) {
-                      return this->load_texture(std::forward<decltype(params)>(params)...);
-                  };
-
-                  auto unloader_functor = [this](auto &&...params) {
-                      return this->unload_texture(std::forward<decltype(params)>(params)...);
-                  };
-
-                  return (current_working_type_ == work_type::loading) ?
-                         this->work_on_textures(loader_functor, additional_path) :
-                         this->work_on_textures(unloader_functor, additional_path);
-              },
-              [this, additional_path]() {
-                  auto loader_functor = [this](auto &&...params) {
-                      return this->load_music(std::forward<decltype(params)>(params)...);
-                  };
-
-                  auto unloader_functor = [this](auto &&...params) {
-                      return this->unload_music(std::forward<decltype(params)>(params)...);
-                  };
-
-                  return (current_working_type_ == work_type::loading) ?
-                         this->work_on_musics(loader_functor, additional_path) :
-                         this->work_on_musics(unloader_functor, additional_path);
-              },
-              [this, additional_path]() {
-                  auto loader_functor = [this](auto &&...params) {
-                      return this->load_sound(std::forward<decltype(params)>(params)...);
-                  };
-
-                  auto unloader_functor = [this](auto &&...params) {
-                      return this->unload_sound(std::forward<decltype(params)>(params)...);
-                  };
-                  return (current_working_type_ == work_type::loading) ?
-                         this->work_on_sounds(loader_functor, additional_path) :
-                         this->work_on_sounds(unloader_functor, additional_path);
-              },
-              [this, additional_path]() {
-                  auto loader_functor = [this](auto &&...params) {
-                      return this->load_font(std::forward<decltype(params)>(params)...);
-                  };
-
-                  auto unloader_functor = [this](auto &&...params) {
-                      return this->unload_font(std::forward<decltype(params)>(params)...);
-                  };
-                  return (current_working_type_ == work_type::loading) ?
-                         this->work_on_fonts(loader_functor, additional_path) :
-                         this->work_on_fonts(unloader_functor, additional_path);
-              },
-              [this, additional_path]() {
-                  auto loader_functor = [this](auto &&...params) {
-                      return this->load_anim_cfg(std::forward<decltype(params)>(params)...);
-                  };
-
-                  auto unloader_functor = [this](auto &&...params) {
-                      return this->unload_anim_cfg(std::forward<decltype(params)>(params)...);
-                  };
-                  return (current_working_type_ == work_type::loading) ?
-                         this->work_on_anim_cfg(loader_functor, additional_path) :
-                         this->work_on_anim_cfg(unloader_functor, additional_path);
-              },
-              [this, additional_path]() {
-                  auto loader_functor = [this](auto &&...params) {
-                      return this->load_video(std::forward<decltype(params)>(params)...);
-                  };
-
-                  auto unloader_functor = [this](auto &&...params) {
-                      return this->unload_video(std::forward<decltype(params)>(params)...);
-                  };
-                  return (current_working_type_ == work_type::loading) ?
-                         this->work_on_videos(loader_functor, additional_path) :
-                         this->work_on_videos(unloader_functor, additional_path);
-              },
-              [this, type]() {
-                  this->log_->info("all resources have been {0}",
-                                   (type == work_type::loading) ? "loaded" : "unloaded");
-                  this->current_working_type_ = work_type::inactive;
-                  this->working_ = false;
-                  this->nb_files_ = 0;
-                  this->current_files_loaded_ = 0;
-                  if (type == work_type::loading)
-                    this->dispatcher_.trigger<shiva::event::after_load_resources>();
-              });
+          if (type == work_type::loading) {
+            load_all_resources_async(additional_path);
+            return true;
+          }
 
-          epilogue_task.gather(texture_task, music_task, sound_task, font_task, anim_cfg_task, video_task);
-          tf_.wait_for_all();
-          return true;
+          auto unloader = [this](auto &cache) {
+              return [this, &cache](resource_id id, const std::string &original_path) {
+                  this->unload_resource(cache, id, original_path);
+                  return true;
+              };
+          };
+          //! dependents (animation configs) first, their dependencies which are no longer needed follow them.
+          bool res = true;
+          res &= work_on_anim_cfg(unloader(anim_cfgs_), additional_path, type);
+          res &= work_on_textures(unloader(textures_), additional_path, type);
+          discard_atlas_(additional_path.generic_string());
+          res &= work_on_musics(unloader(musics_), additional_path, type);
+          res &= work_on_sounds(unloader(sounds_), additional_path, type);
+          res &= work_on_fonts(unloader(fonts_), additional_path, type);
+          res &= work_on_videos(unloader(videos_), additional_path, type);
+          this->log_->info("all resources have been unloaded");
+          return res;
+        }
+
+        /**
+         * \note lazy mode: the files of additional_path are indexed (no decoding), then each resource is loaded
+         * the first time it is requested (request_resource) or looked up (get_texture...),
+         * with the resources it depends on (the texture of an animation config).
+         * \return number of indexed files
+         */
+        size_t index_resources(const shiva::fs::path &additional_path = "") noexcept
+        {
+          load_batch batch;
+          collect_resources_(batch, additional_path);
+          for (auto &&file : batch.files) {
+            lazy_index_[file.loader_idx].insert_or_assign(file.id, std::move(file.path));
+          }
+          log_->info("{0} resources indexed for {1}", batch.files.size(), additional_path.string());
+          return batch.files.size();
+        }
+
+        /**
+         * \note schedule the loading of the resource (and its dependencies) if it is not resident.
+         * \return a ticket which becomes ready once the resource is available, already ready if it is resident,
+         * failed if the resource is neither resident nor indexed.
+         */
+        std::shared_ptr<load_ticket> request_resource(resource_residency::category category, resource_id id) noexcept
+        {
+          const resource_key key{category, id};
+          if (auto it = in_flight_.find(key); it != in_flight_.end()) {
+            return it->second;
+          }
+          if (!is_resident_(key) && !lazy_index_[category].count(id)) {
+            auto ticket = std::make_shared<load_ticket>();
+            ticket->trigger_event_ = false;
+            ticket->failed_ = true;
+            watch_ticket_(ticket);
+            return ticket;
+          }
+          return schedule_({load_batch::file{id, {}, category}});
+        }
+
+        /**
+         * \note call the functor from update once the resource is available (true), or once no loading is
+         * in progress without it (false), by the next update if the resource is already available.
+         * \note unlike request_resource the resource is not loaded, a loading of its folder is waited for.
+         */
+        void on_available(resource_residency::category category, resource_id id,
+                          std::function<void(bool)> functor) noexcept
+        {
+          waiters_.emplace_back(resource_key{category, id}, std::move(functor));
+        }
+
+        //! \return true if the resource is in its cache, a lookup doesn't give its placeholder
+        bool is_available(resource_residency::category category, resource_id id) const noexcept
+        {
+          return is_resident_(resource_key{category, id});
+        }
+
+        std::shared_ptr<load_ticket> request_texture(resource_id id) noexcept
+        {
+          return request_resource(resource_residency::texture, id);
+        }
+
+        std::shared_ptr<load_ticket> request_music(resource_id id) noexcept
+        {
+          return request_resource(resource_residency::music, id);
+        }
+
+        std::shared_ptr<load_ticket> request_sound(resource_id id) noexcept
+        {
+          return request_resource(resource_residency::sound, id);
+        }
+
+        std::shared_ptr<load_ticket> request_font(resource_id id) noexcept
+        {
+          return request_resource(resource_residency::font, id);
+        }
+
+        std::shared_ptr<load_ticket> request_anim_cfg(resource_id id) noexcept
+        {
+          return request_resource(resource_residency::anim_cfg, id);
+        }
+
+        std::shared_ptr<load_ticket> request_video(resource_id id) noexcept
+        {
+          return request_resource(resource_residency::video, id);
+        }
+
+        /**
+         * \note unload the resource, then the resources it depends on which were loaded only as its dependencies
+         * and are no longer needed by another resource (dependents before dependencies).
+         */
+        void release_resource(resource_residency::category category, resource_id id) noexcept
+        {
+          release_(resource_key{category, id});
+        }
+
+        /**
+         * \note load on the workers, in the recorded order, the resources the scene looked up during its first seconds
+         * the last time it was entered: call it before the change_scene event to load them while the current scene
+         * is still running. The trace of a scene is in the traces directory next to the assets (assets/traces).
+         * \return ticket of the prefetch, nullptr if there is nothing to load
+         */
+        std::shared_ptr<load_ticket> prefetch_scene(const std::string &scene) noexcept
+        {
+          for (auto it = prefetches_.begin(); it != prefetches_.end();) {
+            it = it->second->is_ready() ? prefetches_.erase(it) : std::next(it);
+          }
+          if (auto it = prefetches_.find(scene); it != prefetches_.end()) {
+            return it->second;
+          }
+          std::vector<load_batch::file> files;
+          for (auto &&[key, path] : trace_.load(scene)) {
+            if (!is_resident_(key)) {
+              files.push_back(load_batch::file{key.id, std::move(path), key.category});
+            }
+          }
+          if (files.empty()) {
+            return nullptr;
+          }
+          log_->info("prefetching {0} resources of the scene {1}", files.size(), scene);
+          auto ticket = schedule_(std::move(files));
+          prefetches_.emplace(scene, ticket);
+          return ticket;
+        }
+
+        /**
+         * \note headless mode, for the processes which never draw nor play (dedicated servers): the textures are not
+         * decoded (their size is read from the header of the image), the fonts, sounds, musics and videos are not
+         * read at all, the animation configs are loaded as usual. The caches hold stubs (the placeholder of their type)
+         * and no texture at all: get_texture_region gives a null texture with the real size of the texture,
+         * get_texture_size the size, get_texture must not be called (a texture needs a GL context, it asserts).
+         * \note to be set before loading any resource.
+         */
+        void set_headless(bool headless) noexcept
+        {
+          headless_ = headless;
+        }
+
+        bool is_headless() const noexcept
+        {
+          return headless_;
+        }
+
+        /**
+         * \note keep the sounds compressed in memory (the bytes of their Ogg/FLAC/WAV files) instead of their samples,
+         * they are decoded on a worker at their first play into a cache of decoded_budget bytes: play them with
+         * play_sound, get_resource gives the placeholder for them.
+         * \note to be set before loading any sound.
+         */
+        void enable_compressed_sounds(size_t decoded_budget = 8u * 1024u * 1024u) noexcept
+        {
+          sound_bank_.set_decoded_budget(decoded_budget);
+          compress_sounds_ = true;
+        }
+
+        //! \param nb_voices maximum number of sounds played at the same time (32 by default), the oldest is stopped
+        void set_max_voices(size_t nb_voices) noexcept
+        {
+          sound_bank_.set_max_voices(nb_voices);
+        }
+
+        /**
+         * \note play a sound on a voice of the pool, main thread only. A compressed sound is played once it is decoded,
+         * a sound which is not loaded is loaded on demand and not played.
+         * \return false if the sound is not available (or in headless mode)
+         */
+        bool play_sound(resource_id id, float volume = 100.f, float pitch = 1.f) noexcept
+        {
+          if (headless_) {
+            return false;
+          }
+          if (sound_bank_.contains(id)) {
+            trace_.record(resource_key{resource_residency::sound, id});
+            residency_.touch(resource_residency::sound, id);
+            return sound_bank_.play(id, volume, pitch);
+          }
+          return sound_bank_.play(get_handle<sf::SoundBuffer>(id), volume, pitch);
+        }
+
+        void stop_all_sounds() noexcept
+        {
+          sound_bank_.stop_all();
+        }
+
+        //! \param duration recording time of the lookups after a change of scene, 0 disables the traces (5s by default)
+        void set_trace_duration(std::chrono::milliseconds duration) noexcept
+        {
+          trace_.set_duration(duration);
+        }
+
+        void set_traces_directory(shiva::fs::path directory) noexcept
+        {
+          trace_.set_directory(std::move(directory));
         }
 
         bool load_all_resources(std::string additional_path = "") noexcept
@@ -434,22 +809,148 @@ namespace shiva::sfml
           return work_on_all_resources(shiva::fs::path(std::move(additional_path)), work_type::loading);
         }
 
+        /**
+         * \note blocking loading, for the callers which look the resources up right after it (main thread only):
+         * the files are still decoded in parallel, then inserted without frame budget.
+         * \return false if a file failed to load
+         */
+        bool load_all_resources_sync(std::string additional_path = "") noexcept
+        {
+          auto ticket = load_all_resources_async(shiva::fs::path(std::move(additional_path)));
+          while (!ticket->is_ready()) {
+            //! the insertions dispatch the dependencies they find, which replaces the decoding future of the ticket
+            ticket->get_decoding_future().wait();
+            run_main_thread_jobs_(std::chrono::steady_clock::time_point::max());
+          }
+          //! the callbacks and after_load_resources
+          notify_ready_tickets_();
+          return ticket->succeeded();
+        }
+
         bool unload_all_resources(std::string additional_path = "") noexcept
         {
           return work_on_all_resources(shiva::fs::path(std::move(additional_path)), work_type::unloading);
         }
 
+        /**
+         * \note must be called once per frame from the main thread (resources_system does it).
+         * \note run the jobs pushed by the workers until the budget is spent (at least one job per call,
+         * so a loading always progress), then notify the tickets which are ready.
+         */
+        void update(std::chrono::microseconds budget) noexcept
+        {
+          if (!watchers_.empty()) {
+            poll_modified_files_();
+          }
+          resolve_remote_misses_();
+          if (trace_.is_expired()) {
+            save_trace_();
+          }
+          if (!requests_.empty()) {
+            auto files = std::move(requests_);
+            requests_.clear();
+            schedule_(std::move(files));
+          }
+          run_main_thread_jobs_(std::chrono::steady_clock::now() + budget);
+          notify_ready_tickets_();
+          sound_bank_.update();
+          if (sound_decoder_dispatched_ && !sound_bank_.is_decoding()) {
+            //! every decoding is collected, this only releases their topologies.
+            sound_decoder_.wait_for_all();
+            sound_decoder_dispatched_ = false;
+          }
+          if (const auto nb_evicted = residency_.evict([this](auto category, resource_id id) {
+                this->discard_(category, id);
+            }, [this](auto category, resource_id id) {
+                return this->is_held_(category, id);
+            }); nb_evicted > 0u) {
+            log_->info("{0} resources evicted, memory: {1} / {2} bytes", nb_evicted,
+                       residency_.get_stats().total_bytes, residency_.get_stats().budget);
+          }
+          residency_.next_frame();
+        }
+
+        void update() noexcept
+        {
+          update(main_thread_budget_);
+        }
+
+        /**
+         * \note watch the directories of the textures, sounds, fonts and animation configs.
+         * \note a modified file is decoded by the workers, then its resource is reloaded in place on the main thread:
+         * the sprites, texts, sounds and animations using it see the new data.
+         * \note the watched files are the loose ones: the archives built from them (mount_archive) are unmounted.
+         */
+        void enable_hot_reload() noexcept
+        {
+          watchers_.clear();
+          for (auto it = archives_.begin(); it != archives_.end();) {
+            if (std::error_code ec; !shiva::fs::is_directory(it->second, ec)) {
+              log_->warn("the sources of an archive are missing ({0}), its resources can't be hot reloaded",
+                         it->second.string());
+              ++it;
+              continue;
+            }
+            vfs_->unmount(it->first);
+            log_->info("archive of {0} unmounted, the resources are loaded from the loose files for the hot reload",
+                       it->second.string());
+            it = archives_.erase(it);
+          }
+          for (auto &&root : {textures_path_, sounds_path_, fonts_path_, anim_cfg_path_}) {
+            auto watcher = std::make_unique<shiva::filesystem::file_watcher>(root);
+            if (!watcher->is_valid()) {
+              log_->warn("cannot watch {0}, hot reload disabled for this directory", root.string());
+              continue;
+            }
+            watchers_.push_back(std::move(watcher));
+          }
+        }
+
+        void disable_hot_reload() noexcept
+        {
+          watchers_.clear();
+        }
+
+        void set_main_thread_budget(std::chrono::microseconds budget) noexcept
+        {
+          main_thread_budget_ = budget;
+        }
+
+        /**
+         * \note when the resources in the caches use more than the budget, the least recently used ones
+         * which are not referenced are evicted at the end of update, they are loaded again at their next lookup.
+         * \param budget in bytes, 0 means unlimited (512 MiB by default)
+         */
+        void set_memory_budget(size_t budget) noexcept
+        {
+          residency_.set_budget(budget);
+        }
+
+        bool is_over_memory_budget() const noexcept
+        {
+          return residency_.is_over_budget();
+        }
+
+        /**
+         * \note the resource is used by a live entity (texture of a sprite, font of a text...),
+         * it can't be evicted during the current frame.
+         */
+        void mark_referenced(const void *resource) noexcept
+        {
+          residency_.mark_referenced(resource);
+        }
+
+        resources_stats get_stats() const noexcept
+        {
+          auto stats = residency_.get_stats();
+          stats.load_time_ms = static_cast<double>(decoding_time_us_.load()) / 1000.0;
+          return stats;
+        }
+
         size_t nb_resources(const shiva::fs::path &path) const noexcept
         {
-          using shiva::fs::recursive_directory_iterator;
           this->log_->info("counting file for path: {0}", path.string());
-          if (!shiva::fs::exists(path))
-            return 0u;
-          return static_cast<size_t>(std::count_if(recursive_directory_iterator(path), recursive_directory_iterator{},
-                                                   [](auto &&path_) {
-                                                       return shiva::fs::is_regular_file(path_) &&
-                                                              !shiva::fs::is_directory(path_);
-                                                   }));
+          return vfs_->count_files(virtual_directory_(path));
         }
 
         size_t count_all_resources(const shiva::fs::path &additional_path = "") const noexcept
@@ -462,66 +963,164 @@ namespace shiva::sfml
                  nb_resources(anim_cfg_path_ / additional_path);
         }
 
+        /**
+         * \note if the resource is not available (loading in progress), a placeholder is returned
+         * (magenta texture, empty font...), wait for the after_load_resources event
+         * or for the load_ticket to be ready to get the real resource.
+         * \note an indexed (index_resources) or evicted resource which is not available is loaded on demand.
+         * \note thread safe: from another thread than the main thread the lookup is lock-free and the on demand
+         * loading is requested to the next update, the reference is valid until the resource is unloaded
+         * (use get_handle to keep it alive).
+         * \note the resource given by reference is kept during the current frame only, look it up again each frame,
+         * mark it as referenced (mark_referenced) or keep a handle (get_handle) to use it longer.
+         */
         template <typename ResourceType, typename ResourceCache>
-        ResourceType &get_resource(const ResourceCache &resources, const char *id) noexcept
+        ResourceType &get_resource(const ResourceCache &resources, resource_id id) noexcept
         {
-          const auto identifier = typename ResourceCache::resource_type{id};
-          return const_cast<ResourceType &>(*resources.handle(identifier));
+          return const_cast<ResourceType &>(std::as_const(*this).get_resource<ResourceType>(resources, id));
         }
 
         template <typename ResourceType, typename ResourceCache>
-        const ResourceType &get_resource(const ResourceCache &resources, const char *id) const noexcept
+        const ResourceType &get_resource(const ResourceCache &resources, resource_id id) const noexcept
+        {
+          return lookup_<ResourceType>(resources, id);
+        }
+
+        /**
+         * \note thread safe and lock-free, the handle keeps the resource alive even if it is unloaded or evicted
+         * meanwhile (hot reloads still update it in place).
+         * \note for a texture packed in an atlas, the handle of its page is returned.
+         * \return nullptr if the resource is not available, it is then loaded on demand like get_resource does
+         */
+        template <typename ResourceType>
+        std::shared_ptr<ResourceType> get_handle(resource_id id) const noexcept
         {
-          const auto identifier = typename ResourceCache::resource_type{id};
-          return *resources.handle(identifier);
+          const auto &resources = cache_of_<ResourceType>();
+          if constexpr (std::is_same_v<ResourceType, sf::Texture>) {
+            if (const auto region = atlas_regions_.handle(id); region) {
+              id = region->page;
+            }
+          }
+          auto resource = resources.handle(id);
+          trace_.record(resource_key{category_of_(resources), id});
+          if (!resource) {
+            request_remote_(resource_key{category_of_(resources), id});
+          } else if (std::this_thread::get_id() == main_thread_id_) {
+            residency_.touch(category_of_(resources), id);
+          }
+          return resource;
         }
 
-        sf::Music &get_music(const char *id) noexcept
+        sf::Music &get_music(resource_id id) noexcept
         {
           return get_resource<sf::Music, musics_cache>(musics_, id);
         }
 
-        const sf::Music &get_music(const char *id) const noexcept
+        const sf::Music &get_music(resource_id id) const noexcept
         {
           return get_resource<sf::Music, musics_cache>(musics_, id);
         }
 
-        sf::Texture &get_texture(const char *id) noexcept
+        /**
+         * \note for a texture packed in an atlas, the whole page is returned, see get_texture_region.
+         */
+        sf::Texture &get_texture(resource_id id) noexcept
         {
-          return get_resource<sf::Texture, textures_cache>(textures_, id);
+          return const_cast<sf::Texture &>(std::as_const(*this).get_texture(id));
         }
 
-        const sf::Texture &get_texture(const char *id) const noexcept
+        //! \note must not be called in headless mode (asserts), an empty texture (never uploaded) is returned in release
+        const sf::Texture &get_texture(resource_id id) const noexcept
         {
+          if (headless_) {
+            assert(!"get_texture called in headless mode, use get_texture_region or get_texture_size");
+            static const sf::Texture empty;
+            return empty;
+          }
+          if (const auto region = atlas_regions_.handle(id); region) {
+            return get_resource<sf::Texture, textures_cache>(textures_, region->page);
+          }
           return get_resource<sf::Texture, textures_cache>(textures_, id);
         }
 
-        sf::Font &get_font(const char *id) noexcept
+        /**
+         * \return the texture and the area of the resource inside it: a sub-rect of the page for a texture packed
+         * in an atlas, the whole texture otherwise.
+         */
+        texture_region get_texture_region(resource_id id) const noexcept
+        {
+          if (headless_) {
+            const auto size = texture_sizes_.handle(id);
+            trace_.record(resource_key{resource_residency::texture, id});
+            if (!size) {
+              request_remote_(resource_key{resource_residency::texture, id});
+              return {nullptr, sf::IntRect()};
+            }
+            return {nullptr, sf::IntRect(0, 0, static_cast<int>(size->x), static_cast<int>(size->y))};
+          }
+          if (const auto region = atlas_regions_.handle(id); region) {
+            return {&lookup_<sf::Texture>(textures_, region->page), region->rect};
+          }
+          const auto &texture = lookup_<sf::Texture>(textures_, id);
+          return {&texture, sf::IntRect(0, 0, static_cast<int>(texture.getSize().x),
+                                        static_cast<int>(texture.getSize().y))};
+        }
+
+        //! \return the size of the texture (also in headless mode), std::nullopt if it is not loaded
+        std::optional<sf::Vector2u> get_texture_size(resource_id id) const noexcept
+        {
+          if (const auto size = texture_sizes_.handle(id); size) {
+            return *size;
+          }
+          if (const auto region = atlas_regions_.handle(id); region) {
+            return sf::Vector2u(static_cast<unsigned int>(region->rect.width),
+                                static_cast<unsigned int>(region->rect.height));
+          }
+          if (const auto texture = textures_.handle(id); texture) {
+            return texture->getSize();
+          }
+          return std::nullopt;
+        }
+
+        /**
+         * \note the textures of the folder (additional_path of load_all_resources) smaller than max_texture_size
+         * are packed in atlas pages at the next loading of the folder.
+         */
+        void enable_atlas(std::string additional_path, unsigned int max_texture_size = 256u,
+                          unsigned int page_size = 2048u) noexcept
+        {
+          atlas_config cfg;
+          cfg.page_size = page_size;
+          cfg.max_texture_size = std::min(max_texture_size, page_size - cfg.padding);
+          atlas_configs_.insert_or_assign(std::move(additional_path), cfg);
+        }
+
+        sf::Font &get_font(resource_id id) noexcept
         {
           return get_resource<sf::Font, fonts_cache>(fonts_, id);
         }
 
-        const sf::Font &get_font(const char *id) const noexcept
+        const sf::Font &get_font(resource_id id) const noexcept
         {
           return get_resource<sf::Font, fonts_cache>(fonts_, id);
         }
 
-        animation_config &get_anim_cfg(const char *id) noexcept
+        animation_config &get_anim_cfg(resource_id id) noexcept
         {
           return get_resource<animation_config, anim_cfg_cache>(anim_cfgs_, id);
         }
 
-        const animation_config &get_anim_cfg(const char *id) const noexcept
+        const animation_config &get_anim_cfg(resource_id id) const noexcept
         {
           return get_resource<animation_config, anim_cfg_cache>(anim_cfgs_, id);
         }
 
-        sfe::Movie &get_video(const char *id) noexcept
+        sfe::Movie &get_video(resource_id id) noexcept
         {
           return get_resource<sfe::Movie, video_cache>(videos_, id);
         }
 
-        const sfe::Movie &get_video(const char *id) const noexcept
+        const sfe::Movie &get_video(resource_id id) const noexcept
         {
           return get_resource<sfe::Movie, video_cache>(videos_, id);
         }
@@ -533,27 +1132,45 @@ namespace shiva::sfml
           return meta::makeMap(
               "get_music_c",
               sol::resolve<
-                  const sf::Music &(const char *) const>(&resources_registry::get_music),
+                  const sf::Music &(resource_id) const>(&resources_registry::get_music),
               "get_music",
-              sol::resolve<sf::Music &(const char *)>(&resources_registry::get_music),
+              sol::resolve<sf::Music &(resource_id)>(&resources_registry::get_music),
               "get_texture_c",
-              sol::resolve<const sf::Texture &(const char *) const>(&resources_registry::get_texture),
+              sol::resolve<const sf::Texture &(resource_id) const>(&resources_registry::get_texture),
               "get_texture",
-              sol::resolve<sf::Texture &(const char *)>(&resources_registry::get_texture),
+              sol::resolve<sf::Texture &(resource_id)>(&resources_registry::get_texture),
+              reflect_function(&resources_registry::get_texture_region),
+              reflect_function(&resources_registry::enable_atlas),
+              reflect_function(&resources_registry::set_memory_budget),
+              reflect_function(&resources_registry::request_texture),
+              reflect_function(&resources_registry::request_music),
+              reflect_function(&resources_registry::request_sound),
+              reflect_function(&resources_registry::request_font),
+              reflect_function(&resources_registry::request_anim_cfg),
+              reflect_function(&resources_registry::request_video),
+              reflect_function(&resources_registry::enable_hot_reload),
+              reflect_function(&resources_registry::disable_hot_reload),
+              reflect_function(&resources_registry::set_headless),
+              reflect_function(&resources_registry::is_headless),
+              reflect_function(&resources_registry::enable_compressed_sounds),
+              reflect_function(&resources_registry::set_max_voices),
+              reflect_function(&resources_registry::play_sound),
+              reflect_function(&resources_registry::stop_all_sounds),
               "get_font",
-              sol::resolve<sf::Font &(const char *)>(&resources_registry::get_font),
+              sol::resolve<sf::Font &(resource_id)>(&resources_registry::get_font),
               "get_font_c",
-              sol::resolve<const sf::Font &(const char *) const>(&resources_registry::get_font),
+              sol::resolve<const sf::Font &(resource_id) const>(&resources_registry::get_font),
               "get_anim_cfg",
-              sol::resolve<animation_config &(const char *)>(&resources_registry::get_anim_cfg),
+              sol::resolve<animation_config &(resource_id)>(&resources_registry::get_anim_cfg),
               "get_anim_cfg_c",
-              sol::resolve<const animation_config &(const char *) const>(&resources_registry::get_anim_cfg),
+              sol::resolve<const animation_config &(resource_id) const>(&resources_registry::get_anim_cfg),
               "get_video",
-              sol::resolve<sfe::Movie &(const char *)>(&resources_registry::get_video),
+              sol::resolve<sfe::Movie &(resource_id)>(&resources_registry::get_video),
               "get_video_c",
-              sol::resolve<const sfe::Movie &(const char *) const>(&resources_registry::get_video),
+              sol::resolve<const sfe::Movie &(resource_id) const>(&resources_registry::get_video),
               "load_all_resources",
               sol::resolve<bool(std::string)>(&resources_registry::load_all_resources),
+              reflect_function(&resources_registry::load_all_resources_sync),
               reflect_function(&resources_registry::unload_all_resources)
           );
         }
@@ -562,5 +1179,1034 @@ namespace shiva::sfml
         {
           return meta::makeMap();
         }
+
+    private:
+        //! Private member functions
+
+        //! \note run the jobs pushed by the workers until the deadline, at least one job if there is any
+        void run_main_thread_jobs_(std::chrono::steady_clock::time_point deadline) noexcept
+        {
+          bool first_job = true;
+          while (first_job || std::chrono::steady_clock::now() < deadline) {
+            main_thread_job current;
+            {
+              std::scoped_lock lock(jobs_mutex_);
+              if (jobs_.empty())
+                break;
+              current = std::move(jobs_.front());
+              jobs_.pop_front();
+            }
+            first_job = false;
+            try {
+              if (!current.job())
+                current.ticket->failed_ = true;
+            }
+            catch (const std::exception &error) {
+              this->log_->error("error occured: {0}", error.what());
+              current.ticket->failed_ = true;
+            }
+            current.ticket->nb_loaded_ += current.nb_files;
+            current_files_loaded_ += current.nb_files;
+            current.ticket->nb_pending_jobs_--;
+          }
+        }
+
+        void push_main_thread_job_(const std::shared_ptr<load_ticket> &ticket, std::function<bool()> job,
+                                   unsigned int nb_files = 1u) noexcept
+        {
+          ticket->nb_pending_jobs_++;
+          std::scoped_lock lock(jobs_mutex_);
+          jobs_.push_back(main_thread_job{ticket, std::move(job), nb_files});
+        }
+
+        //! \note one batch of files, its loaders insert the resources in the caches on behalf of the ticket.
+        std::shared_ptr<load_batch> make_batch_(const std::shared_ptr<load_ticket> &ticket, std::string folder) noexcept
+        {
+          auto batch = std::make_shared<load_batch>();
+          batch->folder = std::move(folder);
+          batch->nb_unloads = nb_unloads_;
+          if (auto it = atlas_configs_.find(batch->folder); it != atlas_configs_.end()) {
+            batch->atlas = it->second;
+          }
+          batch->loaders = {make_async_loader_<sf::Texture>(textures_, ticket, batch.get()),
+                            make_async_loader_<sf::Music>(musics_, ticket),
+                            make_async_loader_<sf::SoundBuffer>(sounds_, ticket),
+                            make_async_loader_<sf::Font>(fonts_, ticket),
+                            make_async_loader_<animation_config>(anim_cfgs_, ticket),
+                            make_async_loader_<sfe::Movie>(videos_, ticket)};
+          return batch;
+        }
+
+        /**
+         * \note decode the batch on the workers.
+         * \param additional_path folder to collect the files from, std::nullopt if the files of the batch are given.
+         */
+        void dispatch_batch_(const std::shared_ptr<load_ticket> &ticket, const std::shared_ptr<load_batch> &batch,
+                             std::optional<shiva::fs::path> additional_path) noexcept
+        {
+          working_ = true;
+          ticket->nb_decoding_batches_++;
+          auto collect_task = tf_.silent_emplace([this, ticket, batch, additional_path]() {
+              if (additional_path) {
+                this->collect_resources_(*batch, *additional_path);
+                for (auto &&file : batch->files) {
+                  batch->folder_keys.push_back(resource_key{static_cast<resource_residency::category>(file.loader_idx),
+                                                            file.id});
+                }
+                //! the resources already resident (prefetched for the scene) are not decoded again
+                batch->files.erase(std::remove_if(batch->files.begin(), batch->files.end(), [this](auto &&file) {
+                    return this->is_resident_(resource_key{static_cast<resource_residency::category>(file.loader_idx),
+                                                           file.id});
+                }), batch->files.end());
+              }
+              const auto nb_files = static_cast<unsigned int>(batch->files.size());
+              ticket->nb_files_ += nb_files;
+              this->nb_files_ += nb_files;
+              this->log_->info("nb_resources: {0}", nb_files);
+              this->prefetch_(*batch);
+          });
+
+          auto epilogue_task = tf_.silent_emplace([this, ticket, batch]() {
+              if (!batch->atlas_images.empty()) {
+                this->pack_atlas_(*batch, ticket);
+              }
+              if (!batch->folder_keys.empty()) {
+                //! after the insertions: the resources of the folder are no longer dependencies only
+                this->push_main_thread_job_(ticket, [this, batch]() {
+                    for (auto &&key : batch->folder_keys) {
+                      this->dependency_only_.erase(key);
+                    }
+                    return true;
+                }, 0u);
+              }
+              this->log_->info("all resources have been decoded, waiting for the main thread");
+              ticket->nb_decoding_batches_--;
+          });
+
+          //! one decoder per worker, each of them takes the next file of the batch until there is no more.
+          const auto nb_decoders = std::max<size_t>(1u, tf_.num_workers());
+          for (size_t idx = 0; idx < nb_decoders; ++idx) {
+            auto decode_task = tf_.silent_emplace([this, batch]() {
+                this->decode_resources_(*batch);
+            });
+            collect_task.precede(decode_task);
+            decode_task.precede(epilogue_task);
+          }
+
+          ticket->decoding_future_ = tf_.dispatch();
+          watch_ticket_(ticket);
+        }
+
+        //! \note the ticket is notified by update once it is ready, even if it has nothing to load
+        void watch_ticket_(const std::shared_ptr<load_ticket> &ticket) noexcept
+        {
+          if (!ticket->decoding_future_.valid()) {
+            std::promise<void> decoded;
+            decoded.set_value();
+            ticket->decoding_future_ = decoded.get_future().share();
+          }
+          if (std::find(tickets_.begin(), tickets_.end(), ticket) == tickets_.end()) {
+            tickets_.push_back(ticket);
+          }
+        }
+
+        void watch_file_(const std::string &path, const resource_key &key) noexcept
+        {
+          if (auto disk_path = path.empty() ? std::nullopt : vfs_->disk_path(path); disk_path) {
+            watched_files_.insert_or_assign(disk_path->string(), std::make_pair(key, path));
+          }
+        }
+
+        void poll_modified_files_() noexcept
+        {
+          const auto now = std::chrono::steady_clock::now();
+          if (now - last_poll_ < hot_reload_interval_) {
+            return;
+          }
+          last_poll_ = now;
+          std::vector<std::pair<resource_key, std::string>> modified;
+          for (auto &&watcher : watchers_) {
+            watcher->poll([this, &modified](const shiva::fs::path &file) {
+                //! the unloaded resources are loaded again from the modified file when they are requested.
+                if (auto it = watched_files_.find(file.string()); it != watched_files_.end() &&
+                                                                  this->is_resident_(it->second.first)) {
+                  vfs_->invalidate(it->second.second);
+                  modified.emplace_back(it->second);
+                }
+            });
+          }
+          if (!modified.empty()) {
+            hot_reload_(std::move(modified));
+          }
+        }
+
+        //! \note one task per file on the workers, the resources are replaced in place by main thread jobs.
+        void hot_reload_(std::vector<std::pair<resource_key, std::string>> files) noexcept
+        {
+          auto ticket = std::make_shared<load_ticket>();
+          ticket->trigger_event_ = false;
+          ticket->nb_files_ = static_cast<unsigned int>(files.size());
+          ticket->nb_decoding_batches_ = static_cast<unsigned int>(files.size());
+          nb_files_ += static_cast<unsigned int>(files.size());
+          working_ = true;
+          for (auto &&[key, path] : files) {
+            log_->info("resource modified: {0}", path);
+            tf_.silent_emplace([this, ticket, key = key, path = path]() {
+                try {
+                  this->decode_reload_(ticket, key, path);
+                }
+                catch (const std::exception &error) {
+                  this->log_->error("hot reload of {0} failed: {1}", path, error.what());
+                  ticket->failed_ = true;
+                  ticket->nb_files_--;
+                }
+                ticket->nb_decoding_batches_--;
+            });
+          }
+          ticket->decoding_future_ = tf_.dispatch();
+          tickets_.push_back(ticket);
+        }
+
+        //! \note worker, decode the modified file and push its replacement in place to the main thread.
+        void decode_reload_(const std::shared_ptr<load_ticket> &ticket, const resource_key &key,
+                            const std::string &path)
+        {
+          switch (key.category) {
+            case resource_residency::texture: {
+              auto image = decode_<sf::Image>(path);
+              push_main_thread_job_(ticket, [this, id = key.id, image]() {
+                  return this->reload_texture_(id, *image);
+              });
+              break;
+            }
+            case resource_residency::sound: {
+              if (compressed_sounds_.contains(key.id)) {
+                auto bytes = read_bytes_(path);
+                push_main_thread_job_(ticket, [this, id = key.id, path, bytes]() {
+                    //! unloaded meanwhile
+                    return !this->compressed_sounds_.contains(id) || this->insert_compressed_sound_(id, bytes, path);
+                });
+                break;
+              }
+              auto buffer = decode_<sf::SoundBuffer>(path);
+              push_main_thread_job_(ticket, [this, id = key.id, buffer]() {
+                  auto *sound = sounds_.find(id);
+                  //! loadFromSamples keeps the sounds attached to the buffer.
+                  return sound != nullptr && sound->loadFromSamples(buffer->getSamples(), buffer->getSampleCount(),
+                                                                    buffer->getChannelCount(),
+                                                                    buffer->getSampleRate());
+              });
+              break;
+            }
+            case resource_residency::font: {
+              auto font = decode_<sf::Font>(path);
+              push_main_thread_job_(ticket, [this, id = key.id, font]() {
+                  auto *current = fonts_.find(id);
+                  if (current == nullptr) {
+                    return false;
+                  }
+                  *current = *font;
+                  return true;
+              });
+              break;
+            }
+            case resource_residency::anim_cfg: {
+              auto cfg = decode_<animation_config>(path);
+              push_main_thread_job_(ticket, [this, ticket, id = key.id, cfg]() {
+                  auto *current = anim_cfgs_.find(id);
+                  if (current == nullptr) {
+                    return false;
+                  }
+                  *current = *cfg;
+                  this->replace_dependencies_(ticket, resource_key{resource_residency::anim_cfg, id},
+                                              {resource_key{resource_residency::texture, cfg->texture_id}});
+                  return true;
+              });
+              break;
+            }
+            default:
+              ticket->nb_files_--;
+              break;
+          }
+        }
+
+        //! \note main thread, the texture (or its region of an atlas page) is updated in place.
+        bool reload_texture_(resource_id id, const sf::Image &image) noexcept
+        {
+          if (const auto *region = atlas_regions_.find(id); region != nullptr) {
+            auto *page = textures_.find(region->page);
+            const auto &rect = region->rect;
+            if (page == nullptr || image.getSize() != sf::Vector2u(static_cast<unsigned int>(rect.width),
+                                                                   static_cast<unsigned int>(rect.height))) {
+              log_->warn("{0} changed size, it will be packed again at the next loading of its folder", id.name());
+              return false;
+            }
+            page->update(image, static_cast<unsigned int>(rect.left), static_cast<unsigned int>(rect.top));
+            return true;
+          }
+          auto *texture = textures_.find(id);
+          return texture != nullptr && texture->loadFromImage(image);
+        }
+
+        bool is_unloaded_since_(const resource_key &key, std::uint64_t nb_unloads) const noexcept
+        {
+          auto it = unloaded_.find(key);
+          return it != unloaded_.end() && it->second > nb_unloads;
+        }
+
+        bool is_resident_(const resource_key &key) const noexcept
+        {
+          switch (key.category) {
+            case resource_residency::texture:
+              return textures_.contains(key.id) || atlas_regions_.contains(key.id) || texture_sizes_.contains(key.id);
+            case resource_residency::music:
+              return musics_.contains(key.id);
+            case resource_residency::sound:
+              return sounds_.contains(key.id) || compressed_sounds_.contains(key.id);
+            case resource_residency::font:
+              return fonts_.contains(key.id);
+            case resource_residency::anim_cfg:
+              return anim_cfgs_.contains(key.id);
+            case resource_residency::video:
+              return videos_.contains(key.id);
+          }
+          return false;
+        }
+
+        /**
+         * \note load the files and their known dependencies in one batch (decoded in parallel),
+         * without after_load_resources event, the resources already resident or in flight are skipped.
+         * \param ticket ticket the files are added to, a new one if nullptr
+         */
+        std::shared_ptr<load_ticket> schedule_(std::vector<load_batch::file> files,
+                                               std::shared_ptr<load_ticket> ticket = nullptr) noexcept
+        {
+          if (ticket == nullptr) {
+            ticket = std::make_shared<load_ticket>();
+            ticket->trigger_event_ = false;
+          }
+          std::unordered_map<resource_key, std::string> paths;
+          std::vector<resource_key> keys;
+          for (auto &&file : files) {
+            const resource_key key{static_cast<resource_residency::category>(file.loader_idx), file.id};
+            keys.push_back(key);
+            dependency_only_.erase(key);
+            paths.insert_or_assign(key, std::move(file.path));
+          }
+
+          auto batch = make_batch_(ticket, "");
+          for (auto &&key : graph_.load_order(keys)) {
+            if (is_resident_(key) || in_flight_.count(key)) {
+              continue;
+            }
+            std::string path;
+            if (auto it = paths.find(key); it != paths.end() && !it->second.empty()) {
+              path = std::move(it->second);
+            } else if (auto index_it = lazy_index_[key.category].find(key.id);
+                index_it != lazy_index_[key.category].end()) {
+              path = index_it->second;
+            } else {
+              continue;
+            }
+            in_flight_.emplace(key, ticket);
+            batch->files.push_back(load_batch::file{key.id, std::move(path), key.category});
+          }
+          if (!batch->files.empty()) {
+            log_->info("loading {0} resources on demand", batch->files.size());
+            dispatch_batch_(ticket, batch, std::nullopt);
+          } else {
+            watch_ticket_(ticket);
+          }
+          return ticket;
+        }
+
+        /**
+         * \note main thread, a decoded resource depends on another one: the dependency is loaded with the same ticket
+         * if it is indexed and not resident.
+         */
+        void add_dependency_(const std::shared_ptr<load_ticket> &ticket, const resource_key &dependent,
+                             const resource_key &dependency) noexcept
+        {
+          graph_.add_dependency(dependent, dependency);
+          if (is_resident_(dependency) || in_flight_.count(dependency) ||
+              !lazy_index_[dependency.category].count(dependency.id)) {
+            return;
+          }
+          schedule_({load_batch::file{dependency.id, lazy_index_[dependency.category].at(dependency.id),
+                                      dependency.category}}, ticket);
+          dependency_only_.insert(dependency);
+        }
+
+        /**
+         * \note main thread, a reloaded resource has new dependencies: its edges are replaced, the previous
+         * dependencies no longer needed are released like the orphans of an unloaded resource.
+         */
+        void replace_dependencies_(const std::shared_ptr<load_ticket> &ticket, const resource_key &dependent,
+                                   const std::vector<resource_key> &dependencies) noexcept
+        {
+          for (auto &&orphan : graph_.replace_dependencies(dependent, dependencies)) {
+            if (dependency_only_.count(orphan)) {
+              release_(orphan);
+            }
+          }
+          for (auto &&dependency : dependencies) {
+            add_dependency_(ticket, dependent, dependency);
+          }
+        }
+
+        //! \note main thread, unload the resource then its dependencies which are no longer needed.
+        void release_(const resource_key &key) noexcept
+        {
+          discard_(key.category, key.id);
+          residency_.untrack(key.category, key.id);
+          dependency_only_.erase(key);
+          unloaded_.insert_or_assign(key, ++nb_unloads_);
+          release_orphans_(key);
+        }
+
+        /**
+         * \note main thread, remove the dependencies of the resource from the graph and release the ones
+         * which were loaded only as dependencies, the resources loaded explicitly (a folder, a request)
+         * may be used by the sprites and stay loaded.
+         */
+        void release_orphans_(const resource_key &key) noexcept
+        {
+          for (auto &&orphan : graph_.remove(key)) {
+            if (dependency_only_.count(orphan)) {
+              release_(orphan);
+            }
+          }
+        }
+
+        /**
+         * \note the returned functor runs on a worker: it decodes the file (into a sf::Image for the textures)
+         * and push the insertion in the cache (and the upload of the texture) to the main thread.
+         */
+        template <typename ResourceType, typename ResourceCache>
+        load_batch::loader_t make_async_loader_(ResourceCache &cache, std::shared_ptr<load_ticket> ticket,
+                                                load_batch *batch = nullptr) noexcept
+        {
+          return [this, &cache, ticket = std::move(ticket), batch, nb_unloads = nb_unloads_](
+              resource_id id, const std::string &path, shiva::filesystem::vfs::read_result data) {
+              //! a resource unloaded while it was decoded is not inserted
+              auto push_insertion = [this, &ticket, key = resource_key{category_of_(cache), id}, nb_unloads](
+                  std::function<bool()> job) {
+                  this->push_main_thread_job_(ticket, [this, key, nb_unloads, job = std::move(job)]() {
+                      return this->is_unloaded_since_(key, nb_unloads) || job();
+                  });
+              };
+              try {
+                if constexpr (!std::is_same_v<ResourceType, animation_config>) {
+                  if (this->headless_) {
+                    if constexpr (std::is_same_v<ResourceType, sf::Texture>) {
+                      //! even an empty texture needs a GL context, only the size is kept
+                      auto size = std::make_shared<sf::Vector2u>(this->read_texture_size_(path, std::move(data)));
+                      push_insertion([this, id, size]() {
+                          this->texture_sizes_.assign(id, size);
+                          return true;
+                      });
+                    } else {
+                      push_insertion([this, &cache, id, path]() {
+                          return this->insert_resource_(cache, id, this->stub_<ResourceType>(), path, 0u, false);
+                      });
+                    }
+                    return true;
+                  }
+                }
+                if constexpr (std::is_same_v<ResourceType, sf::SoundBuffer>) {
+                  if (this->compress_sounds_) {
+                    auto bytes = this->read_bytes_(path, std::move(data));
+                    push_insertion([this, id, path, bytes]() {
+                        if (this->compressed_sounds_.contains(id)) {
+                          return true;
+                        }
+                        this->watch_file_(path, resource_key{resource_residency::sound, id});
+                        return this->insert_compressed_sound_(id, bytes, path);
+                    });
+                    return true;
+                  }
+                }
+                if constexpr (std::is_same_v<ResourceType, sf::Texture>) {
+                  auto image = this->decode_<sf::Image>(path, std::move(data));
+                  if (batch != nullptr && batch->atlas && image->getSize().x <= batch->atlas->max_texture_size &&
+                      image->getSize().y <= batch->atlas->max_texture_size) {
+                    std::scoped_lock lock(batch->atlas_mutex);
+                    batch->atlas_images.emplace_back(id, std::move(image));
+                    batch->atlas_paths.emplace(id, path);
+                    return true;
+                  }
+                  push_insertion([this, id, path, image]() {
+                      return this->upload_texture_(id, path, *image);
+                  });
+                } else {
+                  auto resource = this->decode_<ResourceType>(path, std::move(data));
+                  const auto file_size = this->file_size_(path);
+                  push_insertion([this, &cache, id, path, resource, file_size, ticket]() {
+                      if (!this->insert_resource_(cache, id, resource, path, file_size)) {
+                        return false;
+                      }
+                      this->watch_file_(path, resource_key{category_of_(cache), id});
+                      if constexpr (std::is_same_v<ResourceType, animation_config>) {
+                        this->add_dependency_(ticket, resource_key{resource_residency::anim_cfg, id},
+                                              resource_key{resource_residency::texture, resource->texture_id});
+                      }
+                      return true;
+                  });
+                }
+              }
+              catch (...) {
+                ticket->failed_ = true;
+                ticket->nb_files_--;
+                throw;
+              }
+              return true;
+          };
+        }
+
+        //! \note get_resource without pinning the resource, for the resources given to the sprites
+        template <typename ResourceType, typename ResourceCache>
+        const ResourceType &lookup_(const ResourceCache &resources, resource_id id) const noexcept
+        {
+          const auto *resource = resources.find(id);
+          trace_.record(resource_key{category_of_(resources), id});
+          if (std::this_thread::get_id() != main_thread_id_) {
+            if (resource == nullptr) {
+              request_remote_(resource_key{category_of_(resources), id});
+              return placeholder_<ResourceType>();
+            }
+            return *resource;
+          }
+          if (resource == nullptr) {
+            log_->debug("resource {0} is not available, using a placeholder", id.name());
+            const auto category = category_of_(resources);
+            if (auto path = residency_.miss(category, id); path) {
+              requests_.push_back(load_batch::file{id, std::move(*path), category});
+            } else if (auto it = lazy_index_[category].find(id); it != lazy_index_[category].end()) {
+              requests_.push_back(load_batch::file{id, it->second, category});
+            }
+            return placeholder_<ResourceType>();
+          }
+          residency_.touch(category_of_(resources), id);
+          return *resource;
+        }
+
+        /**
+         * \note insert a decoded resource in his cache and track its memory, main thread only.
+         * \note a resource already in the cache is kept.
+         */
+        template <typename ResourceType>
+        bool insert_resource_(resource_cache<ResourceType> &cache, resource_id id,
+                              std::shared_ptr<ResourceType> resource, const std::string &path, size_t file_size,
+                              bool evictable = true)
+        {
+          if (cache.contains(id)) {
+            return true;
+          }
+          const auto *resource_ptr = resource.get();
+          if (!cache.template load<shared_loader<ResourceType>>(id, std::move(resource))) {
+            return false;
+          }
+          resource_residency::entry resident;
+          resident.bytes = resource_bytes_(*resource_ptr, file_size);
+          resident.resource = resource_ptr;
+          resident.path = path;
+          resident.evictable = evictable;
+          residency_.track(category_of_(cache), id, std::move(resident));
+          return true;
+        }
+
+        template <typename ResourceType>
+        static constexpr resource_residency::category
+        category_of_(const resource_cache<ResourceType> &) noexcept
+        {
+          if constexpr (std::is_same_v<ResourceType, sf::Texture>) {
+            return resource_residency::texture;
+          } else if constexpr (std::is_same_v<ResourceType, sf::Music>) {
+            return resource_residency::music;
+          } else if constexpr (std::is_same_v<ResourceType, sf::SoundBuffer>) {
+            return resource_residency::sound;
+          } else if constexpr (std::is_same_v<ResourceType, sf::Font>) {
+            return resource_residency::font;
+          } else if constexpr (std::is_same_v<ResourceType, animation_config>) {
+            return resource_residency::anim_cfg;
+          } else {
+            return resource_residency::video;
+          }
+        }
+
+        //! \return estimation of the memory used by the resource, the file size when the type doesn't tell it
+        template <typename ResourceType>
+        static size_t resource_bytes_(const ResourceType &resource, size_t file_size) noexcept
+        {
+          if constexpr (std::is_same_v<ResourceType, sf::Texture>) {
+            return static_cast<size_t>(resource.getSize().x) * resource.getSize().y * 4u;
+          } else if constexpr (std::is_same_v<ResourceType, sf::SoundBuffer>) {
+            return static_cast<size_t>(resource.getSampleCount()) * sizeof(sf::Int16);
+          } else if constexpr (std::is_same_v<ResourceType, sf::Music>) {
+            //! streamed, one second of samples is buffered.
+            return static_cast<size_t>(resource.getSampleRate()) * resource.getChannelCount() * sizeof(sf::Int16);
+          } else if constexpr (std::is_same_v<ResourceType, animation_config>) {
+            return sizeof(animation_config);
+          } else {
+            return file_size;
+          }
+        }
+
+        size_t file_size_(const std::string &path) const noexcept
+        {
+          const auto stat = vfs_->stat(path);
+          return stat ? static_cast<size_t>(stat->size) : 0u;
+        }
+
+        //! discard an evicted resource from his cache
+        //! \return true if a handle (get_handle, a voice of the sound bank) keeps the resource alive outside of its cache
+        //! or if the music is playing
+        bool is_held_(resource_residency::category category, resource_id id) const noexcept
+        {
+          auto held = [id](auto &&cache) {
+              //! the cache and the handle taken here
+              return cache.handle(id).use_count() > 2;
+          };
+          switch (category) {
+            case resource_residency::texture:
+              return held(textures_);
+            case resource_residency::music:
+              if (auto music = musics_.handle(id); music && music->getStatus() != sf::Music::Stopped) {
+                return true;
+              }
+              return held(musics_);
+            case resource_residency::sound:
+              return held(sounds_);
+            case resource_residency::font:
+              return held(fonts_);
+            case resource_residency::anim_cfg:
+              return held(anim_cfgs_);
+            case resource_residency::video:
+              return held(videos_);
+          }
+          return false;
+        }
+
+        void discard_(resource_residency::category category, resource_id id) noexcept
+        {
+          switch (category) {
+            case resource_residency::texture:
+              textures_.discard(id);
+              texture_sizes_.discard(id);
+              break;
+            case resource_residency::music:
+              musics_.discard(id);
+              break;
+            case resource_residency::sound:
+              sounds_.discard(id);
+              compressed_sounds_.discard(id);
+              sound_bank_.discard(id);
+              break;
+            case resource_residency::font:
+              fonts_.discard(id);
+              break;
+            case resource_residency::anim_cfg:
+              anim_cfgs_.discard(id);
+              break;
+            case resource_residency::video:
+              videos_.discard(id);
+              break;
+          }
+          log_->debug("resource {0} evicted", id.name());
+        }
+
+        /**
+         * \note decode a resource from its virtual path: without copy from an archive (uncompressed entry)
+         * or an overlay, from a pooled buffer of the vfs otherwise.
+         * \note the loose videos, fonts and musics are opened from their file (streamed),
+         * the loose animation configs from their compiled form.
+         * \param data content of the file if it has been prefetched, read here otherwise
+         */
+        template <typename ResourceType>
+        std::shared_ptr<ResourceType> decode_(const std::string &path,
+                                              shiva::filesystem::vfs::read_result data = std::nullopt) const
+        {
+          if constexpr (std::is_same_v<ResourceType, sfe::Movie> || std::is_same_v<ResourceType, sf::Music> ||
+                        std::is_same_v<ResourceType, sf::Font> || std::is_same_v<ResourceType, animation_config>) {
+            if (auto disk_path = vfs_->disk_path(path); disk_path) {
+              return loader<ResourceType>{}.load(disk_path->string());
+            }
+          }
+          if constexpr (std::is_same_v<ResourceType, sfe::Movie>) {
+            throw std::runtime_error("videos can only be loaded from a directory");
+          } else {
+            if (data) {
+              return loader<ResourceType>{}.load_from_memory(data->data(), data->size());
+            }
+            if (auto view = vfs_->view(path); view) {
+              return loader<ResourceType>{}.load_from_memory(view->data(), view->size());
+            }
+            if constexpr (std::is_same_v<ResourceType, sf::Music> || std::is_same_v<ResourceType, sf::Font>) {
+              throw std::runtime_error("streamed resources must be stored uncompressed");
+            } else {
+              auto buffer = vfs_->read(path);
+              if (!buffer) {
+                throw std::runtime_error("Impossible to read " + path);
+              }
+              return loader<ResourceType>{}.load_from_memory(buffer->data(), buffer->size());
+            }
+          }
+        }
+
+        //! \return the whole content of a file (the prefetched data if any), for the compressed sounds
+        std::shared_ptr<std::string> read_bytes_(const std::string &path,
+                                                 shiva::filesystem::vfs::read_result data = std::nullopt) const
+        {
+          if (data) {
+            return std::make_shared<std::string>(data->view());
+          }
+          if (auto view = vfs_->view(path); view) {
+            return std::make_shared<std::string>(*view);
+          }
+          data = vfs_->read(path);
+          if (!data) {
+            throw std::runtime_error("Impossible to read " + path);
+          }
+          return std::make_shared<std::string>(data->view());
+        }
+
+        //! \note main thread, add or replace a compressed sound, its memory is the size of its file
+        bool insert_compressed_sound_(resource_id id, std::shared_ptr<std::string> bytes, const std::string &path)
+        {
+          resource_residency::entry resident;
+          resident.bytes = bytes->size();
+          resident.resource = bytes.get();
+          //! the voices play its decoded buffer, the compressed bytes can be evicted meanwhile
+          resident.path = path;
+          compressed_sounds_.assign(id, bytes);
+          sound_bank_.add(id, std::move(bytes));
+          residency_.track(resource_residency::sound, id, std::move(resident));
+          return true;
+        }
+
+        //! \return the virtual path of a directory of the resources
+        std::string virtual_directory_(const shiva::fs::path &directory) const noexcept
+        {
+          return vfs_->to_virtual(directory).value_or(directory.generic_string());
+        }
+
+        /**
+         * \note runs on a worker once every file of the batch is decoded, the pages are uploaded by the main thread.
+         */
+        void pack_atlas_(load_batch &batch, const std::shared_ptr<load_ticket> &ticket)
+        {
+          const auto nb_textures = batch.atlas_images.size();
+          std::vector<std::pair<resource_id, std::shared_ptr<sf::Image>>> unpacked;
+          auto pages = pack_atlas(std::move(batch.atlas_images), *batch.atlas, unpacked);
+          log_->info("{0} textures of {1} packed in {2} atlas pages", nb_textures - unpacked.size(), batch.folder,
+                     pages.size());
+          //! too big for a page with its padding
+          for (auto &&[id, image] : unpacked) {
+            push_main_thread_job_(ticket, [this, id = id, image = image, path = batch.atlas_paths[id],
+                                           nb_unloads = batch.nb_unloads]() {
+                return this->is_unloaded_since_(resource_key{resource_residency::texture, id}, nb_unloads) ||
+                       this->upload_texture_(id, path, *image);
+            });
+          }
+          for (size_t page_idx = 0u; page_idx < pages.size(); ++page_idx) {
+            auto page = std::make_shared<atlas_page>(std::move(pages[page_idx]));
+            auto page_name = batch.folder + "/__atlas_" + std::to_string(page_idx);
+            const auto page_id = resource_id::intern(page_name);
+            std::vector<std::string> paths;
+            for (auto &&region : page->regions) {
+              paths.push_back(batch.atlas_paths[region.first]);
+            }
+            ticket->nb_pending_jobs_++;
+            std::scoped_lock lock(jobs_mutex_);
+            jobs_.push_back(main_thread_job{ticket, [this, page, page_id, page_name, paths = std::move(paths),
+                                                     folder = batch.folder, nb_unloads = batch.nb_unloads]() {
+                auto texture = std::make_shared<sf::Texture>();
+                if (!texture->loadFromImage(page->image)) {
+                  throw std::runtime_error("Impossible to upload atlas page");
+                }
+                //! the regions of a page are looked up by their own id, a page is never evicted.
+                if (!this->insert_resource_(textures_, page_id, std::move(texture), page_name, 0u, false)) {
+                  return false;
+                }
+                for (size_t idx = 0u; idx < page->regions.size(); ++idx) {
+                  const auto &[id, rect] = page->regions[idx];
+                  if (this->is_unloaded_since_(resource_key{resource_residency::texture, id}, nb_unloads)) {
+                    continue;
+                  }
+                  atlas_regions_.assign(id, std::make_shared<atlas_region>(atlas_region{page_id, rect}));
+                  this->watch_file_(paths[idx], resource_key{resource_residency::texture, id});
+                }
+                atlas_pages_[folder].push_back(page_id);
+                return true;
+            }, static_cast<unsigned int>(page->regions.size())});
+          }
+        }
+
+        //! \note main thread, upload the decoded image of a standalone texture and insert it
+        bool upload_texture_(resource_id id, const std::string &path, const sf::Image &image)
+        {
+          if (textures_.contains(id)) {
+            return true;
+          }
+          auto texture = std::make_shared<sf::Texture>();
+          if (!texture->loadFromImage(image)) {
+            throw std::runtime_error("Impossible to upload texture");
+          }
+          watch_file_(path, resource_key{resource_residency::texture, id});
+          return insert_resource_(textures_, id, std::move(texture), path, 0u);
+        }
+
+        void discard_atlas_(const std::string &folder) noexcept
+        {
+          auto it = atlas_pages_.find(folder);
+          if (it == atlas_pages_.end()) {
+            return;
+          }
+          const auto &pages = it->second;
+          for (auto &&page_id : pages) {
+            textures_.discard(page_id);
+            residency_.untrack(resource_residency::texture, page_id);
+          }
+          atlas_regions_.discard_if([&pages](resource_id, const atlas_region &region) {
+              return std::find(pages.begin(), pages.end(), region.page) != pages.end();
+          });
+          atlas_pages_.erase(it);
+        }
+
+        //! walks the directories of every kind of resource, the order of the calls matches load_batch::loaders.
+        void collect_resources_(load_batch &batch, const shiva::fs::path &additional_path) noexcept
+        {
+          auto collector = [&batch](size_t loader_idx) {
+              return [&batch, loader_idx](resource_id id, const std::string &path) {
+                  batch.files.push_back(load_batch::file{id, path, loader_idx});
+                  return true;
+              };
+          };
+          work_on_textures(collector(0u), additional_path);
+          work_on_musics(collector(1u), additional_path);
+          work_on_sounds(collector(2u), additional_path);
+          work_on_fonts(collector(3u), additional_path);
+          work_on_anim_cfg(collector(4u), additional_path);
+          work_on_videos(collector(5u), additional_path);
+        }
+
+        /**
+         * \note the files of the batch read into memory by their decoder (textures, sounds, archived configs)
+         * are read at once by the vfs: one submission for the loose files with io_uring, the decoders take
+         * the completed buffers instead of reading the files one by one.
+         */
+        void prefetch_(load_batch &batch) const
+        {
+          std::vector<std::string> paths;
+          std::vector<size_t> indexes;
+          for (size_t idx = 0u; idx < batch.files.size(); ++idx) {
+            const auto &current = batch.files[idx];
+            //! in headless mode only the header of the images is read and the sounds are not read at all
+            const bool in_memory = (!headless_ && (current.loader_idx == 0u || current.loader_idx == 2u)) ||
+                                   (current.loader_idx == 4u && !vfs_->disk_path(current.path));
+            if (in_memory && !vfs_->view(current.path)) {
+              paths.push_back(current.path);
+              indexes.push_back(idx);
+            }
+          }
+          if (paths.empty()) {
+            return;
+          }
+          auto reads = vfs_->read_batch(paths);
+          batch.reads.resize(batch.files.size());
+          for (size_t idx = 0u; idx < indexes.size(); ++idx) {
+            batch.reads[indexes[idx]] = std::move(reads[idx]);
+          }
+        }
+
+        void decode_resources_(load_batch &batch) noexcept
+        {
+          for (auto idx = batch.next_file++; idx < batch.files.size(); idx = batch.next_file++) {
+            const auto &current = batch.files[idx];
+            const auto start = std::chrono::steady_clock::now();
+            try {
+              shiva::filesystem::vfs::read_result data;
+              if (idx < batch.reads.size() && batch.reads[idx].valid()) {
+                data = batch.reads[idx].get();
+              }
+              batch.loaders[current.loader_idx](current.id, current.path, std::move(data));
+              decoding_time_us_ += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - start).count());
+              log_->debug("decoded: [ id: {0}, path: {1} ]", current.id.name(), current.path);
+            }
+            catch (const std::exception &error) {
+              this->log_->error("error occured: {0}, path: {1}", error.what(), current.path);
+              nb_files_--;
+            }
+          }
+        }
+
+        //! \note the paths of the resources are the ones they have been loaded from (or indexed with)
+        void save_trace_() noexcept
+        {
+          try {
+            if (!trace_.stop([this](const resource_key &key) -> std::optional<std::string> {
+                if (auto path = residency_.path_of(key.category, key.id); path && vfs_->exists(*path)) {
+                  return path;
+                }
+                if (auto it = lazy_index_[key.category].find(key.id); it != lazy_index_[key.category].end()) {
+                  return it->second;
+                }
+                return std::nullopt;
+            })) {
+              log_->warn("unable to save the access trace of the scene");
+            }
+          }
+          catch (const std::exception &error) {
+            log_->error("error occured: {0}", error.what());
+          }
+        }
+
+        //! \note any thread, the request is resolved (evicted or indexed resource) by the next update
+        void request_remote_(resource_key key) const noexcept
+        {
+          std::scoped_lock lock(remote_misses_mutex_);
+          remote_misses_.push_back(key);
+        }
+
+        void resolve_remote_misses_() noexcept
+        {
+          std::vector<resource_key> misses;
+          {
+            std::scoped_lock lock(remote_misses_mutex_);
+            misses.swap(remote_misses_);
+          }
+          for (auto &&key : misses) {
+            if (is_resident_(key)) {
+              continue;
+            }
+            if (auto path = residency_.miss(key.category, key.id); path) {
+              requests_.push_back(load_batch::file{key.id, std::move(*path), key.category});
+            } else if (auto it = lazy_index_[key.category].find(key.id); it != lazy_index_[key.category].end()) {
+              requests_.push_back(load_batch::file{key.id, it->second, key.category});
+            }
+          }
+        }
+
+        template <typename ResourceType>
+        const resource_cache<ResourceType> &cache_of_() const noexcept
+        {
+          if constexpr (std::is_same_v<ResourceType, sf::Texture>) {
+            return textures_;
+          } else if constexpr (std::is_same_v<ResourceType, sf::Music>) {
+            return musics_;
+          } else if constexpr (std::is_same_v<ResourceType, sf::SoundBuffer>) {
+            return sounds_;
+          } else if constexpr (std::is_same_v<ResourceType, sf::Font>) {
+            return fonts_;
+          } else if constexpr (std::is_same_v<ResourceType, animation_config>) {
+            return anim_cfgs_;
+          } else {
+            return videos_;
+          }
+        }
+
+        //! \note headless mode, the resources share their placeholder (not owned by the handle)
+        template <typename ResourceType>
+        std::shared_ptr<ResourceType> stub_() const noexcept
+        {
+          return std::shared_ptr<ResourceType>(std::shared_ptr<ResourceType>{}, &placeholder_<ResourceType>());
+        }
+
+        /**
+         * \note headless mode, the size of an image from its header (the prefetched data, an uncompressed entry
+         * of an archive or the first bytes of the file), from its decoding if the header is not enough.
+         */
+        sf::Vector2u read_texture_size_(const std::string &path, shiva::filesystem::vfs::read_result data) const
+        {
+          std::string prefix;
+          std::string_view bytes;
+          if (!data) {
+            if (auto view = vfs_->view(path); view) {
+              bytes = *view;
+            } else if (auto disk_path = vfs_->disk_path(path); disk_path) {
+              std::ifstream ifs(*disk_path, std::ios::binary);
+              prefix.resize(image_header::prefix_size);
+              ifs.read(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+              prefix.resize(static_cast<size_t>(ifs.gcount()));
+              bytes = prefix;
+            } else {
+              data = vfs_->read(path);
+            }
+          }
+          if (data) {
+            bytes = data->view();
+          }
+          if (auto size = image_header::read_size(bytes, shiva::fs::path(path).extension().string()); size) {
+            return *size;
+          }
+          return decode_<sf::Image>(path, std::move(data))->getSize();
+        }
+
+        template <typename ResourceType>
+        ResourceType &placeholder_() const noexcept
+        {
+          std::scoped_lock lock(placeholders_mutex_);
+          auto &placeholder = std::get<std::unique_ptr<ResourceType>>(placeholders_);
+          if (!placeholder) {
+            placeholder = std::make_unique<ResourceType>();
+            if constexpr (std::is_same_v<ResourceType, sf::Texture>) {
+              sf::Image image;
+              image.create(2u, 2u, sf::Color::Magenta);
+              placeholder->loadFromImage(image);
+            }
+          }
+          return *placeholder;
+        }
+
+        void notify_ready_tickets_() noexcept
+        {
+          auto it = std::partition(tickets_.begin(), tickets_.end(), [](auto &&ticket) {
+              return !ticket->is_ready();
+          });
+          std::vector<std::shared_ptr<load_ticket>> ready_tickets(std::make_move_iterator(it),
+                                                                  std::make_move_iterator(tickets_.end()));
+          tickets_.erase(it, tickets_.end());
+          if (tickets_.empty() && working_) {
+            //! every graph is finished at this point, this only releases them.
+            tf_.wait_for_all();
+            working_ = false;
+            nb_files_ = 0;
+            current_files_loaded_ = 0;
+            //! no insertion is pending
+            unloaded_.clear();
+          }
+          for (auto &&ticket : ready_tickets) {
+            for (auto in_flight_it = in_flight_.begin(); in_flight_it != in_flight_.end();) {
+              in_flight_it = in_flight_it->second == ticket ? in_flight_.erase(in_flight_it) : std::next(in_flight_it);
+            }
+            log_->info("all resources have been loaded ({0} files)", ticket->get_nb_loaded());
+            for (auto &&callback : ticket->callbacks_) {
+              callback(*ticket);
+            }
+            if (ticket->trigger_event_) {
+              this->dispatcher_.trigger<shiva::event::after_load_resources>();
+            }
+          }
+          if (!waiters_.empty()) {
+            notify_waiters_();
+          }
+        }
+
+        //! \note a waiter gives up once no loading is in progress, the resource will not come
+        void notify_waiters_() noexcept
+        {
+          auto waiters = std::move(waiters_);
+          waiters_.clear();
+          for (auto &&[key, functor] : waiters) {
+            if (is_resident_(key)) {
+              functor(true);
+            } else if (tickets_.empty()) {
+              functor(false);
+            } else {
+              waiters_.emplace_back(key, std::move(functor));
+            }
+          }
+        }
     };
 }
@@ -0,0 +1,308 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <SFML/Audio/Sound.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <shiva/sfml/common/resource_id.hpp>
+
+namespace shiva::sfml
+{
+    /**
+     * \note This class plays the sounds of the resources_registry through a pool of voices: the sf::Sound are
+     * created up to the maximum number of voices and reused, when they are all busy the oldest one is taken.
+     * \note The compressed sounds (the bytes of their Ogg/FLAC/WAV file) are decoded on a worker at their first play,
+     * the decoded buffers are kept in a least recently used cache limited in bytes. A play waiting for its decoding
+     * is dropped if the decoding takes longer than max_latency.
+     * \note Main thread only, except the decodings given to the executor.
+     * \class sound_bank
+     */
+    class sound_bank
+    {
+    public:
+        //! Public typedefs
+        using executor = std::function<void(std::function<void()>)>;
+        using clock = std::chrono::steady_clock;
+
+        //! Public static members
+        static constexpr std::chrono::milliseconds max_latency{200};
+
+        //! Constructors
+        explicit sound_bank(executor run_on_worker) noexcept : run_on_worker_(std::move(run_on_worker))
+        {
+        }
+
+        //! Public member functions
+        void set_max_voices(size_t nb_voices) noexcept
+        {
+            max_voices_ = std::max<size_t>(1u, nb_voices);
+        }
+
+        //! \param budget bytes of the decoded buffers, the least recently played are dropped above it
+        void set_decoded_budget(size_t budget) noexcept
+        {
+            decoded_budget_ = budget;
+            shrink_();
+        }
+
+        //! \note add or replace a compressed sound, its decoded buffer is dropped (the voices keep playing it)
+        void add(resource_id id, std::shared_ptr<const std::string> data)
+        {
+            auto &current = compressed_[id];
+            current.data = std::move(data);
+            current.version++;
+            drop_decoded_(id);
+        }
+
+        void discard(resource_id id)
+        {
+            compressed_.erase(id);
+            drop_decoded_(id);
+        }
+
+        bool contains(resource_id id) const noexcept
+        {
+            return compressed_.count(id) != 0u;
+        }
+
+        /**
+         * \note play a compressed sound, immediately if it is decoded, once its decoding is done otherwise.
+         * \return false if the sound is unknown
+         */
+        bool play(resource_id id, float volume = 100.f, float pitch = 1.f)
+        {
+            auto it = compressed_.find(id);
+            if (it == compressed_.end()) {
+                return false;
+            }
+            if (auto decoded_it = decoded_.find(id); decoded_it != decoded_.end()) {
+                lru_.splice(lru_.begin(), lru_, decoded_it->second.lru);
+                return play(decoded_it->second.buffer, volume, pitch);
+            }
+            pending_plays_.push_back(pending_play{id, volume, pitch, clock::now()});
+            decode_(id, it->second);
+            return true;
+        }
+
+        //! \note play a decoded buffer on a voice of the pool
+        bool play(std::shared_ptr<sf::SoundBuffer> buffer, float volume = 100.f, float pitch = 1.f)
+        {
+            if (buffer == nullptr) {
+                return false;
+            }
+            auto &current = acquire_voice_();
+            current.sound.setBuffer(*buffer);
+            current.buffer = std::move(buffer);
+            current.sound.setVolume(volume);
+            current.sound.setPitch(pitch);
+            current.started = ++nb_plays_;
+            current.sound.play();
+            return true;
+        }
+
+        void stop_all() noexcept
+        {
+            for (auto &&current : voices_) {
+                current->sound.stop();
+            }
+            pending_plays_.clear();
+        }
+
+        //! \note keep the decoded buffers, start the plays waiting for them, release the buffers of the idle voices
+        void update()
+        {
+            std::vector<decoding_result> results;
+            {
+                std::scoped_lock lock(shared_->mutex);
+                results.swap(shared_->results);
+            }
+            std::unordered_set<resource_id> failed;
+            for (auto &&result : results) {
+                decoding_.erase(result.id);
+                auto it = compressed_.find(result.id);
+                if (it == compressed_.end() || it->second.version != result.version) {
+                    continue;
+                }
+                if (result.buffer == nullptr) {
+                    failed.insert(result.id);
+                    continue;
+                }
+                lru_.push_front(result.id);
+                const auto bytes = static_cast<size_t>(result.buffer->getSampleCount()) * sizeof(sf::Int16);
+                decoded_bytes_ += bytes;
+                decoded_.insert_or_assign(result.id, decoded{std::move(result.buffer), bytes, lru_.begin()});
+            }
+
+            const auto now = clock::now();
+            std::vector<pending_play> waiting;
+            for (auto &&current : pending_plays_) {
+                if (auto it = decoded_.find(current.id); it != decoded_.end()) {
+                    if (now - current.requested <= max_latency) {
+                        play(it->second.buffer, current.volume, current.pitch);
+                    }
+                } else if (decoding_.count(current.id) != 0u) {
+                    waiting.push_back(current);
+                } else if (auto compressed_it = compressed_.find(current.id);
+                    compressed_it != compressed_.end() && !failed.count(current.id)) {
+                    //! the sound has been replaced while it was decoded
+                    decode_(current.id, compressed_it->second);
+                    waiting.push_back(current);
+                }
+            }
+            pending_plays_.swap(waiting);
+            shrink_();
+
+            for (auto &&current : voices_) {
+                if (current->buffer != nullptr && current->sound.getStatus() == sf::Sound::Stopped) {
+                    current->sound.resetBuffer();
+                    current->buffer = nullptr;
+                }
+            }
+        }
+
+        size_t nb_voices() const noexcept
+        {
+            return voices_.size();
+        }
+
+        size_t nb_playing() const noexcept
+        {
+            return static_cast<size_t>(std::count_if(voices_.begin(), voices_.end(), [](auto &&current) {
+                return current->sound.getStatus() == sf::Sound::Playing;
+            }));
+        }
+
+        size_t decoded_bytes() const noexcept
+        {
+            return decoded_bytes_;
+        }
+
+        //! \return true if a decoding given to the executor is not collected by update yet
+        bool is_decoding() const noexcept
+        {
+            return !decoding_.empty();
+        }
+
+    private:
+        //! Private typedefs
+        struct compressed
+        {
+            std::shared_ptr<const std::string> data;
+            std::uint64_t version{0u};
+        };
+
+        struct decoded
+        {
+            std::shared_ptr<sf::SoundBuffer> buffer;
+            size_t bytes;
+            std::list<resource_id>::iterator lru;
+        };
+
+        struct voice
+        {
+            sf::Sound sound;
+            std::shared_ptr<sf::SoundBuffer> buffer;
+            std::uint64_t started{0u};
+        };
+
+        struct pending_play
+        {
+            resource_id id;
+            float volume;
+            float pitch;
+            clock::time_point requested;
+        };
+
+        struct decoding_result
+        {
+            resource_id id;
+            std::uint64_t version;
+            std::shared_ptr<sf::SoundBuffer> buffer;
+        };
+
+        //! \note shared with the decodings in progress, which can outlive the bank
+        struct shared_state
+        {
+            std::mutex mutex;
+            std::vector<decoding_result> results;
+        };
+
+        //! Private member functions
+        void decode_(resource_id id, const compressed &current)
+        {
+            if (!decoding_.insert(id).second) {
+                return;
+            }
+            run_on_worker_([shared = shared_, id, data = current.data, version = current.version]() {
+                auto buffer = std::make_shared<sf::SoundBuffer>();
+                if (!buffer->loadFromMemory(data->data(), data->size())) {
+                    buffer = nullptr;
+                }
+                std::scoped_lock lock(shared->mutex);
+                shared->results.push_back(decoding_result{id, version, std::move(buffer)});
+            });
+        }
+
+        //! \note a free voice, a new one under the maximum, the oldest one otherwise
+        voice &acquire_voice_()
+        {
+            for (auto &&current : voices_) {
+                if (current->sound.getStatus() == sf::Sound::Stopped) {
+                    return *current;
+                }
+            }
+            if (voices_.size() < max_voices_) {
+                return *voices_.emplace_back(std::make_unique<voice>());
+            }
+            auto &oldest = **std::min_element(voices_.begin(), voices_.end(), [](auto &&lhs, auto &&rhs) {
+                return lhs->started < rhs->started;
+            });
+            oldest.sound.stop();
+            return oldest;
+        }
+
+        void drop_decoded_(resource_id id)
+        {
+            if (auto it = decoded_.find(id); it != decoded_.end()) {
+                decoded_bytes_ -= it->second.bytes;
+                lru_.erase(it->second.lru);
+                decoded_.erase(it);
+            }
+        }
+
+        //! \note the most recently played buffer is always kept
+        void shrink_()
+        {
+            while (decoded_bytes_ > decoded_budget_ && lru_.size() > 1u) {
+                drop_decoded_(lru_.back());
+            }
+        }
+
+        //! Private data members
+        executor run_on_worker_;
+        size_t max_voices_{32u};
+        size_t decoded_budget_{8u * 1024u * 1024u};
+        std::unordered_map<resource_id, compressed> compressed_;
+        std::unordered_map<resource_id, decoded> decoded_;
+        std::list<resource_id> lru_;
+        size_t decoded_bytes_{0u};
+        std::unordered_set<resource_id> decoding_;
+        std::vector<pending_play> pending_plays_;
+        std::shared_ptr<shared_state> shared_{std::make_shared<shared_state>()};
+        std::vector<std::unique_ptr<voice>> voices_;
+        std::uint64_t nb_plays_{0u};
+    };
+}
@@ -31,12 +31,17 @@ namespace shiva::plugins
         if (resources_registry_.is_working()) {
             auto &current_loaded = resources_registry_.get_nb_current_files_loaded_();
             auto &nb_files = resources_registry_.get_nb_files();
-            progress_ = static_cast<float>(current_loaded) / nb_files;
+            progress_ = nb_files != 0u ? static_cast<float>(current_loaded) / nb_files : 0.f;
             log_->info("loading files: {0} / {1}, percentage: {2}%",
                        current_loaded,
                        nb_files,
                        progress_ * 100);
         }
+        if (resources_registry_.is_over_memory_budget()) {
+            mark_referenced_resources_();
+        }
+        //! uploads the resources decoded by the workers, within the frame budget, then evicts if needed.
+        resources_registry_.update();
     }
 
     //! Reflection
@@ -50,23 +55,73 @@ namespace shiva::plugins
         return meta::makeMap();
     }
 
+    //! Private member functions
+    void resources_system::mark_referenced_resources_() noexcept
+    {
+        entity_registry_.view<shiva::ecs::drawable>().each([this]([[maybe_unused]] auto entity, auto &&drawable) {
+            auto drawable_impl = std::static_pointer_cast<shiva::sfml::drawable_component_impl>(drawable.drawable_);
+            if (drawable_impl == nullptr || drawable_impl->drawable == nullptr) {
+                return;
+            }
+            if (auto sprite = dynamic_cast<const sf::Sprite *>(drawable_impl->drawable.get()); sprite != nullptr) {
+                resources_registry_.mark_referenced(sprite->getTexture());
+            } else if (auto text = dynamic_cast<const sf::Text *>(drawable_impl->drawable.get()); text != nullptr) {
+                resources_registry_.mark_referenced(text->getFont());
+            } else {
+                //! videos, the drawable is the resource itself.
+                resources_registry_.mark_referenced(drawable_impl->concrete.get());
+            }
+        });
+    }
+
     //! Private member functions overriden
     void resources_system::on_set_user_data_() noexcept
     {
         state_ = static_cast<sol::state *>(static_cast<shiva::ecs::opaque_data *>(user_data_)->data_1);
         win_ = static_cast<sf::RenderWindow *>(static_cast<shiva::ecs::opaque_data *>(user_data_)->data_2);
-        assert(state_ != nullptr && win_ != nullptr);
+        assert(state_ != nullptr);
+        //! no window (dedicated server), only the metadata of the resources are loaded
+        if (win_ == nullptr) {
+            log_->info("no window, the resources are loaded in headless mode");
+            resources_registry_.set_headless(true);
+        }
         (*state_).new_enum<sfml::resources_registry::work_type>("work_type",
                                                                 {
                                                                     {"loading",   sfml::resources_registry::work_type::loading},
                                                                     {"unloading", sfml::resources_registry::work_type::unloading}
                                                                 });
-        (*state_).new_usertype<sf::Texture>("sf_texture");
-        (*state_).new_usertype<sf::Sprite>("sf_sprite",
-                                           "set_texture", &sf::Sprite::setTexture,
-                                           sol::base_classes,
-                                           sol::bases<sf::Drawable, sf::Transformable>());
-        shiva::lua::register_type<sfml::resources_registry>(*state_, log_);
+        //! bound the first time shiva.resource_registry is read (the load tickets come from it)
+        bindings_ = shiva::lua::register_plugin_bindings(*state_, "resource_registry", [this]() {
+            (*state_).new_usertype<sf::Texture>("sf_texture");
+            (*state_).new_usertype<sf::Sprite>("sf_sprite",
+                                               "set_texture", &sf::Sprite::setTexture,
+                                               sol::base_classes,
+                                               sol::bases<sf::Drawable, sf::Transformable>());
+            (*state_).new_usertype<sfml::load_ticket>("load_ticket",
+                                                      "is_ready", &sfml::load_ticket::is_ready,
+                                                      "succeeded", &sfml::load_ticket::succeeded,
+                                                      "progress", &sfml::load_ticket::progress,
+                                                      "on_ready", [](sfml::load_ticket &self, sol::function callback) {
+                                                          self.on_ready([callback](const sfml::load_ticket &ticket) {
+                                                              callback(std::cref(ticket));
+                                                          });
+                                                      });
+            shiva::lua::register_type<sfml::resources_registry>(*state_, log_);
+            (*state_)[sfml::resources_registry::class_name()]["index_resources"] = [](
+                sfml::resources_registry &self,
+                const char *additional_path) {
+                return self.index_resources(shiva::fs::path(additional_path));
+            };
+            (*state_)["shiva"]["resource_registry"] = std::ref(resources_registry_);
+        });
+
+        //! ids of the resources, to be computed once by the scripts and passed to the registry instead of the names.
+        (*state_)["shiva"]["resource_id"] = [](const char *name) {
+            return sfml::resource_id::intern(name);
+        };
+        (*state_)["shiva"]["resource_name"] = [](sfml::resource_id id) {
+            return std::string(id.name());
+        };
 
         (*state_)["shiva"]["is_key_pressed"] = [](shiva::input::keyboard::TKey key) {
             return sf::Keyboard::isKeyPressed(static_cast<sf::Keyboard::Key>(key));
@@ -74,7 +129,7 @@ namespace shiva::plugins
 
         (*state_)[entity_registry_.class_name()]["create_game_object_with_sprite"] = [this](
             [[maybe_unused]] shiva::entt::entity_registry &self_registry,
-            const char *texture_name,
+            sfml::resource_id texture_id,
             float pos_x, float pos_y) {
             auto entity_id = this->entity_registry_.create();
             auto sprite_ptr = std::make_shared<sf::Sprite>();
@@ -84,10 +139,36 @@ namespace shiva::plugins
                                                               std::static_pointer_cast<sf::Drawable>(sprite_ptr),
                                                               std::static_pointer_cast<sf::Transformable>(sprite_ptr)));
             sol::table self = (*state_)["shiva"]["resource_registry"];
-            const sf::Texture &texture = self["get_texture_c"](self, texture_name);
-            sprite_ptr->setTexture(texture);
+            const sfml::texture_region region = self["get_texture_region"](self, texture_id);
+            //! no texture in headless mode, the rect still gives the size of the sprite
+            if (region.texture != nullptr) {
+                sprite_ptr->setTexture(*region.texture);
+            }
+            sprite_ptr->setTextureRect(region.rect);
             sprite_ptr->setPosition(pos_x, pos_y);
 
+            //! still loading: the placeholder is replaced by the texture once it is available
+            if (!resources_registry_.get_texture_size(texture_id)) {
+                std::weak_ptr<sf::Sprite> weak_sprite = sprite_ptr;
+                resources_registry_.on_available(sfml::resource_residency::texture, texture_id,
+                                                 [this, weak_sprite, entity_id, texture_id](bool available) {
+                    auto sprite = weak_sprite.lock();
+                    if (!available || sprite == nullptr) {
+                        return;
+                    }
+                    const auto loaded = resources_registry_.get_texture_region(texture_id);
+                    if (loaded.texture != nullptr) {
+                        sprite->setTexture(*loaded.texture);
+                    }
+                    sprite->setTextureRect(loaded.rect);
+                    if (entity_registry_.valid(entity_id) && entity_registry_.has<shiva::ecs::transform_2d>(entity_id)) {
+                        auto &transform = entity_registry_.get<shiva::ecs::transform_2d>(entity_id);
+                        transform.width = static_cast<float>(loaded.rect.width);
+                        transform.height = static_cast<float>(loaded.rect.height);
+                    }
+                });
+            }
+
             //! Position
             entity_registry_.assign<shiva::ecs::transform_2d>(entity_id, pos_x, pos_y,
                                                               sprite_ptr->getTextureRect().width,
@@ -101,7 +182,7 @@ namespace shiva::plugins
         (*state_)[entity_registry_.class_name()]["create_text"] = [this](
             [[maybe_unused]] shiva::entt::entity_registry &self,
             const char *text,
-            const char *font_name,
+            sfml::resource_id font_id,
             unsigned int size) {
             auto entity_id = this->entity_registry_.create();
             auto &transformable = entity_registry_.assign<shiva::ecs::transform_2d>(entity_id);
@@ -111,12 +192,14 @@ namespace shiva::plugins
                                                               text_ptr,
                                                               std::static_pointer_cast<sf::Drawable>(text_ptr),
                                                               std::static_pointer_cast<sf::Transformable>(text_ptr)));
-            text_ptr->setFont(resources_registry_.get_font(font_name));
+            text_ptr->setFont(resources_registry_.get_font(font_id));
             text_ptr->setString(sf::String(text));
             text_ptr->setCharacterSize(size);
 
-            transformable.y = win_->getSize().x / 2.f;
-            transformable.x = win_->getSize().y / 2.f;
+            if (win_ != nullptr) {
+                transformable.y = win_->getSize().x / 2.f;
+                transformable.x = win_->getSize().y / 2.f;
+            }
             transformable.width = text_ptr->getGlobalBounds().width;
             transformable.height = text_ptr->getGlobalBounds().height;
             this->log_->info("Text created -> [y: {0}, x: {1}, width: {2}, height: {3}]",
@@ -126,9 +209,26 @@ namespace shiva::plugins
                              transformable.height);
 
             text_ptr->setPosition(transformable.x, transformable.y);
+
+            //! still loading: the placeholder is replaced by the font once it is available
+            if (!resources_registry_.is_available(sfml::resource_residency::font, font_id)) {
+                std::weak_ptr<sf::Text> weak_text = text_ptr;
+                resources_registry_.on_available(sfml::resource_residency::font, font_id,
+                                                 [this, weak_text, entity_id, font_id](bool available) {
+                    auto text = weak_text.lock();
+                    if (!available || text == nullptr) {
+                        return;
+                    }
+                    text->setFont(resources_registry_.get_font(font_id));
+                    if (entity_registry_.valid(entity_id) && entity_registry_.has<shiva::ecs::transform_2d>(entity_id)) {
+                        auto &transform = entity_registry_.get<shiva::ecs::transform_2d>(entity_id);
+                        transform.width = text->getGlobalBounds().width;
+                        transform.height = text->getGlobalBounds().height;
+                    }
+                });
+            }
             return entity_id;
         };
-        (*state_)["shiva"]["resource_registry"] = std::ref(resources_registry_);
     }
 }
 
@@ -38,6 +38,9 @@ namespace shiva::plugins
         static constexpr auto reflected_members() noexcept;
 
     private:
+        //! Private member functions
+        void mark_referenced_resources_() noexcept;
+
         //! Private member functions overriden
         void on_set_user_data_() noexcept final;
         
@@ -45,6 +48,7 @@ namespace shiva::plugins
         sfml::resources_registry resources_registry_;
         float progress_{0.0f};
         sol::state *state_{nullptr};
+        shiva::lua::plugin_bindings bindings_; //!< removed with the system, before the plugin is unloaded
         sf::RenderWindow *win_{nullptr};
     };
 }
\ No newline at end of file
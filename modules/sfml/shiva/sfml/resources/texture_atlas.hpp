@@ -0,0 +1,91 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <shiva/math/rect_packer.hpp>
+#include <shiva/sfml/common/texture_region.hpp>
+#include <shiva/sfml/common/resource_id.hpp>
+
+namespace shiva::sfml
+{
+    /**
+     * \note packing policy of a folder, the textures of the folder smaller than max_texture_size
+     * (on both axes) are packed in shared pages of page_size x page_size pixels.
+     */
+    struct atlas_config
+    {
+        unsigned int max_texture_size{256u};
+        unsigned int page_size{2048u};
+        unsigned int padding{1u};
+    };
+
+    struct atlas_page
+    {
+        sf::Image image;
+        std::vector<std::pair<resource_id, sf::IntRect>> regions;
+    };
+
+    /**
+     * \note pack the images in as few pages as possible, the images are copied into the pages.
+     * \param images pairs of [id, image]
+     * \param unpacked receives the images which don't fit in an empty page (with their padding),
+     * to be loaded as standalone textures
+     */
+    inline std::vector<atlas_page> pack_atlas(std::vector<std::pair<resource_id, std::shared_ptr<sf::Image>>> images,
+                                              const atlas_config &cfg,
+                                              std::vector<std::pair<resource_id, std::shared_ptr<sf::Image>>> &unpacked)
+    {
+        std::sort(images.begin(), images.end(), [](auto &&lhs, auto &&rhs) {
+            return lhs.second->getSize().y > rhs.second->getSize().y;
+        });
+
+        std::vector<atlas_page> pages;
+        std::vector<shiva::math::rect_packer> packers;
+        for (auto &&current : images) {
+            const auto &id = current.first;
+            const auto &image = *current.second;
+            const auto size = image.getSize();
+            const auto insert = [&](size_t page_idx) {
+                auto res = packers[page_idx].insert(size.x + cfg.padding, size.y + cfg.padding);
+                if (!res) {
+                    return false;
+                }
+                pages[page_idx].image.copy(image, res->x, res->y);
+                pages[page_idx].regions.emplace_back(id, sf::IntRect(static_cast<int>(res->x),
+                                                                     static_cast<int>(res->y),
+                                                                     static_cast<int>(size.x),
+                                                                     static_cast<int>(size.y)));
+                return true;
+            };
+
+            bool inserted = false;
+            for (size_t page_idx = 0u; page_idx < pages.size() && !inserted; ++page_idx) {
+                inserted = insert(page_idx);
+            }
+            if (inserted) {
+                continue;
+            }
+            if (size.x + cfg.padding > cfg.page_size || size.y + cfg.padding > cfg.page_size) {
+                unpacked.push_back(std::move(current));
+                continue;
+            }
+            packers.emplace_back(cfg.page_size, cfg.page_size);
+            pages.emplace_back();
+            pages.back().image.create(cfg.page_size, cfg.page_size, sf::Color::Transparent);
+            if (!insert(pages.size() - 1u)) {
+                packers.pop_back();
+                pages.pop_back();
+                unpacked.push_back(std::move(current));
+            }
+        }
+        return pages;
+    }
+}
@@ -75,7 +75,6 @@ namespace shiva::plugins
         state_ = static_cast<sol::state *>(opaque_data->data_1);
         win_ = static_cast<sf::RenderWindow *>(opaque_data->data_2);
 
-        shiva::lua::register_type<video_system>(*state_, log_);
         state_->new_enum<status_t::EnumType>("video_status",
                                              {
                                                  {"playing", static_cast<status_t::EnumType>(status_t::playing)},
@@ -83,7 +82,11 @@ namespace shiva::plugins
                                                  {"stopped", static_cast<status_t::EnumType>(status_t::stopped)}
                                              });
 
-        (*state_)["shiva"]["video"] = std::ref(*this);
+        //! bound the first time shiva.video is read
+        bindings_ = shiva::lua::register_plugin_bindings(*state_, "video", [this]() {
+            shiva::lua::register_type<video_system>(*state_, log_);
+            (*state_)["shiva"]["video"] = std::ref(*this);
+        });
     }
 
     void video_system::add_video_(entt::entity_registry::entity_type entity,
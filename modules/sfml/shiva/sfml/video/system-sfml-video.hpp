@@ -48,6 +48,7 @@ namespace shiva::plugins
 
         void add_video_(entt::entity_registry::entity_type entity, status_t status, const char *video_id, sol::function func) noexcept;
         sol::state *state_{nullptr};
+        shiva::lua::plugin_bindings bindings_; //!< removed with the system, before the plugin is unloaded
         sf::RenderWindow *win_{nullptr};
     };
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <gtest/gtest.h>
+#include <asset_cook.hpp>
+
+using namespace shiva::tools;
+
+namespace
+{
+    void write_file(const shiva::fs::path &path, const std::string &content)
+    {
+        shiva::fs::create_directories(path.parent_path());
+        std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+        ofs << content;
+    }
+
+    std::string read_entry(const shiva::fs::path &archive_path, std::string_view path)
+    {
+        shiva::filesystem::pak_archive archive(archive_path);
+        const auto *entry = archive.find(path);
+        std::vector<char> content;
+        if (entry == nullptr || !archive.extract(*entry, content)) {
+            return "<missing>";
+        }
+        return std::string(content.begin(), content.end());
+    }
+}
+
+TEST(asset_cook, cook_and_cache)
+{
+    const auto directory = shiva::fs::temp_directory_path() / "shiva-test-cook";
+    shiva::fs::remove_all(directory);
+    cook_options options;
+    options.assets_root = directory / "assets";
+    options.output = directory / "assets.shivapak";
+    options.cache_directory = directory / "cook_cache";
+    options.nb_jobs = 2u;
+    write_file(options.assets_root / "sounds" / "game_scene" / "wind.wav", "wind");
+    write_file(options.assets_root / "fonts" / "game_scene" / "kenney_future.ttf", "kenney");
+    write_file(options.assets_root / "videos" / "game_scene" / "intro.ogv", "intro");
+    write_file(options.assets_root / "textures" / "game_scene" / "kirito.png", "kirito");
+
+#if defined(SHIVA_USE_LZ4)
+    //! the images are decoded into raw pixels, this one is not an image
+    ASSERT_EQ(asset_cook(options).run(), 1u);
+    shiva::fs::remove(options.assets_root / "textures" / "game_scene" / "kirito.png");
+#endif
+    ASSERT_EQ(asset_cook(options).run(), 0u);
+    ASSERT_EQ(read_entry(options.output, "sounds/game_scene/wind.wav"), "wind");
+    ASSERT_EQ(read_entry(options.output, "fonts/game_scene/kenney_future.ttf"), "kenney");
+    ASSERT_EQ(read_entry(options.output, "videos/game_scene/intro.ogv"), "<missing>");
+#if !defined(SHIVA_USE_LZ4)
+    //! stored as is, the raw pixels would be bigger than the image
+    ASSERT_EQ(read_entry(options.output, "textures/game_scene/kirito.png"), "kirito");
+#endif
+
+    auto nb_objects = [&options]() {
+        const shiva::fs::directory_iterator objects(options.cache_directory / "objects");
+        return std::distance(begin(objects), end(objects));
+    };
+    const auto nb_cooked = nb_objects();
+
+    //! only the modified input is cooked again
+    write_file(options.assets_root / "sounds" / "game_scene" / "wind.wav", "storm");
+    ASSERT_EQ(asset_cook(options).run(), 0u);
+    ASSERT_EQ(nb_objects(), nb_cooked + 1);
+    ASSERT_EQ(read_entry(options.output, "sounds/game_scene/wind.wav"), "storm");
+    ASSERT_EQ(read_entry(options.output, "fonts/game_scene/kenney_future.ttf"), "kenney");
+
+    //! the archive is up to date, nothing is cooked (the cached entries aren't even read)
+    shiva::fs::remove_all(options.cache_directory / "objects");
+    ASSERT_EQ(asset_cook(options).run(), 0u);
+    ASSERT_EQ(nb_objects(), 0);
+    shiva::fs::remove_all(directory);
+}
@@ -0,0 +1,82 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <font_atlas_cache.hpp>
+
+using namespace shiva::editor;
+
+TEST(font_atlas_cache, round_trip)
+{
+    const shiva::fs::path fonts_dir(SHIVA_EDITOR_FONTS_DIR);
+    const std::vector<font_source> fonts{
+        font_source{fonts_dir / "comic-sans-ms.ttf", 40.f},
+        font_source{fonts_dir / "fa-regular-400.ttf", 28.f, {0xf000, 0xf2e0, 0}, true, true}};
+    const auto cache_path = shiva::fs::temp_directory_path() / "shiva-test-fonts" / "fonts.shivafonts";
+    shiva::fs::remove_all(cache_path.parent_path());
+    ImGui::CreateContext();
+    font_atlas_cache cache(cache_path);
+
+    ImFontAtlas built;
+    ASSERT_FALSE(cache.load_or_build(built, fonts));
+    unsigned char *built_pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    built.GetTexDataAsAlpha8(&built_pixels, &width, &height);
+    ASSERT_NE(built_pixels, nullptr);
+
+    ImFontAtlas loaded;
+#if defined(SHIVA_EDITOR_FONT_ATLAS_CACHE)
+    ASSERT_TRUE(cache.load_or_build(loaded, fonts));
+    ASSERT_EQ(loaded.TexWidth, width);
+    ASSERT_EQ(loaded.TexHeight, height);
+    ASSERT_EQ(std::memcmp(loaded.TexPixelsAlpha8, built_pixels, static_cast<size_t>(width * height)), 0);
+    ASSERT_EQ(loaded.TexUvWhitePixel.x, built.TexUvWhitePixel.x);
+    ASSERT_EQ(loaded.TexUvWhitePixel.y, built.TexUvWhitePixel.y);
+
+    //! the mouse cursor is drawn from its custom rect
+    ASSERT_GE(built.CustomRectIds[0], 0);
+    ASSERT_GE(loaded.CustomRectIds[0], 0);
+    const auto &built_cursor = built.CustomRects[built.CustomRectIds[0]];
+    const auto &loaded_cursor = loaded.CustomRects[loaded.CustomRectIds[0]];
+    ASSERT_EQ(loaded_cursor.ID, built_cursor.ID);
+    ASSERT_EQ(loaded_cursor.X, built_cursor.X);
+    ASSERT_EQ(loaded_cursor.Y, built_cursor.Y);
+    ASSERT_EQ(loaded_cursor.Width, built_cursor.Width);
+    ASSERT_EQ(loaded_cursor.Height, built_cursor.Height);
+
+    //! the icons are merged in the first font
+    ASSERT_EQ(loaded.Fonts.Size, 1);
+    ASSERT_EQ(loaded.ConfigData.Size, 2);
+    const ImFont *built_font = built.Fonts[0];
+    const ImFont *loaded_font = loaded.Fonts[0];
+    ASSERT_EQ(loaded_font->ConfigDataCount, built_font->ConfigDataCount);
+    ASSERT_EQ(loaded_font->ConfigData, &loaded.ConfigData[0]);
+    for (int idx = 0; idx < loaded_font->ConfigDataCount; ++idx) {
+        ASSERT_STREQ(loaded_font->ConfigData[idx].Name, built_font->ConfigData[idx].Name);
+        ASSERT_EQ(loaded_font->ConfigData[idx].SizePixels, built_font->ConfigData[idx].SizePixels);
+        ASSERT_EQ(loaded_font->ConfigData[idx].MergeMode, built_font->ConfigData[idx].MergeMode);
+        ASSERT_EQ(loaded_font->ConfigData[idx].DstFont, loaded_font);
+    }
+    ASSERT_EQ(loaded_font->FontSize, built_font->FontSize);
+    ASSERT_EQ(loaded_font->Glyphs.Size, built_font->Glyphs.Size);
+    for (int idx = 0; idx < loaded_font->Glyphs.Size; ++idx) {
+        ASSERT_EQ(loaded_font->Glyphs[idx].Codepoint, built_font->Glyphs[idx].Codepoint);
+        ASSERT_EQ(loaded_font->Glyphs[idx].U0, built_font->Glyphs[idx].U0);
+        ASSERT_EQ(loaded_font->Glyphs[idx].V1, built_font->Glyphs[idx].V1);
+    }
+
+    //! another size of the fonts is another key
+    auto resized = fonts;
+    resized[0].size = 30.f;
+    ImFontAtlas rebuilt;
+    ASSERT_FALSE(cache.load_or_build(rebuilt, resized));
+#else
+    //! the atlas of the other versions of imgui is always rasterized
+    ASSERT_FALSE(shiva::fs::exists(cache_path));
+    ASSERT_FALSE(cache.load_or_build(loaded, fonts));
+#endif
+    ImGui::DestroyContext();
+}
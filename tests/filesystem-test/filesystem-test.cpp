@@ -0,0 +1,484 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#include <limits>
+#include <gtest/gtest.h>
+#include <shiva/filesystem/pak_archive.hpp>
+#include <shiva/filesystem/asset_manifest.hpp>
+#include <shiva/filesystem/vfs.hpp>
+
+using namespace shiva::filesystem;
+
+TEST(pak_archive, write_and_read)
+{
+    const auto archive_path = shiva::fs::temp_directory_path() / "shiva-test.shivapak";
+    pak_writer writer;
+    writer.add_data("textures/game_scene/kirito.png", "kirito");
+    writer.add_data("fonts/game_scene/kenney_future.ttf", "kenney", true);
+    writer.add_data("cfg/anim_cfg/game_scene/mage.json", "{}");
+    ASSERT_TRUE(writer.write(archive_path));
+
+    pak_archive archive(archive_path);
+    ASSERT_TRUE(archive.is_open());
+    ASSERT_EQ(archive.size(), 3u);
+
+    const auto *entry = archive.find("textures/game_scene/kirito.png");
+    ASSERT_NE(entry, nullptr);
+    ASSERT_EQ(archive.get_path(*entry), "textures/game_scene/kirito.png");
+    ASSERT_EQ(archive.view(*entry), "kirito");
+    ASSERT_EQ(entry->offset % 16u, 0u);
+    ASSERT_TRUE(archive.verify(*entry));
+
+    std::vector<char> content;
+    entry = archive.find("fonts/game_scene/kenney_future.ttf");
+    ASSERT_NE(entry, nullptr);
+    ASSERT_TRUE(archive.extract(*entry, content));
+    ASSERT_EQ(std::string(content.begin(), content.end()), "kenney");
+
+    ASSERT_EQ(archive.find("textures/game_scene/unknown.png"), nullptr);
+    ASSERT_TRUE(archive.contains_prefix("cfg/anim_cfg/"));
+    ASSERT_FALSE(archive.contains_prefix("videos/"));
+
+    size_t nb_textures = 0u;
+    archive.for_each_entry("textures/", [&nb_textures](std::string_view, const shiva::filesystem::pak::entry &) {
+        ++nb_textures;
+    });
+    ASSERT_EQ(nb_textures, 1u);
+
+    archive.close();
+    shiva::fs::remove(archive_path);
+}
+
+TEST(pak_archive, compressed_entry)
+{
+    const auto archive_path = shiva::fs::temp_directory_path() / "shiva-test-compressed.shivapak";
+    const std::string content(4096, 'a');
+    pak_writer writer;
+    writer.add_data("sounds/game_scene/wind.wav", content, true);
+    ASSERT_TRUE(writer.write(archive_path));
+
+    pak_archive archive(archive_path);
+    const auto *entry = archive.find("sounds/game_scene/wind.wav");
+    ASSERT_NE(entry, nullptr);
+#if defined(SHIVA_USE_LZ4)
+    ASSERT_TRUE(archive.is_compressed(*entry));
+    ASSERT_LT(entry->stored_size, content.size());
+#endif
+    std::vector<char> extracted;
+    ASSERT_TRUE(archive.extract(*entry, extracted));
+    ASSERT_EQ(std::string(extracted.begin(), extracted.end()), content);
+    ASSERT_TRUE(archive.verify(*entry));
+    archive.close();
+    shiva::fs::remove(archive_path);
+}
+
+TEST(pak_archive, duplicated_path)
+{
+    pak_writer writer;
+    writer.add_data("textures/a.png", "a");
+    writer.add_data("textures/a.png", "b");
+    ASSERT_FALSE(writer.write(shiva::fs::temp_directory_path() / "shiva-test-duplicated.shivapak"));
+}
+
+TEST(pak_archive, invalid_archive)
+{
+    const auto archive_path = shiva::fs::temp_directory_path() / "shiva-test-invalid.shivapak";
+    {
+        std::ofstream ofs(archive_path, std::ios::binary);
+        ofs << std::string(128, 'x');
+    }
+    pak_archive archive(archive_path);
+    ASSERT_FALSE(archive.is_open());
+    shiva::fs::remove(archive_path);
+}
+
+namespace
+{
+    //! write a valid archive of two entries, then rewrite it after corrupt(header, content)
+    template <typename Corrupt>
+    bool write_corrupted(const shiva::fs::path &archive_path, Corrupt &&corrupt)
+    {
+        pak_writer writer;
+        writer.add_data("textures/a.png", "a");
+        writer.add_data("textures/b.png", "b");
+        if (!writer.write(archive_path)) {
+            return false;
+        }
+        std::string content;
+        {
+            std::ifstream ifs(archive_path, std::ios::binary);
+            content.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>{});
+        }
+        pak::header header{};
+        std::memcpy(&header, content.data(), sizeof(header));
+        corrupt(header, content);
+        std::memcpy(content.data(), &header, sizeof(header));
+        std::ofstream ofs(archive_path, std::ios::binary | std::ios::trunc);
+        ofs.write(content.data(), static_cast<std::streamsize>(content.size()));
+        return true;
+    }
+
+    //! apply corrupt on the first entry of the table
+    template <typename Corrupt>
+    auto corrupt_entry(Corrupt &&corrupt)
+    {
+        return [corrupt](pak::header &header, std::string &content) {
+            pak::entry entry{};
+            std::memcpy(&entry, content.data() + header.entries_offset, sizeof(entry));
+            corrupt(entry);
+            std::memcpy(content.data() + header.entries_offset, &entry, sizeof(entry));
+        };
+    }
+}
+
+TEST(pak_archive, corrupted_slots)
+{
+    const auto archive_path = shiva::fs::temp_directory_path() / "shiva-test-corrupted.shivapak";
+    //! every slot is used: a missing path would be searched forever
+    ASSERT_TRUE(write_corrupted(archive_path, [](pak::header &header, std::string &) {
+        header.nb_slots = 2u;
+    }));
+    ASSERT_FALSE(pak_archive(archive_path).is_open());
+
+    //! a slot gives an entry past the table of the entries
+    ASSERT_TRUE(write_corrupted(archive_path, [](pak::header &header, std::string &content) {
+        for (std::uint32_t slot = 0u; slot < header.nb_slots; ++slot) {
+            std::uint32_t idx = 0u;
+            std::memcpy(&idx, content.data() + header.slots_offset + slot * sizeof(idx), sizeof(idx));
+            if (idx != 0u) {
+                idx = header.nb_entries + 1u;
+                std::memcpy(content.data() + header.slots_offset + slot * sizeof(idx), &idx, sizeof(idx));
+                break;
+            }
+        }
+    }));
+    ASSERT_FALSE(pak_archive(archive_path).is_open());
+
+    //! every slot gives the same entry
+    ASSERT_TRUE(write_corrupted(archive_path, [](pak::header &header, std::string &content) {
+        const std::uint32_t idx = 1u;
+        for (std::uint32_t slot = 0u; slot < header.nb_slots; ++slot) {
+            std::memcpy(content.data() + header.slots_offset + slot * sizeof(idx), &idx, sizeof(idx));
+        }
+    }));
+    ASSERT_FALSE(pak_archive(archive_path).is_open());
+
+    //! untouched
+    ASSERT_TRUE(write_corrupted(archive_path, [](pak::header &, std::string &) {
+    }));
+    pak_archive archive(archive_path);
+    ASSERT_TRUE(archive.is_open());
+    ASSERT_EQ(archive.find("textures/c.png"), nullptr);
+    archive.close();
+    shiva::fs::remove(archive_path);
+}
+
+TEST(pak_archive, tampered_header)
+{
+    const auto archive_path = shiva::fs::temp_directory_path() / "shiva-test-tampered.shivapak";
+    auto is_rejected = [&archive_path](auto &&corrupt) {
+        return write_corrupted(archive_path, corrupt) && !pak_archive(archive_path).is_open();
+    };
+
+    //! the sums of the offsets and the sizes wrap around
+    ASSERT_TRUE(is_rejected([](pak::header &header, std::string &) {
+        header.entries_offset = std::numeric_limits<std::uint64_t>::max() - 7u;
+    }));
+    ASSERT_TRUE(is_rejected([](pak::header &header, std::string &) {
+        header.slots_offset = std::numeric_limits<std::uint64_t>::max() - 3u;
+    }));
+    ASSERT_TRUE(is_rejected([](pak::header &header, std::string &) {
+        header.paths_offset = 1u;
+        header.paths_size = std::numeric_limits<std::uint64_t>::max();
+    }));
+    ASSERT_TRUE(is_rejected(corrupt_entry([](pak::entry &entry) {
+        entry.offset = std::numeric_limits<std::uint64_t>::max();
+    })));
+    ASSERT_TRUE(is_rejected(corrupt_entry([](pak::entry &entry) {
+        entry.stored_size = std::numeric_limits<std::uint64_t>::max();
+    })));
+
+    //! the tables are not aligned
+    ASSERT_TRUE(is_rejected([](pak::header &header, std::string &) {
+        header.entries_offset += 1u;
+    }));
+    ASSERT_TRUE(is_rejected([](pak::header &header, std::string &) {
+        header.slots_offset += 2u;
+    }));
+
+    //! an uncompressed entry bigger than his stored bytes would overflow on extract
+    ASSERT_TRUE(is_rejected(corrupt_entry([](pak::entry &entry) {
+        entry.size = entry.stored_size + 4096u;
+    })));
+
+    shiva::fs::remove(archive_path);
+}
+
+namespace
+{
+    void write_file(const shiva::fs::path &path, const std::string &content)
+    {
+        shiva::fs::create_directories(path.parent_path());
+        std::ofstream ofs(path, std::ios::binary);
+        ofs << content;
+    }
+}
+
+TEST(asset_manifest, build_save_and_load)
+{
+    const auto root = shiva::fs::temp_directory_path() / "shiva-test-manifest";
+    const auto manifest_path = shiva::fs::temp_directory_path() / "shiva-test.shivamanifest";
+    shiva::fs::remove_all(root);
+    shiva::fs::remove(manifest_path);
+    write_file(root / "textures/game_scene/kirito.png", "kirito");
+    write_file(root / "textures/game_scene/mage.png", "mage");
+    write_file(root / "fonts/kenney_future.ttf", "kenney");
+
+    asset_manifest manifest(root);
+    ASSERT_TRUE(manifest.open(manifest_path));
+    ASSERT_EQ(manifest.size(), 3u);
+    ASSERT_FALSE(manifest.is_dirty());
+    ASSERT_TRUE(manifest.contains_directory("textures/game_scene"));
+    ASSERT_EQ(manifest.count("textures"), 2u);
+    ASSERT_EQ(manifest.count(""), 3u);
+
+    const auto *entry = manifest.find("textures/game_scene/kirito.png");
+    ASSERT_NE(entry, nullptr);
+    ASSERT_EQ(entry->size, 6u);
+    ASSERT_EQ(entry->content_hash, pak::fnv1a_64("kirito"));
+    ASSERT_EQ(entry->id, pak::hash_path("textures/game_scene/kirito.png"));
+    ASSERT_EQ(asset_manifest::category("textures/game_scene/kirito.png"), "textures");
+    ASSERT_EQ(asset_manifest::default_path("systems/lua/"), asset_manifest::default_path("systems/lua"));
+    ASSERT_NE(asset_manifest::default_path("systems/lua"), asset_manifest::default_path("systems/python"));
+    ASSERT_EQ(asset_manifest::default_path("systems/lua").parent_path(),
+              shiva::fs::current_path() / "cache" / "manifests");
+
+    asset_manifest loaded(root);
+    ASSERT_TRUE(loaded.load(manifest_path));
+    ASSERT_EQ(loaded.size(), 3u);
+    ASSERT_EQ(loaded.refresh(), 0u);
+    ASSERT_EQ(loaded.find("fonts/kenney_future.ttf")->content_hash, pak::fnv1a_64("kenney"));
+
+    std::vector<std::string> paths;
+    loaded.for_each_file("textures/game_scene", [&paths](const std::string &path, auto &&) {
+        paths.push_back(path);
+    });
+    ASSERT_EQ(paths, (std::vector<std::string>{"textures/game_scene/kirito.png", "textures/game_scene/mage.png"}));
+
+    shiva::fs::remove_all(root);
+    shiva::fs::remove(manifest_path);
+}
+
+TEST(asset_manifest, refresh_changed_directories)
+{
+    const auto root = shiva::fs::temp_directory_path() / "shiva-test-manifest-refresh";
+    shiva::fs::remove_all(root);
+    write_file(root / "textures/game_scene/kirito.png", "kirito");
+    write_file(root / "sounds/wind.wav", "wind");
+
+    asset_manifest manifest(root);
+    manifest.rebuild();
+    ASSERT_EQ(manifest.size(), 2u);
+
+    write_file(root / "textures/game_scene/mage.png", "mage");
+    write_file(root / "textures/intro/logo.png", "logo");
+    shiva::fs::remove_all(root / "sounds");
+    const auto now = shiva::fs::file_time_type::clock::now();
+    shiva::fs::last_write_time(root / "textures/game_scene", now + std::chrono::seconds(1));
+    shiva::fs::last_write_time(root / "textures", now + std::chrono::seconds(1));
+
+    ASSERT_GT(manifest.refresh(), 0u);
+    ASSERT_TRUE(manifest.is_dirty());
+    ASSERT_NE(manifest.find("textures/game_scene/mage.png"), nullptr);
+    ASSERT_NE(manifest.find("textures/intro/logo.png"), nullptr);
+    ASSERT_EQ(manifest.find("sounds/wind.wav"), nullptr);
+    ASSERT_FALSE(manifest.contains_directory("sounds"));
+    ASSERT_EQ(manifest.size(), 3u);
+    shiva::fs::remove_all(root);
+}
+
+TEST(asset_manifest, refresh_modified_files)
+{
+    const auto root = shiva::fs::temp_directory_path() / "shiva-test-manifest-files";
+    shiva::fs::remove_all(root);
+    write_file(root / "sounds/wind.wav", "wind");
+
+    asset_manifest manifest(root);
+    manifest.rebuild();
+    write_file(root / "sounds/wind.wav", "storm!");
+    ASSERT_EQ(manifest.refresh_files(), 1u);
+    ASSERT_EQ(manifest.find("sounds/wind.wav")->content_hash, pak::fnv1a_64("storm!"));
+    ASSERT_EQ(manifest.refresh_files(), 0u);
+    shiva::fs::remove_all(root);
+}
+
+TEST(vfs, overlays_and_listing)
+{
+    const auto root = shiva::fs::temp_directory_path() / "shiva-test-vfs";
+    const auto archive_path = shiva::fs::temp_directory_path() / "shiva-test-vfs.shivapak";
+    shiva::fs::remove_all(root);
+    write_file(root / "textures/kirito.png", "disk kirito");
+    write_file(root / "sounds/wind.wav", "wind");
+    pak_writer writer;
+    writer.add_data("textures/kirito.png", "archive kirito");
+    writer.add_data("textures/mage.png", "mage");
+    ASSERT_TRUE(writer.write(archive_path));
+
+    vfs file_system;
+    file_system.mount("assets", std::make_shared<directory_mount>(root));
+    ASSERT_EQ(file_system.read("assets/textures/kirito.png")->view(), "disk kirito");
+    ASSERT_TRUE(file_system.disk_path("assets/textures/kirito.png"));
+    ASSERT_EQ(file_system.stat("assets/sounds/wind.wav")->size, 4u);
+
+    file_system.mount("assets", std::make_shared<archive_mount>(archive_path), vfs::archive_priority);
+    ASSERT_EQ(file_system.read("assets/textures/kirito.png")->view(), "archive kirito");
+    ASSERT_EQ(file_system.view("assets/textures/mage.png").value(), "mage");
+    ASSERT_FALSE(file_system.disk_path("assets/textures/kirito.png"));
+
+    auto overlay = std::make_shared<memory_mount>();
+    overlay->add_file("textures/kirito.png", "overlay kirito");
+    const auto overlay_id = file_system.mount("assets", overlay, vfs::overlay_priority);
+    ASSERT_EQ(file_system.read("assets/textures/kirito.png")->view(), "overlay kirito");
+    ASSERT_TRUE(file_system.unmount(overlay_id));
+    ASSERT_EQ(file_system.read("assets/textures/kirito.png")->view(), "archive kirito");
+
+    std::vector<std::string> paths;
+    ASSERT_EQ(file_system.for_each_file("assets/textures", [&paths](const std::string &path) {
+        paths.push_back(path);
+    }), 2u);
+    ASSERT_EQ(paths, (std::vector<std::string>{"assets/textures/kirito.png", "assets/textures/mage.png"}));
+    ASSERT_EQ(file_system.count_files(""), 3u);
+
+    std::vector<std::pair<std::string, bool>> children;
+    file_system.list("", [&children](const std::string &name, bool is_directory) {
+        children.emplace_back(name, is_directory);
+    });
+    ASSERT_EQ(children, (std::vector<std::pair<std::string, bool>>{{"assets", true}}));
+    children.clear();
+    file_system.list("assets", [&children](const std::string &name, bool is_directory) {
+        children.emplace_back(name, is_directory);
+    });
+    ASSERT_EQ(children, (std::vector<std::pair<std::string, bool>>{{"sounds", true}, {"textures", true}}));
+    ASSERT_TRUE(file_system.is_directory("assets/textures"));
+    ASSERT_FALSE(file_system.exists("assets/textures/missing.png"));
+
+    shiva::fs::remove_all(root);
+    shiva::fs::remove(archive_path);
+}
+
+TEST(vfs, disk_paths_and_cache)
+{
+    const auto root = shiva::fs::temp_directory_path() / "shiva-test-vfs-disk";
+    shiva::fs::remove_all(root);
+    write_file(root / "scripts/lua/player.lua", "print(1)");
+
+    vfs file_system;
+    const auto directory = file_system.mount_path(root / "scripts");
+    ASSERT_EQ(file_system.nb_mounts(), 1u);
+    ASSERT_EQ(file_system.mount_path(root / "scripts/lua"), directory + "/lua");
+    ASSERT_EQ(file_system.nb_mounts(), 1u);
+    ASSERT_EQ(file_system.virtual_path(root / "scripts/lua/player.lua"), directory + "/lua/player.lua");
+    ASSERT_FALSE(file_system.to_virtual(root / "textures"));
+
+    const auto path = directory + "/lua/enemy.lua";
+    ASSERT_FALSE(file_system.exists(path));
+    //! a missing path is not cached, a found one is until it is invalidated
+    write_file(root / "scripts/lua/enemy.lua", "print(2)");
+    ASSERT_TRUE(file_system.exists(path));
+    shiva::fs::remove(root / "scripts/lua/enemy.lua");
+    ASSERT_TRUE(file_system.exists(path));
+    file_system.invalidate(path);
+    ASSERT_FALSE(file_system.exists(path));
+    shiva::fs::remove_all(root);
+}
+
+TEST(vfs, async_reads_and_buffer_pool)
+{
+    auto overlay = std::make_shared<memory_mount>();
+    std::vector<std::string> paths;
+    for (int idx = 0; idx < 16; ++idx) {
+        paths.push_back("data/file_" + std::to_string(idx));
+        overlay->add_file(paths.back(), std::string(1024u, static_cast<char>('a' + idx)));
+    }
+    vfs file_system(4u);
+    file_system.mount("", overlay);
+
+    auto futures = file_system.read_batch(paths);
+    for (size_t idx = 0u; idx < futures.size(); ++idx) {
+        auto buffer = futures[idx].get();
+        ASSERT_TRUE(buffer);
+        ASSERT_EQ(buffer->size(), 1024u);
+        ASSERT_EQ(buffer->data()[0], static_cast<char>('a' + idx));
+    }
+    ASSERT_GT(file_system.get_buffer_pool()->size(), 0u);
+    ASSERT_FALSE(file_system.read_async("data/missing").get());
+
+    const auto nb_free = file_system.get_buffer_pool()->size();
+    {
+        auto buffer = file_system.read("data/file_0");
+        ASSERT_EQ(file_system.get_buffer_pool()->size(), nb_free - 1u);
+    }
+    ASSERT_EQ(file_system.get_buffer_pool()->size(), nb_free);
+}
+
+TEST(vfs, batched_reads_of_loose_files)
+{
+    const auto root = shiva::fs::temp_directory_path() / "shiva-test-vfs-batch";
+    shiva::fs::remove_all(root);
+    std::vector<std::string> paths;
+    for (int idx = 0; idx < 100; ++idx) {
+        const auto name = "textures/file_" + std::to_string(idx);
+        write_file(root / name, std::string(static_cast<size_t>(idx) * 100u, static_cast<char>('a' + idx % 26)));
+        paths.push_back(name);
+    }
+    paths.push_back("textures/missing");
+
+    vfs file_system;
+    const auto directory = file_system.mount_path(root);
+    auto overlay = std::make_shared<memory_mount>();
+    overlay->add_file("textures/file_1", "overlay");
+    file_system.mount(directory, overlay, vfs::overlay_priority);
+    for (auto &&path : paths) {
+        path = directory + "/" + path;
+    }
+
+    auto futures = file_system.read_batch(paths);
+    ASSERT_EQ(futures.size(), paths.size());
+    for (size_t idx = 0u; idx < 100u; ++idx) {
+        auto buffer = futures[idx].get();
+        ASSERT_TRUE(buffer);
+        if (idx == 1u) {
+            ASSERT_EQ(buffer->view(), "overlay");
+            continue;
+        }
+        ASSERT_EQ(buffer->size(), idx * 100u);
+        ASSERT_TRUE(std::all_of(buffer->data(), buffer->data() + buffer->size(), [idx](char c) {
+            return c == static_cast<char>('a' + idx % 26);
+        }));
+    }
+    ASSERT_FALSE(futures.back().get());
+    shiva::fs::remove_all(root);
+}
+
+TEST(uring_reader, read_and_failures)
+{
+    const auto root = shiva::fs::temp_directory_path() / "shiva-test-uring";
+    shiva::fs::remove_all(root);
+    write_file(root / "a.bin", std::string(70000u, 'x'));
+    write_file(root / "empty.bin", "");
+
+    std::vector<char> a, empty, missing;
+    std::vector<uring_reader::request> requests{{root / "a.bin", &a}, {root / "empty.bin", &empty},
+                                                {root / "missing.bin", &missing}};
+    std::vector<int> results(requests.size(), -1);
+    uring_reader reader(2u);
+    reader.read(requests, [&results](size_t idx, bool success) {
+        results[idx] = success ? 1 : 0;
+    });
+    ASSERT_EQ(results, (std::vector<int>{1, 1, 0}));
+    ASSERT_EQ(a.size(), 70000u);
+    ASSERT_EQ(a.back(), 'x');
+    ASSERT_TRUE(empty.empty());
+    shiva::fs::remove_all(root);
+}
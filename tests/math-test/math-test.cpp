@@ -0,0 +1,100 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include <shiva/math/math.hpp>
+
+using namespace shiva::math;
+
+TEST(math, vec2)
+{
+    vec2 a{1.0f, 2.0f};
+    vec2 b{3.0f, 4.0f};
+    ASSERT_EQ(a + b, (vec2{4.0f, 6.0f}));
+    ASSERT_EQ(b - a, (vec2{2.0f, 2.0f}));
+    ASSERT_FLOAT_EQ(b.length(), 5.0f);
+    ASSERT_FLOAT_EQ(vec2{}.distance(b), 5.0f);
+    ASSERT_EQ(vec2{}.normalized(), vec2{});
+}
+
+TEST(math, rect)
+{
+    rect r{0.0f, 0.0f, 10.0f, 10.0f};
+    ASSERT_TRUE(r.contains(vec2{5.0f, 5.0f}));
+    ASSERT_FALSE(r.contains(vec2{10.0f, 5.0f}));
+    ASSERT_TRUE(r.intersects(rect{5.0f, 5.0f, 10.0f, 10.0f}));
+    ASSERT_EQ(r.intersection(rect{5.0f, 5.0f, 10.0f, 10.0f}), (rect{5.0f, 5.0f, 5.0f, 5.0f}));
+    ASSERT_EQ(r.intersection(rect{20.0f, 20.0f, 1.0f, 1.0f}), rect{});
+}
+
+TEST(math, transform)
+{
+    transform t{vec2{10.0f, 0.0f}, vec2{2.0f, 2.0f}, 90.0f};
+    auto point = t.apply(vec2{1.0f, 0.0f});
+    ASSERT_NEAR(point.x, 10.0f, 1e-5f);
+    ASSERT_NEAR(point.y, 2.0f, 1e-5f);
+}
+
+TEST(math, vec2_array)
+{
+    //! 11 elements: two SIMD lanes and a scalar tail.
+    vec2_array positions;
+    vec2_array velocities(11u);
+    for (size_t i = 0; i < 11u; ++i) {
+        positions.push_back(vec2{static_cast<float>(i), static_cast<float>(i * 2)});
+    }
+    velocities.translate(vec2{1.0f, 1.0f});
+    positions.add(velocities);
+    positions.scale(2.0f);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        ASSERT_EQ(positions.get(i), (vec2{2.0f * (i + 1), 2.0f * (2 * i + 1)}));
+    }
+    auto distances = positions.distances(vec2{});
+    ASSERT_EQ(distances.size(), positions.size());
+    for (size_t i = 0; i < distances.size(); ++i) {
+        ASSERT_FLOAT_EQ(distances[i], positions.get(i).length());
+    }
+    positions.sub(positions);
+    for (auto &&distance : positions.distances(vec2_array(11u))) {
+        ASSERT_FLOAT_EQ(distance, 0.0f);
+    }
+}
+
+TEST(math, rect_packer)
+{
+    rect_packer packer(64u, 64u);
+    std::vector<packed_rect> rects;
+    for (int idx = 0; idx < 16; ++idx) {
+        auto res = packer.insert(16u, 16u);
+        ASSERT_TRUE(res.has_value());
+        rects.push_back(*res);
+    }
+    ASSERT_FLOAT_EQ(packer.occupancy(), 1.0f);
+    ASSERT_FALSE(packer.insert(1u, 1u).has_value());
+    for (size_t lhs = 0u; lhs < rects.size(); ++lhs) {
+        ASSERT_LE(rects[lhs].x + rects[lhs].width, 64u);
+        ASSERT_LE(rects[lhs].y + rects[lhs].height, 64u);
+        for (size_t rhs = lhs + 1u; rhs < rects.size(); ++rhs) {
+            const bool overlap = rects[lhs].x < rects[rhs].x + rects[rhs].width &&
+                                 rects[rhs].x < rects[lhs].x + rects[lhs].width &&
+                                 rects[lhs].y < rects[rhs].y + rects[rhs].height &&
+                                 rects[rhs].y < rects[lhs].y + rects[lhs].height;
+            ASSERT_FALSE(overlap);
+        }
+    }
+}
+
+TEST(math, rect_packer_mixed_sizes)
+{
+    rect_packer packer(128u, 128u);
+    ASSERT_FALSE(packer.insert(129u, 1u).has_value());
+    auto big = packer.insert(100u, 60u);
+    auto small = packer.insert(28u, 30u);
+    auto wide = packer.insert(128u, 40u);
+    ASSERT_TRUE(big && small && wide);
+    ASSERT_EQ(small->x, 100u);
+    ASSERT_EQ(small->y, 0u);
+    ASSERT_EQ(wide->y, 60u);
+    ASSERT_FALSE(packer.insert(128u, 40u).has_value());
+}
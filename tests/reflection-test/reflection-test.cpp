@@ -6,6 +6,8 @@
 #include <gtest/gtest.h>
 #include <shiva/meta/visitor.hpp>
 #include <shiva/reflection/reflection.hpp>
+#include <shiva/reflection/binary_serialization.hpp>
+#include <shiva/enums/enums.hpp>
 
 namespace
 {
@@ -53,6 +55,38 @@ namespace
             return shiva::meta::makeMap(reflect_function(&i_have_refl_member_functions::func));
         }
     };
+
+    struct i_am_a_config
+    {
+        ENUM(mode, windowed, fullscreen)
+
+        mode current_mode{mode::windowed};
+        std::string name;
+        std::array<unsigned int, 2> size{{0u, 0u}};
+        float speed{0.0f};
+        bool vsync{false};
+
+        static constexpr auto reflected_members() noexcept
+        {
+            return shiva::meta::makeMap(
+                reflect_member(&i_am_a_config::current_mode),
+                reflect_member(&i_am_a_config::name),
+                reflect_member(&i_am_a_config::size),
+                reflect_member(&i_am_a_config::speed),
+                reflect_member(&i_am_a_config::vsync)
+            );
+        }
+    };
+
+    struct i_am_another_config
+    {
+        std::string name;
+
+        static constexpr auto reflected_members() noexcept
+        {
+            return shiva::meta::makeMap(reflect_member(&i_am_another_config::name));
+        }
+    };
 }
 
 TEST(reflection, traits)
@@ -144,3 +178,32 @@ TEST(reflection, class_name)
 {
     ASSERT_EQ(i_have_a_reflectible_name::class_name(), "i_have_a_reflectible_name");
 }
+
+TEST(reflection, binary_serialization)
+{
+    i_am_a_config cfg;
+    cfg.current_mode = i_am_a_config::mode::fullscreen;
+    cfg.name = "shiva";
+    cfg.size = {{1920u, 1080u}};
+    cfg.speed = 0.5f;
+    cfg.vsync = true;
+
+    const auto blob = shiva::refl::to_binary(cfg);
+    ASSERT_EQ(blob.size(), sizeof(int) + sizeof(std::uint32_t) + 5u + 2u * sizeof(unsigned int) + sizeof(float) + 1u);
+
+    i_am_a_config loaded;
+    std::string_view in = blob;
+    ASSERT_TRUE(shiva::refl::from_binary(in, loaded));
+    ASSERT_TRUE(in.empty());
+    ASSERT_EQ(loaded.current_mode, i_am_a_config::mode::fullscreen);
+    ASSERT_EQ(loaded.name, "shiva");
+    ASSERT_EQ(loaded.size[1], 1080u);
+    ASSERT_EQ(loaded.speed, 0.5f);
+    ASSERT_TRUE(loaded.vsync);
+
+    std::string_view truncated(blob.data(), blob.size() - 1u);
+    ASSERT_FALSE(shiva::refl::from_binary(truncated, loaded));
+
+    ASSERT_EQ(shiva::refl::schema_hash<i_am_a_config>(), shiva::refl::schema_hash<i_am_a_config>());
+    ASSERT_NE(shiva::refl::schema_hash<i_am_a_config>(), shiva::refl::schema_hash<i_am_another_config>());
+}
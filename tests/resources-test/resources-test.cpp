@@ -0,0 +1,560 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <shiva/sfml/common/resource_id.hpp>
+#include <shiva/sfml/resources/access_trace.hpp>
+#include <shiva/sfml/resources/image_header.hpp>
+#include <shiva/sfml/resources/resource_graph.hpp>
+#include <shiva/sfml/resources/resource_residency.hpp>
+#include <shiva/sfml/resources/resource_cache.hpp>
+#include <shiva/sfml/resources/sound_bank.hpp>
+#include <shiva/sfml/resources/texture_atlas.hpp>
+
+using namespace shiva::sfml;
+
+TEST(access_trace, record_save_and_load)
+{
+    const auto directory = shiva::fs::temp_directory_path() / "shiva-test-traces";
+    shiva::fs::remove_all(directory);
+    access_trace trace;
+    trace.set_directory(directory);
+    ASSERT_FALSE(trace.is_recording());
+    trace.record(resource_key{resource_residency::texture, resource_id("game_scene/ignored")});
+
+    trace.start("game_scene");
+    ASSERT_TRUE(trace.is_recording());
+    ASSERT_FALSE(trace.is_expired());
+    const resource_key kirito{resource_residency::texture, resource_id("game_scene/kirito")};
+    const resource_key wind{resource_residency::sound, resource_id("game_scene/wind")};
+    const resource_key unknown{resource_residency::font, resource_id("game_scene/unknown")};
+    trace.record(wind);
+    trace.record(kirito);
+    trace.record(wind);
+    trace.record(unknown);
+    ASSERT_TRUE(trace.stop([&](const resource_key &key) -> std::optional<std::string> {
+        if (key == unknown) {
+            return std::nullopt;
+        }
+        return key == wind ? "sounds/game_scene/wind.wav" : "textures/game_scene/kirito.png";
+    }));
+    ASSERT_FALSE(trace.is_recording());
+    ASSERT_TRUE(shiva::fs::exists(trace.path_of_scene("game_scene")));
+
+    //! in the order of their first lookup, without the duplicates and the resources without path
+    const auto entries = trace.load("game_scene");
+    ASSERT_EQ(entries.size(), 2u);
+    ASSERT_EQ(entries[0].key, wind);
+    ASSERT_EQ(entries[0].path, "sounds/game_scene/wind.wav");
+    ASSERT_EQ(entries[1].key, kirito);
+    ASSERT_EQ(entries[1].path, "textures/game_scene/kirito.png");
+    ASSERT_TRUE(trace.load("other_scene").empty());
+
+    trace.set_duration(std::chrono::milliseconds(0));
+    trace.start("other_scene");
+    ASSERT_FALSE(trace.is_recording());
+    shiva::fs::remove_all(directory);
+}
+
+TEST(resource_residency, evict_least_recently_used_over_budget)
+{
+    resource_residency residency;
+    int textures[4] = {};
+    const resource_id ids[4] = {resource_id("first"), resource_id("second"), resource_id("third"), resource_id("fourth")};
+    for (int idx = 0; idx < 4; ++idx) {
+        residency.track(resource_residency::texture, ids[idx], {100u, &textures[idx], "textures/" + std::to_string(idx)});
+        residency.next_frame();
+    }
+    ASSERT_EQ(residency.get_stats().total_bytes, 400u);
+    std::vector<resource_id> evicted;
+    auto discard = [&evicted](auto, resource_id id) {
+        evicted.push_back(id);
+    };
+    auto not_held = [](auto, resource_id) {
+        return false;
+    };
+
+    //! unlimited budget
+    ASSERT_EQ(residency.evict(discard, not_held), 0u);
+    residency.set_budget(250u);
+    ASSERT_TRUE(residency.is_over_budget());
+
+    //! the first one is used again, the second one is the least recently used
+    residency.touch(resource_residency::texture, ids[0]);
+    residency.next_frame();
+    ASSERT_EQ(residency.evict(discard, not_held), 2u);
+    ASSERT_EQ(evicted, (std::vector<resource_id>{ids[1], ids[2]}));
+    ASSERT_FALSE(residency.is_over_budget());
+    ASSERT_EQ(residency.get_stats().evictions, 2u);
+
+    //! an evicted resource gives its path once, to be loaded again
+    ASSERT_EQ(residency.miss(resource_residency::texture, ids[1]), std::optional<std::string>("textures/1"));
+    ASSERT_FALSE(residency.miss(resource_residency::texture, ids[1]));
+}
+
+TEST(resource_residency, referenced_used_and_held_are_kept)
+{
+    resource_residency residency;
+    int textures[4] = {};
+    const resource_id ids[4] = {resource_id("referenced"), resource_id("used"), resource_id("held"),
+                                resource_id("unused")};
+    for (int idx = 0; idx < 4; ++idx) {
+        residency.track(resource_residency::texture, ids[idx], {100u, &textures[idx], "textures/" + std::to_string(idx)});
+    }
+    residency.next_frame();
+    residency.set_budget(100u);
+    residency.mark_referenced(&textures[0]);
+    residency.touch(resource_residency::texture, ids[1]);
+    std::vector<resource_id> evicted;
+    ASSERT_EQ(residency.evict([&evicted](auto, resource_id id) {
+        evicted.push_back(id);
+    }, [&ids](auto, resource_id id) {
+        return id == ids[2];
+    }), 1u);
+    ASSERT_EQ(evicted, std::vector<resource_id>{ids[3]});
+    ASSERT_TRUE(residency.is_over_budget());
+
+    //! the reference lasts one frame, the least recently used are evicted first
+    residency.next_frame();
+    ASSERT_EQ(residency.evict([&evicted](auto, resource_id id) {
+        evicted.push_back(id);
+    }, [](auto, resource_id) {
+        return false;
+    }), 2u);
+    ASSERT_EQ(evicted.size(), 3u);
+    ASSERT_EQ(std::find(evicted.begin(), evicted.end(), ids[1]), evicted.end());
+    ASSERT_EQ(residency.get_stats().total_bytes, 100u);
+}
+
+TEST(resource_residency, looked_up_resource_is_evicted_once_unused)
+{
+    //! get_resource of the resources_registry touches the resource on each lookup
+    resource_residency residency;
+    int texture = 0;
+    const resource_id id("looked_up");
+    residency.track(resource_residency::texture, id, {100u, &texture, "textures/looked_up"});
+    residency.set_budget(50u);
+    auto not_held = [](auto, resource_id) {
+        return false;
+    };
+    auto discard = [](auto, resource_id) {
+    };
+
+    //! looked up during two frames
+    for (int frame = 0; frame < 2; ++frame) {
+        residency.touch(resource_residency::texture, id);
+        ASSERT_EQ(residency.evict(discard, not_held), 0u);
+        residency.next_frame();
+    }
+
+    //! not looked up anymore
+    ASSERT_EQ(residency.evict(discard, not_held), 1u);
+    ASSERT_EQ(residency.get_stats().total_bytes, 0u);
+    ASSERT_EQ(residency.miss(resource_residency::texture, id), std::optional<std::string>("textures/looked_up"));
+}
+
+namespace
+{
+    template <typename Resource>
+    struct shared_loader
+    {
+        std::shared_ptr<Resource> load(std::shared_ptr<Resource> resource) const
+        {
+            return resource;
+        }
+    };
+}
+
+TEST(resource_cache, find_assign_and_discard)
+{
+    resource_cache<int> cache;
+    const resource_id kirito("textures/kirito");
+    ASSERT_TRUE(cache.empty());
+    ASSERT_EQ(cache.find(kirito), nullptr);
+    ASSERT_EQ(cache.handle(kirito), nullptr);
+
+    ASSERT_TRUE(cache.load<shared_loader<int>>(kirito, std::make_shared<int>(1)));
+    ASSERT_TRUE(cache.contains(kirito));
+    ASSERT_EQ(*cache.find(kirito), 1);
+
+    //! load keeps the resource, assign replaces it
+    ASSERT_TRUE(cache.load<shared_loader<int>>(kirito, std::make_shared<int>(2)));
+    ASSERT_EQ(*cache.find(kirito), 1);
+    ASSERT_FALSE(cache.load<shared_loader<int>>(resource_id("textures/none"), std::shared_ptr<int>{}));
+    cache.assign(kirito, std::make_shared<int>(3));
+    ASSERT_EQ(*cache.find(kirito), 3);
+    ASSERT_EQ(cache.size(), 1u);
+
+    //! the handle outlives the discard
+    const auto handle = cache.handle(kirito);
+    cache.discard(kirito);
+    ASSERT_FALSE(cache.contains(kirito));
+    ASSERT_EQ(*handle, 3);
+    ASSERT_TRUE(cache.empty());
+
+    for (int idx = 0; idx < 200; ++idx) {
+        cache.assign(resource_id("textures/" + std::to_string(idx)), std::make_shared<int>(idx));
+    }
+    ASSERT_EQ(cache.size(), 200u);
+    ASSERT_EQ(cache.discard_if([](resource_id, int value) {
+        return value % 2 == 0;
+    }), 100u);
+    ASSERT_EQ(cache.size(), 100u);
+    ASSERT_EQ(*cache.find(resource_id("textures/101")), 101);
+    ASSERT_EQ(cache.find(resource_id("textures/100")), nullptr);
+    cache.clear();
+    ASSERT_TRUE(cache.empty());
+}
+
+TEST(resource_cache, readers_and_writer)
+{
+    resource_cache<std::vector<int>> cache;
+    constexpr int nb_ids = 64;
+    std::vector<resource_id> ids;
+    for (int idx = 0; idx < nb_ids; ++idx) {
+        ids.emplace_back("textures/" + std::to_string(idx));
+    }
+
+    //! every published resource is complete: its values are all equal to its id
+    //! (the readers take handles, the pointer given by find may be discarded meanwhile)
+    std::atomic_bool stop{false};
+    std::atomic_bool corrupted{false};
+    std::vector<std::thread> readers;
+    for (int reader = 0; reader < 4; ++reader) {
+        readers.emplace_back([&]() {
+            while (!stop.load()) {
+                for (int idx = 0; idx < nb_ids; ++idx) {
+                    if (const auto handle = cache.handle(ids[idx]); handle != nullptr) {
+                        if (std::any_of(handle->begin(), handle->end(), [idx](int value) {
+                            return value != idx;
+                        })) {
+                            corrupted = true;
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    for (int round = 0; round < 200; ++round) {
+        for (int idx = round % 2; idx < nb_ids; idx += 2) {
+            cache.assign(ids[idx], std::make_shared<std::vector<int>>(16u, idx));
+        }
+        for (int idx = (round + 1) % 2; idx < nb_ids; idx += 2) {
+            cache.discard(ids[idx]);
+        }
+    }
+    stop = true;
+    for (auto &&reader : readers) {
+        reader.join();
+    }
+    ASSERT_FALSE(corrupted.load());
+    ASSERT_EQ(cache.size(), static_cast<size_t>(nb_ids / 2));
+}
+
+namespace
+{
+    //! a mono 16 bits PCM wav file of the given number of samples
+    std::shared_ptr<const std::string> make_wav(std::uint32_t nb_samples)
+    {
+        std::string wav;
+        auto append = [&wav](auto value) {
+            wav.append(reinterpret_cast<const char *>(&value), sizeof(value));
+        };
+        const std::uint32_t data_size = nb_samples * 2u;
+        wav += "RIFF";
+        append(std::uint32_t{36u + data_size});
+        wav += "WAVEfmt ";
+        append(std::uint32_t{16u});
+        append(std::uint16_t{1u});
+        append(std::uint16_t{1u});
+        append(std::uint32_t{44100u});
+        append(std::uint32_t{44100u * 2u});
+        append(std::uint16_t{2u});
+        append(std::uint16_t{16u});
+        wav += "data";
+        append(data_size);
+        wav.append(data_size, '\0');
+        return std::make_shared<const std::string>(std::move(wav));
+    }
+
+    //! runs the decodings when asked by the test
+    struct fake_executor
+    {
+        void run_all()
+        {
+            auto current = std::move(jobs);
+            jobs.clear();
+            for (auto &&job : current) {
+                job();
+            }
+        }
+
+        std::vector<std::function<void()>> jobs;
+    };
+}
+
+TEST(sound_bank, least_recently_played_are_dropped)
+{
+    fake_executor executor;
+    sound_bank bank([&executor](std::function<void()> job) {
+        executor.jobs.push_back(std::move(job));
+    });
+    const resource_id jump("sounds/jump");
+    const resource_id wind("sounds/wind");
+    const resource_id hit("sounds/hit");
+    for (auto &&id : {jump, wind, hit}) {
+        bank.add(id, make_wav(1000u));
+    }
+    //! room for two decoded buffers of 2000 bytes
+    bank.set_decoded_budget(4500u);
+    ASSERT_FALSE(bank.play(resource_id("sounds/unknown")));
+
+    for (auto &&id : {jump, wind, hit}) {
+        ASSERT_TRUE(bank.play(id));
+        ASSERT_EQ(executor.jobs.size(), 1u);
+        ASSERT_TRUE(bank.is_decoding());
+        executor.run_all();
+        bank.update();
+        ASSERT_FALSE(bank.is_decoding());
+    }
+    ASSERT_EQ(bank.decoded_bytes(), 4000u);
+
+    //! wind and hit are decoded, jump has been dropped
+    ASSERT_TRUE(bank.play(wind));
+    ASSERT_TRUE(executor.jobs.empty());
+    ASSERT_TRUE(bank.play(jump));
+    ASSERT_EQ(executor.jobs.size(), 1u);
+    executor.run_all();
+    bank.update();
+
+    //! hit is now the least recently played
+    ASSERT_TRUE(bank.play(wind));
+    ASSERT_TRUE(bank.play(jump));
+    ASSERT_TRUE(executor.jobs.empty());
+    ASSERT_TRUE(bank.play(hit));
+    ASSERT_EQ(executor.jobs.size(), 1u);
+    executor.run_all();
+
+    //! a replaced sound is decoded again, a discarded one can't be played
+    bank.update();
+    bank.add(hit, make_wav(500u));
+    ASSERT_TRUE(bank.play(hit));
+    ASSERT_EQ(executor.jobs.size(), 1u);
+    executor.run_all();
+    bank.update();
+    bank.discard(hit);
+    ASSERT_FALSE(bank.play(hit));
+    ASSERT_EQ(bank.decoded_bytes(), 2000u);
+}
+
+TEST(sound_bank, voices_are_stolen_above_the_maximum)
+{
+    fake_executor executor;
+    sound_bank bank([&executor](std::function<void()> job) {
+        executor.jobs.push_back(std::move(job));
+    });
+    bank.set_max_voices(2u);
+    std::vector<std::shared_ptr<sf::SoundBuffer>> buffers;
+    for (int idx = 0; idx < 4; ++idx) {
+        auto buffer = std::make_shared<sf::SoundBuffer>();
+        const auto wav = make_wav(44100u);
+        ASSERT_TRUE(buffer->loadFromMemory(wav->data(), wav->size()));
+        buffers.push_back(buffer);
+        ASSERT_TRUE(bank.play(buffer));
+        ASSERT_LE(bank.nb_voices(), 2u);
+    }
+    ASSERT_FALSE(bank.play(std::shared_ptr<sf::SoundBuffer>{}));
+
+    //! a corrupted sound fails to decode, its play is dropped
+    bank.add(resource_id("sounds/corrupted"), std::make_shared<const std::string>("!"));
+    ASSERT_TRUE(bank.play(resource_id("sounds/corrupted")));
+    executor.run_all();
+    bank.update();
+    ASSERT_FALSE(bank.is_decoding());
+    ASSERT_TRUE(executor.jobs.empty());
+    bank.stop_all();
+    ASSERT_EQ(bank.nb_playing(), 0u);
+}
+
+TEST(texture_atlas, images_bigger_than_a_page_are_not_packed)
+{
+    auto make_image = [](unsigned int width, unsigned int height) {
+        auto image = std::make_shared<sf::Image>();
+        image->create(width, height, sf::Color::White);
+        return image;
+    };
+    atlas_config cfg;
+    cfg.page_size = 64u;
+    std::vector<std::pair<resource_id, std::shared_ptr<sf::Image>>> images{
+        {resource_id("textures/a"), make_image(31u, 31u)},
+        {resource_id("textures/b"), make_image(31u, 31u)},
+        {resource_id("textures/c"), make_image(64u, 16u)},
+        {resource_id("textures/d"), make_image(100u, 100u)}};
+    std::vector<std::pair<resource_id, std::shared_ptr<sf::Image>>> unpacked;
+    const auto pages = pack_atlas(std::move(images), cfg, unpacked);
+
+    //! c is as wide as the page, without room for its padding
+    ASSERT_EQ(unpacked.size(), 2u);
+    ASSERT_EQ(pages.size(), 1u);
+    ASSERT_EQ(pages[0].regions.size(), 2u);
+    for (auto &&[id, rect] : pages[0].regions) {
+        ASSERT_TRUE(id == resource_id("textures/a") || id == resource_id("textures/b"));
+        ASSERT_EQ(rect.width, 31);
+        ASSERT_LE(rect.left + rect.width, 64);
+        ASSERT_LE(rect.top + rect.height, 64);
+    }
+}
+
+namespace
+{
+    void put_be16(std::string &data, std::uint32_t value)
+    {
+        data += static_cast<char>(value >> 8u & 0xFFu);
+        data += static_cast<char>(value & 0xFFu);
+    }
+
+    void put_le16(std::string &data, std::uint32_t value)
+    {
+        data += static_cast<char>(value & 0xFFu);
+        data += static_cast<char>(value >> 8u & 0xFFu);
+    }
+
+    void put_le32(std::string &data, std::uint32_t value)
+    {
+        put_le16(data, value & 0xFFFFu);
+        put_le16(data, value >> 16u);
+    }
+}
+
+TEST(image_header, read_size)
+{
+    std::string png("\x89PNG\r\n\x1a\n", 8u);
+    png += std::string("\0\0\0\x0dIHDR", 8u);
+    put_be16(png, 0u);
+    put_be16(png, 640u);
+    put_be16(png, 0u);
+    put_be16(png, 480u);
+    ASSERT_EQ(image_header::read_size(png), sf::Vector2u(640u, 480u));
+
+    //! the frame header comes after the APP0 (JFIF) and APP1 (Exif) segments
+    std::string jpeg("\xFF\xD8", 2u);
+    jpeg += "\xFF\xE0";
+    put_be16(jpeg, 16u);
+    jpeg += std::string("JFIF\0\x01\x01\0\0\x01\0\x01\0\0", 14u);
+    jpeg += "\xFF\xE1";
+    put_be16(jpeg, 8u);
+    jpeg += std::string("Exif\0\0", 6u);
+    jpeg += "\xFF\xC0";
+    put_be16(jpeg, 17u);
+    jpeg += '\x08';
+    put_be16(jpeg, 300u);
+    put_be16(jpeg, 200u);
+    jpeg += std::string(10u, '\0');
+    ASSERT_EQ(image_header::read_size(jpeg), sf::Vector2u(200u, 300u));
+
+    //! a negative height is a top-down bitmap
+    std::string bmp("BM");
+    bmp += std::string(16u, '\0');
+    put_le32(bmp, 100u);
+    put_le32(bmp, static_cast<std::uint32_t>(-50));
+    ASSERT_EQ(image_header::read_size(bmp), sf::Vector2u(100u, 50u));
+
+    std::string gif("GIF89a");
+    put_le16(gif, 7u);
+    put_le16(gif, 9u);
+    ASSERT_EQ(image_header::read_size(gif), sf::Vector2u(7u, 9u));
+
+    //! without signature, only known by its extension
+    std::string tga(12u, '\0');
+    put_le16(tga, 33u);
+    put_le16(tga, 17u);
+    tga += std::string(2u, '\0');
+    ASSERT_EQ(image_header::read_size(tga, ".tga"), sf::Vector2u(33u, 17u));
+    ASSERT_FALSE(image_header::read_size(tga).has_value());
+
+    //! truncated inputs
+    ASSERT_FALSE(image_header::read_size({}).has_value());
+    ASSERT_FALSE(image_header::read_size(std::string_view(png).substr(0, 20u)).has_value());
+    ASSERT_FALSE(image_header::read_size(std::string_view(jpeg).substr(0, jpeg.size() - 14u)).has_value());
+    ASSERT_FALSE(image_header::read_size(std::string_view(bmp).substr(0, 24u)).has_value());
+    ASSERT_FALSE(image_header::read_size(std::string_view(gif).substr(0, 8u)).has_value());
+    ASSERT_FALSE(image_header::read_size(std::string_view(tga).substr(0, 16u), ".tga").has_value());
+}
+
+TEST(resource_graph, replace_dependencies)
+{
+    resource_graph graph;
+    const resource_key hero{resource_residency::anim_cfg, resource_id("hero")};
+    const resource_key villain{resource_residency::anim_cfg, resource_id("villain")};
+    const resource_key old_sheet{resource_residency::texture, resource_id("textures/hero_old")};
+    const resource_key new_sheet{resource_residency::texture, resource_id("textures/hero_new")};
+    const resource_key shared_sheet{resource_residency::texture, resource_id("textures/shared")};
+    graph.add_dependency(hero, old_sheet);
+    graph.add_dependency(hero, shared_sheet);
+    graph.add_dependency(villain, shared_sheet);
+
+    //! the previous sheet is orphaned, the shared one is still needed by the villain
+    auto orphans = graph.replace_dependencies(hero, {new_sheet});
+    ASSERT_EQ(orphans.size(), 1u);
+    ASSERT_EQ(orphans[0], old_sheet);
+    ASSERT_FALSE(graph.has_dependents(old_sheet));
+    ASSERT_TRUE(graph.has_dependents(new_sheet));
+    ASSERT_TRUE(graph.has_dependents(shared_sheet));
+    ASSERT_EQ(graph.dependencies_of(hero).size(), 1u);
+
+    //! a dependency kept by the reload is not orphaned
+    ASSERT_TRUE(graph.replace_dependencies(hero, {new_sheet}).empty());
+    ASSERT_TRUE(graph.has_dependents(new_sheet));
+
+    orphans = graph.remove(villain);
+    ASSERT_EQ(orphans.size(), 1u);
+    ASSERT_EQ(orphans[0], shared_sheet);
+    ASSERT_EQ(graph.remove(hero).size(), 1u);
+    ASSERT_FALSE(graph.has_dependents(new_sheet));
+}
+
+TEST(resource_id, hash_and_names)
+{
+    using namespace shiva::sfml::literals;
+    constexpr auto id = "textures/kirito"_rid;
+    static_assert(id == resource_id("textures/kirito"));
+    ASSERT_EQ(resource_id().value(), 14695981039346656037ull);
+    ASSERT_EQ(resource_id("a").value(), 0xaf63dc4c8601ec8cull);
+    ASSERT_EQ(id, resource_id(std::string("textures/kirito")));
+    ASSERT_NE(id, resource_id("textures/asuna"));
+    ASSERT_EQ(resource_id::from_value(id.value()), id);
+    ASSERT_EQ(std::hash<resource_id>{}(id), static_cast<size_t>(id.value()));
+
+    //! only the interned names are known
+    ASSERT_EQ(resource_id("textures/never_interned").name(), "<unknown>");
+    ASSERT_EQ(resource_id::intern("textures/interned"), resource_id("textures/interned"));
+    ASSERT_EQ(resource_id("textures/interned").name(), "textures/interned");
+    ASSERT_EQ(resource_id::intern("textures/interned").name(), "textures/interned");
+}
+
+TEST(resource_id, concurrent_interns)
+{
+    //! the names seen again are found under the shared lock, the new ones are inserted once
+    std::vector<std::thread> threads;
+    for (int thread_idx = 0; thread_idx < 4; ++thread_idx) {
+        threads.emplace_back([]() {
+            for (int idx = 0; idx < 1000; ++idx) {
+                resource_id::intern("sounds/concurrent_" + std::to_string(idx % 10));
+            }
+        });
+    }
+    for (auto &&current : threads) {
+        current.join();
+    }
+    for (int idx = 0; idx < 10; ++idx) {
+        const auto name = "sounds/concurrent_" + std::to_string(idx);
+        ASSERT_EQ(resource_id(name).name(), name);
+    }
+}
@@ -2,9 +2,11 @@
 // Created by roman Sztergbaum on 21/06/2018.
 //
 
+#include <fstream>
 #include <gtest/gtest.h>
 #include <shiva/world/world.hpp>
 #include <shiva/lua/lua_system.hpp>
+#include <shiva/sfml/common/lua_resource_id.hpp>
 #include <shiva/lua/details/lua_scripted_system.hpp>
 #include <shiva/ecs/components/all.hpp>
 #include <systems/all_systems.hpp>
@@ -68,8 +70,179 @@ TEST_F(fixture_scripting, for_each_runtime)
     ASSERT_TRUE(res);
 }
 
+TEST_F(fixture_scripting, lazy_bindings)
+{
+    const auto &binder = system_ptr->get_binder();
+    ASSERT_TRUE(binder.is_pending("layer_4"));
+    ASSERT_TRUE(binder.is_pending("layer_5"));
+    sol::state &state = system_ptr->get_state();
+    bool res = state["test_lazy_bindings"]();
+    ASSERT_TRUE(res);
+    ASSERT_TRUE(binder.is_bound("layer_4"));
+    ASSERT_TRUE(binder.is_bound("layer_5"));
+    ASSERT_TRUE(binder.is_pending("layer_6"));
+}
+
+TEST_F(fixture_scripting, plugin_bindings)
+{
+    sol::state &state = system_ptr->get_state();
+    const auto &binder = system_ptr->get_binder();
+    //! the pending bindings of an unloaded plugin are removed with it
+    {
+        auto bindings = shiva::lua::register_plugin_bindings(state, "unloaded_plugin", []() {
+        });
+        ASSERT_TRUE(binder.is_pending("unloaded_plugin"));
+    }
+    ASSERT_FALSE(binder.is_pending("unloaded_plugin"));
+    ASSERT_FALSE(binder.is_bound("unloaded_plugin"));
+
+    auto bindings = shiva::lua::register_plugin_bindings(state, "test_plugin", [&state]() {
+        state["shiva"]["test_plugin"] = state.create_table_with("value", 42);
+    });
+    ASSERT_TRUE(binder.is_pending("test_plugin"));
+    int value = state.script("return shiva.test_plugin.value");
+    ASSERT_EQ(value, 42);
+    ASSERT_TRUE(binder.is_bound("test_plugin"));
+
+    //! a reloaded plugin is bound right away
+    bindings = shiva::lua::register_plugin_bindings(state, "test_plugin", [&state]() {
+        state["shiva"]["test_plugin"] = state.create_table_with("value", 43);
+    });
+    value = state["shiva"]["test_plugin"]["value"];
+    ASSERT_EQ(value, 43);
+
+    //! without lua_system, the bindings are registered right away
+    sol::state plain_state;
+    bool bound = false;
+    auto plain_bindings = shiva::lua::register_plugin_bindings(plain_state, "test_plugin", [&bound]() {
+        bound = true;
+    });
+    ASSERT_TRUE(bound);
+}
+
+TEST(lazy_binder, component_name_from_key)
+{
+    using shiva::lua::component_name_from_key;
+    ASSERT_EQ(component_name_from_key("get_transform_2d_component"), "transform_2d");
+    ASSERT_EQ(component_name_from_key("for_each_entities_which_have_layer_1_component"), "layer_1");
+    ASSERT_EQ(component_name_from_key("layer_1_id"), "layer_1");
+    ASSERT_EQ(component_name_from_key("get_texture_id"), "");
+    ASSERT_EQ(component_name_from_key("has_layer_1"), "");
+    ASSERT_EQ(component_name_from_key("nb_entities"), "");
+}
+
+TEST_F(fixture_scripting, math)
+{
+    sol::state &state = system_ptr->get_state();
+    bool res = state["test_math"]();
+    ASSERT_TRUE(res);
+}
+
 TEST_F(fixture_scripting, systems)
 {
     ASSERT_TRUE(system_ptr->load_all_scripted_systems());
     ASSERT_GE(system_manager_.update(), 2u);
-}
\ No newline at end of file
+}
+
+TEST_F(fixture_scripting, reload_script)
+{
+    const auto &tracker = system_ptr->get_script_tracker();
+    auto generation = tracker.get_generation();
+    ASSERT_FALSE(system_ptr->reload_script("never_loaded.lua"));
+    ASSERT_EQ(tracker.get_generation(), generation);
+    ASSERT_TRUE(system_ptr->reload_script(shiva::fs::current_path() / "assets/scripts/lua/basic_tests.lua"));
+    ASSERT_EQ(tracker.get_generation(), generation + 1);
+    sol::state &state = system_ptr->get_state();
+    bool res = state["test_create_entity"]();
+    ASSERT_TRUE(res);
+}
+
+TEST_F(fixture_scripting, script_dependencies)
+{
+    const auto directory = shiva::fs::temp_directory_path() / "shiva-lua-test";
+    shiva::fs::create_directories(directory);
+    auto write = [&directory](const std::string &file_name, const std::string &content) {
+        std::ofstream(directory / file_name, std::ios::trunc) << content;
+    };
+    write("dependency_module.lua", "return { value = 42 }");
+    write("dependency_loaded.lua", "loaded_value = 7");
+    write("dependency_main.lua", "local module = require('dependency_module')\n"
+                                 "load_script('dependency_loaded.lua', '" + directory.generic_string() + "')\n"
+                                 "main_value = module.value + loaded_value");
+    sol::state &state = system_ptr->get_state();
+    const std::string package_path = state["package"]["path"];
+    state["package"]["path"] = (directory / "?.lua").string() + ";" + package_path;
+    ASSERT_TRUE(system_ptr->load_script("dependency_main.lua", directory));
+    ASSERT_EQ(state["main_value"].get<int>(), 49);
+
+    using shiva::lua::script_tracker;
+    const auto &tracker = system_ptr->get_script_tracker();
+    const auto main_script = script_tracker::normalize(directory / "dependency_main.lua");
+    const auto module_script = script_tracker::normalize(directory / "dependency_module.lua");
+    const auto loaded_script = script_tracker::normalize(directory / "dependency_loaded.lua");
+    ASSERT_EQ(tracker.reload_order(module_script), (std::vector<std::string>{module_script, main_script}));
+    ASSERT_EQ(tracker.reload_order(loaded_script), (std::vector<std::string>{loaded_script, main_script}));
+
+    //! the script requiring the module is executed again after it
+    write("dependency_module.lua", "return { value = 50 }");
+    ASSERT_TRUE(system_ptr->reload_script(directory / "dependency_module.lua"));
+    ASSERT_EQ(state["main_value"].get<int>(), 57);
+
+    //! the main script no longer depends on them, its edges are pruned when it is executed again
+    write("dependency_main.lua", "main_value = 1");
+    ASSERT_TRUE(system_ptr->reload_script(directory / "dependency_main.lua"));
+    ASSERT_EQ(state["main_value"].get<int>(), 1);
+    ASSERT_EQ(tracker.reload_order(module_script), std::vector<std::string>{module_script});
+    ASSERT_EQ(tracker.reload_order(loaded_script), std::vector<std::string>{loaded_script});
+    shiva::fs::remove_all(directory);
+}
+
+TEST_F(fixture_scripting, entity_table_loaded_after_update)
+{
+    const auto directory = shiva::fs::temp_directory_path() / "shiva-lua-test-late";
+    shiva::fs::create_directories(directory);
+    std::ofstream(directory / "late_entity.lua", std::ios::trunc)
+        << "late_entity = {}\nfunction late_entity.on_update(entity) nb_late_updates = (nb_late_updates or 0) + 1 end";
+
+    shiva::ecs::lua_script script;
+    script.script = "late_entity.lua";
+    script.table_name = "late_entity";
+    entity_registry_.assign<shiva::ecs::lua_script>(entity_registry_.create(), script);
+
+    //! the table doesn't exist yet, the miss is not kept
+    system_ptr->update();
+    sol::state &state = system_ptr->get_state();
+    ASSERT_FALSE(state["nb_late_updates"].valid());
+
+    ASSERT_TRUE(system_ptr->load_script("late_entity.lua", directory));
+    system_ptr->update();
+    ASSERT_EQ(state["nb_late_updates"].get<int>(), 1);
+    shiva::fs::remove_all(directory);
+}
+
+TEST(lua_resource_id, round_trip)
+{
+    using shiva::sfml::resource_id;
+    sol::state state;
+    state.open_libraries();
+    state["id_of"] = [](resource_id id) {
+        return id;
+    };
+    state["name_of"] = [](resource_id id) {
+        return std::string(id.name());
+    };
+
+    //! a name coming from lua is hashed and interned
+    const resource_id id = state["id_of"]("textures/lua_round_trip");
+    ASSERT_EQ(id, resource_id("textures/lua_round_trip"));
+    ASSERT_EQ(id.name(), "textures/lua_round_trip");
+
+    //! pushed as an integer, read back as the same id (also above 2^63)
+    const resource_id same = state["id_of"](id);
+    ASSERT_EQ(same, id);
+    const auto high = resource_id::from_value(0xF000000000000001ull);
+    const resource_id high_same = state["id_of"](high);
+    ASSERT_EQ(high_same, high);
+    const std::string name = state.script("return name_of(id_of(id_of('textures/lua_other')))");
+    ASSERT_EQ(name, "textures/lua_other");
+}
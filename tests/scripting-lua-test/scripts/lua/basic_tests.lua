@@ -74,3 +74,37 @@ function test_for_each_runtime()
     return true
 end
 
+
+function test_lazy_bindings()
+    local entity_id = shiva.entity_registry:create()
+    shiva.entity_registry:add_layer_4_component(entity_id)
+    assert(shiva.entity_registry:has_layer_4_component(entity_id) == true, "should be true")
+    assert(shiva.layer_5 ~= nil, "should be bound on the fly")
+    return true
+end
+
+function test_math()
+    local vec2 = shiva.math.vec2
+    local a = vec2(1, 2)
+    local b = vec2.new(3, 4)
+    assert(a + b == vec2(4, 6), "should be equal")
+    assert((b * 2).x == 6, "should be 6")
+    assert(vec2(0, 0):distance(b) == 5, "should be 5")
+    local positions = shiva.math.vec2_array(8)
+    positions:translate(vec2(3, 4))
+    positions:scale(2)
+    assert(positions:get(8) == vec2(6, 8), "should be equal")
+    positions:set(1, vec2(0, 5))
+    assert(positions:get(1) == vec2(0, 5), "should be 1-based")
+    local distances = positions:distances(vec2(0, 0))
+    assert(#distances == 8 and distances[1] == 5 and distances[8] == 10, "should be 5 and 10")
+    local x, y = shiva.math.add(1, 2, 3, 4)
+    assert(x == 4 and y == 6, "should be 4 and 6")
+    x, y = shiva.math.scale(x, y, 0.5)
+    assert(x == 2 and y == 3, "should be 2 and 3")
+    assert(shiva.math.distance(0, 0, 3, 4) == 5, "should be 5")
+    positions:set_xy(2, 3, 4)
+    x, y = positions:get_xy(2)
+    assert(x == 3 and y == 4 and shiva.math.length(x, y) == 5, "should be 3, 4 and 5")
+    return true
+end
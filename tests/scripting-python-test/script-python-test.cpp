@@ -85,4 +85,24 @@ TEST_F(fixture_scripting, systems)
 {
     ASSERT_TRUE(system_ptr->load_all_scripted_systems());
     ASSERT_GE(system_manager_.update(), 2u);
-}
\ No newline at end of file
+}
+
+TEST_F(fixture_scripting, component_array)
+{
+    pybind11::module &module = this->system_ptr->get_module();
+    py::object obj = module.attr("basic_tests").attr("test_component_array");
+    auto result = obj().cast<bool>();
+    ASSERT_TRUE(result);
+}
+
+TEST_F(fixture_scripting, reload_module)
+{
+    ASSERT_FALSE(system_ptr->reload_module("never_imported"));
+    pybind11::module &module = this->system_ptr->get_module();
+    module.attr("basic_tests").attr("reloaded_marker") = true;
+    ASSERT_TRUE(system_ptr->reload_module("basic_tests"));
+    //! reload executes the module again in the same module object
+    ASSERT_TRUE(py::hasattr(module.attr("basic_tests"), "reloaded_marker"));
+    py::object obj = module.attr("basic_tests").attr("test_create_entity");
+    ASSERT_TRUE(obj().cast<bool>());
+}
@@ -56,3 +56,17 @@ def test_for_each_runtime():
     shiva.ett_registry.for_each_runtime(table, functor)
     assert shiva.ett_registry.nb_entities() == 1, "should be 1"
     return True
+
+
+def test_component_array():
+    for i in range(0, 10):
+        id = shiva.ett_registry.create()
+        transform = shiva.ett_registry.add_transform_2d_component(id)
+        transform.x = float(i)
+    transforms = shiva.ett_registry.transform_2d_array()
+    entities = shiva.ett_registry.transform_2d_entities()
+    assert len(transforms) == 10 and len(entities) == 10, "should be 10"
+    transforms['y'] += transforms['x'] * 2.0
+    for entity, x in zip(entities, transforms['x']):
+        assert shiva.ett_registry.get_transform_2d_component(int(entity)).y == x * 2.0, "should be written in place"
+    return True
@@ -0,0 +1,285 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#pragma once
+
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <algorithm>
+#include <string_view>
+#include <SFML/Graphics/Image.hpp>
+#include <shiva/filesystem/filesystem.hpp>
+#include <shiva/filesystem/asset_manifest.hpp>
+#include <shiva/filesystem/pak_archive.hpp>
+#include <shiva/sfml/common/animation_config.hpp>
+#include <shiva/sfml/common/compiled_config.hpp>
+#include <shiva/sfml/common/cooked_image.hpp>
+#include <shiva/sfml/resources/taskflow.hpp>
+#include <shiva/reflection/binary_serialization.hpp>
+
+namespace shiva::tools
+{
+    struct cook_options
+    {
+        shiva::fs::path assets_root;
+        shiva::fs::path output;
+        shiva::fs::path cache_directory;
+        unsigned int nb_jobs{std::thread::hardware_concurrency()};
+    };
+
+    /**
+     * \note This class cooks an asset tree into a .shivapak archive, in the forms the resources registry loads fastest:
+     * raw pixels for the images, compiled animation configs, compressed sounds.
+     * \note The raw pixels are only worth it compressed: without SHIVA_USE_LZ4 the images are stored as is.
+     * \note The inputs are listed by an asset_manifest kept in the cache directory (content hashes,
+     * only the modified directories are listed again). Each cooked entry is stored in the cache under a key
+     * made of its content hash, of the version of its cooker and of the schema of the animation configs,
+     * an unchanged input is never cooked again.
+     * \note The cook database (cook.db) remembers the keys of the last archive, the archive is only written
+     * when one of them changed.
+     * \class asset_cook
+     */
+    class asset_cook
+    {
+    public:
+        //! Constructors
+        explicit asset_cook(cook_options options) noexcept : options_(std::move(options))
+        {
+        }
+
+        //! Public member functions
+
+        //! \return number of errors, 0 if the archive is up to date
+        size_t run()
+        {
+            shiva::fs::create_directories(options_.cache_directory / "objects");
+            const auto manifest_path = options_.cache_directory / "assets.shivamanifest";
+            shiva::filesystem::asset_manifest manifest(options_.assets_root);
+            if (!manifest.open(manifest_path)) {
+                std::cerr << "assets directory not found: " << options_.assets_root.string() << std::endl;
+                return 1u;
+            }
+            //! a file modified in place doesn't change the time of its directory.
+            if (manifest.refresh_files() > 0u) {
+                manifest.save(manifest_path);
+            }
+
+            std::vector<job> jobs;
+            for (auto &&[path, entry] : manifest.get_files()) {
+                const auto kind = cooker_of_(path);
+                if (kind != cooker::skip) {
+                    jobs.push_back(job{path, kind, key_of_(entry, kind)});
+                }
+            }
+
+            const auto database = options_.cache_directory / "cook.db";
+            if (shiva::fs::exists(options_.output) && read_database_(database) == keys_of_(jobs)) {
+                std::cout << options_.output.string() << " is up to date (" << jobs.size() << " entries)" << std::endl;
+                return 0u;
+            }
+
+            cook_all_(jobs);
+            if (nb_errors_ > 0u) {
+                return nb_errors_;
+            }
+
+            shiva::filesystem::pak_writer writer;
+            for (auto &&current : jobs) {
+                writer.add_data(current.path, current.output, compress_(current));
+            }
+            if (!writer.write(options_.output)) {
+                std::cerr << "unable to write " << options_.output.string() << std::endl;
+                return 1u;
+            }
+            write_database_(database, keys_of_(jobs));
+            std::cout << options_.output.string() << ": " << jobs.size() << " entries, " << nb_cooked_
+                                << " cooked, " << jobs.size() - nb_cooked_ << " from the cache" << std::endl;
+            return 0u;
+        }
+
+    private:
+        //! Private typedefs
+        enum class cooker
+        {
+            copy,
+            texture,
+            anim_cfg,
+            sound,
+            stream,
+            skip
+        };
+
+        struct job
+        {
+            std::string path;
+            cooker kind;
+            std::uint64_t key;
+            std::string output{};
+        };
+
+        //! \note bump it when a cooker changes, every entry it produced is cooked again
+        static constexpr std::uint32_t cookers_version = 1u;
+
+        //! Private member functions
+        static cooker cooker_of_(std::string_view path) noexcept
+        {
+            const auto category = shiva::filesystem::asset_manifest::category(path);
+            const auto extension = shiva::fs::path(std::string(path)).extension().string();
+#if defined(SHIVA_USE_LZ4)
+            if (category == "textures" && (extension == ".png" || extension == ".jpg" || extension == ".bmp" ||
+                                                                          extension == ".tga")) {
+                return cooker::texture;
+            }
+#endif
+            if (path.compare(0, 13, "cfg/anim_cfg/") == 0 && extension == ".json") {
+                return cooker::anim_cfg;
+            }
+            if (category == "sounds") {
+                return cooker::sound;
+            }
+            //! streamed from the mapping, stored as is
+            if (category == "musics" || category == "fonts") {
+                return cooker::stream;
+            }
+            //! the videos and the scripts are loaded from the disk
+            if (category == "videos" || category == "scripts") {
+                return cooker::skip;
+            }
+            return cooker::copy;
+        }
+
+        static std::uint64_t key_of_(const shiva::filesystem::asset_manifest::file_entry &entry, cooker kind) noexcept
+        {
+            std::uint64_t key = entry.content_hash;
+            //! a compiled config is only valid for the members of animation_config it has been compiled with
+            const auto schema = kind == cooker::anim_cfg ? shiva::refl::schema_hash<shiva::sfml::animation_config>()
+                                                         : std::uint64_t{0u};
+            for (auto value : {static_cast<std::uint64_t>(kind), static_cast<std::uint64_t>(cookers_version), schema}) {
+                key = (key ^ value) * 1099511628211ull;
+            }
+            return key;
+        }
+
+        static bool compress_(const job &current) noexcept
+        {
+            return current.kind == cooker::texture || current.kind == cooker::sound;
+        }
+
+        static std::vector<std::pair<std::string, std::uint64_t>> keys_of_(const std::vector<job> &jobs)
+        {
+            std::vector<std::pair<std::string, std::uint64_t>> keys;
+            for (auto &&current : jobs) {
+                keys.emplace_back(current.path, current.key);
+            }
+            return keys;
+        }
+
+        shiva::fs::path object_path_(std::uint64_t key) const
+        {
+            char name[17] = {};
+            std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+            return options_.cache_directory / "objects" / name;
+        }
+
+        static bool read_file_(const shiva::fs::path &path, std::string &out)
+        {
+            std::ifstream ifs(path, std::ios::binary);
+            if (!ifs.is_open()) {
+                return false;
+            }
+            out.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>{});
+            return true;
+        }
+
+        //! \note one task per job, the entries already in the cache are only read
+        void cook_all_(std::vector<job> &jobs)
+        {
+            tf::Taskflow tf(std::max(1u, options_.nb_jobs));
+            for (auto &&current : jobs) {
+                tf.silent_emplace([this, &current]() {
+                    try {
+                        const auto object = object_path_(current.key);
+                        if (read_file_(object, current.output)) {
+                            return;
+                        }
+                        current.output = cook_(current);
+                        std::ofstream ofs(object, std::ios::binary | std::ios::trunc);
+                        ofs.write(current.output.data(), static_cast<std::streamsize>(current.output.size()));
+                        nb_cooked_++;
+                    }
+                    catch (const std::exception &error) {
+                        std::scoped_lock lock(output_mutex_);
+                        std::cerr << current.path << ": " << error.what() << std::endl;
+                        nb_errors_++;
+                    }
+                });
+            }
+            tf.wait_for_all();
+        }
+
+        std::string cook_(const job &current) const
+        {
+            const auto input = options_.assets_root / current.path;
+            switch (current.kind) {
+                case cooker::texture: {
+                    sf::Image image;
+                    if (!image.loadFromFile(input.string())) {
+                        throw std::runtime_error("unable to decode the image");
+                    }
+                    return shiva::sfml::cooked_image::cook(image);
+                }
+                case cooker::anim_cfg: {
+                    std::string data;
+                    if (!read_file_(input, data)) {
+                        throw std::runtime_error("unable to read the config");
+                    }
+                    shiva::sfml::animation_config cfg = shiva::json::json::parse(data);
+                    return shiva::sfml::compiled_config::compile(cfg);
+                }
+                default: {
+                    std::string data;
+                    if (!read_file_(input, data)) {
+                        throw std::runtime_error("unable to read the file");
+                    }
+                    return data;
+                }
+            }
+        }
+
+        static std::vector<std::pair<std::string, std::uint64_t>> read_database_(const shiva::fs::path &path)
+        {
+            std::vector<std::pair<std::string, std::uint64_t>> keys;
+            std::ifstream ifs(path);
+            std::string entry_path;
+            std::uint64_t key = 0u;
+            while (ifs >> std::hex >> key && std::getline(ifs >> std::ws, entry_path)) {
+                keys.emplace_back(entry_path, key);
+            }
+            return keys;
+        }
+
+        static void write_database_(const shiva::fs::path &path,
+                                    const std::vector<std::pair<std::string, std::uint64_t>> &keys)
+        {
+            std::ofstream ofs(path, std::ios::trunc);
+            for (auto &&[entry_path, key] : keys) {
+                ofs << std::hex << key << ' ' << entry_path << '\n';
+            }
+        }
+
+        //! Private data members
+        cook_options options_;
+        std::atomic_size_t nb_cooked_{0u};
+        std::atomic_size_t nb_errors_{0u};
+        std::mutex output_mutex_;
+    };
+}
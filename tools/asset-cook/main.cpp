@@ -0,0 +1,25 @@
+//
+// Created by agent on 18/10/2026.
+//
+
+#include <string>
+#include <iostream>
+#include "asset_cook.hpp"
+
+//! shiva-asset-cook <assets_root> <output.shivapak> [cache_directory] [nb_jobs]
+int main(int ac, char **av)
+{
+    if (ac < 3) {
+        std::cerr << "usage: " << av[0] << " <assets_root> <output.shivapak> [cache_directory] [nb_jobs]" << std::endl;
+        return 1;
+    }
+    shiva::tools::cook_options options;
+    options.assets_root = av[1];
+    options.output = av[2];
+    options.cache_directory = (ac > 3) ? shiva::fs::path(av[3]) : shiva::fs::path(av[2]).parent_path() / "cook_cache";
+    if (ac > 4) {
+        options.nb_jobs = static_cast<unsigned int>(std::stoul(av[4]));
+    }
+    shiva::tools::asset_cook cook(std::move(options));
+    return cook.run() == 0u ? 0 : 1;
+}